@@ -0,0 +1,162 @@
+// Name:   Isaak Choi
+// UniKey: icho6322
+// SID:    520488399
+
+
+/* aot.h
+
+    Contains ahead of time translation of memory images to native code.
+
+    * riskxvii_aot (tools/riskxvii_aot.c) translates a memory image to a C
+      translation unit with an entry point per basic block, which is
+      compiled into a shared object (make <name>.so, see the Makefile)
+    * vm_riskxvii --aot=<file.so> loads it, and runs the translated block
+      starting at the program counter whenever there is one, falling back
+      to the interpreter everywhere else (e.g. after a jalr to an address
+      no block starts at)
+    * Translated blocks keep the guest registers in host locals, and only
+      write them back before calls into the vm - mem_read / mem_write for
+      accesses outside data memory, exec_instruction for instructions that
+      aren't translated (extensions, unknown instructions), and
+      end_basic_block at the end of the block - so errors, virtual routines
+      and the execution budget see exactly the state the interpreter has
+    * Translated blocks are chained - A block goes straight on to the block
+      of a static successor (branches, jal, fall through), and a jalr looks
+      its target up in a guest return address stack (returns), its own
+      inline cache, then the table of blocks - so control only goes back to
+      the vm for a target no block starts at
+
+    NOTE
+    * This header is the interface between the vm and translated code, and
+      is included by the generated translation units
+    * Instruction memory can't be written, so a translation stays valid for
+      the whole run. Shared objects record a hash of the instruction memory
+      they were translated from and are refused for any other image
+    * Each shared object holds translations for both decodings of the image
+      - with and without --ext-c - and the vm picks the one it runs with
+
+*/
+
+
+// HEADER GUARD ...
+#ifndef AOT_H
+#define AOT_H
+
+
+// DEPENDENCIES ...
+#include <stdint.h>
+#include <stdbool.h>
+#include "system.h"
+
+
+// THIRD PARTY MEMORY LEAK DETECTOR ...
+#ifdef DEBUG_DETECT_LEAKS
+    #include "leak_detector_c.h"
+#endif
+
+
+// CONSTANTS ...
+
+// Version of the interface below - Bumped on every change to it, so stale
+//  shared objects are refused rather than misread
+#define AOT_ABI_VERSION     (1)
+
+// Name of the aot_image_t every translated shared object exports
+#define AOT_IMAGE_SYMBOL    "riskxvii_aot_image"
+
+// Entries in the guest return address stack of translated code (a power
+//  of 2) - Deeper calls still return correctly, just without the stack
+#define AOT_RAS_SIZE        (16)
+
+// FNV-1a parameters for the instruction memory hash
+#define AOT_HASH_BASIS      (0x811c9dc5u)
+#define AOT_HASH_PRIME      (0x01000193u)
+
+
+// MACROS ...
+
+// Shift instructions exactly as the interpreter runs them on the host (see
+//  exec_sll, exec_srl, exec_sra) - Shifts by R[rs2] outside 0 to 32 give
+//  0, a shift by 32 is a shift by 0, and sra rotates right
+#define AOT_SLL(a, s) (((s) < 0 || (s) > REGISTER_SIZE_BITS) ? 0 : \
+            (int32_t)((uint32_t)(a) << ((s) & (REGISTER_SIZE_BITS - 1))))
+#define AOT_SRL(a, s) (((s) < 0 || (s) > REGISTER_SIZE_BITS) ? 0 : \
+            (int32_t)((uint32_t)(a) >> ((s) & (REGISTER_SIZE_BITS - 1))))
+#define AOT_SRA(a, s) (((s) < 0) ? 0 : (int32_t)( \
+            ((uint32_t)(a) >> ((s) % REGISTER_SIZE_BITS)) | \
+            ((uint32_t)(a) << ((REGISTER_SIZE_BITS - (s) % REGISTER_SIZE_BITS) \
+                               & (REGISTER_SIZE_BITS - 1)))))
+
+
+// DATA STRUCTURES ...
+
+// Everything translated code uses of the vm - Given to every block
+typedef struct aot_host_t aot_host_t;
+struct aot_host_t {
+    int32_t* registers;          // 'registers'
+    int32_t* pc;                 // 'pc'
+    int32_t* instr_size;         // 'instr_size'
+    uint32_t* block_compressed;  // 'budget.block_compressed'
+    byte* memory;                // 'memory' - NULL if data memory must be
+                                 //  accessed through mem_read / mem_write
+    void (*mem_read)(void* const, const int32_t, const int);
+    void (*mem_write)(const void* const, const int32_t, const int);
+    void (*exec_instruction)(const int32_t);
+    void (*end_basic_block)(const int32_t);
+};
+
+// A translated basic block - Runs the block starting at the program
+//  counter, up to and including the branch or jump ending it (which sets
+//  the program counter and ends the budget's basic block), or up to the
+//  start of the next block, then the blocks chained after it until one
+//  leaves the program counter where no block starts
+typedef void (*aot_block_t)(const aot_host_t* const host);
+
+// A translated memory image - Exported by each shared object as
+//  AOT_IMAGE_SYMBOL
+typedef struct aot_image_t aot_image_t;
+struct aot_image_t {
+    uint32_t abi_version;        // AOT_ABI_VERSION it was translated with
+    uint32_t inst_mem_hash;      // aot_hash() of its instruction memory
+    const aot_block_t* blocks;   // Block starting at each address (or NULL)
+    const aot_block_t* rvc_blocks; // As above, decoded with --ext-c
+};
+
+
+// GLOBAL AOT VARS ...
+
+// The translated block starting at each instruction memory address, or
+//  NULL where the interpreter runs - All NULL unless an image is loaded
+extern const aot_block_t* aot_blocks;
+
+// The vm interface handed to translated blocks - Set up by aot_load()
+extern aot_host_t aot_host;
+
+
+// FUNCTIONS ...
+
+/* Returns the FNV-1a hash of the given instruction memory
+   (INST_MEM_SIZE bytes)
+*/
+extern uint32_t aot_hash(const byte* const inst_mem);
+
+/* Loads the translated memory image in the shared object at the given path
+
+    * Must be called after the memory image has been read into memory
+    * Picks the translation for the current options (--ext-c, and direct
+      data memory access unless --guard-pages)
+
+    RETURNS
+    true  | On success
+    false | If the shared object couldn't be loaded, isn't a translated
+            image, was built for another interface version, or was
+            translated from a different memory image
+*/
+extern bool aot_load(const char* const path);
+
+/* Unloads any loaded translated image */
+extern void aot_unload();
+
+
+// END HEADER GUARD ...
+#endif
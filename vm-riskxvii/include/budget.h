@@ -0,0 +1,130 @@
+// Name:   Isaak Choi
+// UniKey: icho6322
+// SID:    520488399
+
+
+/* budget.h
+
+    Contains the execution budget used to stop guests that run for too long
+    or produce / consume too much console data.
+
+    * Guest instructions executed
+    * Wall time
+    * Console output bytes
+    * Console input bytes
+
+    NOTE
+    * Limits are only checked at the end of each basic block (i.e., by the
+      branch and jump instructions) so straight-line instructions pay
+      nothing for them.
+    * Instructions are counted per block from the distance between the
+      first instruction of the block and the instruction ending it.
+
+*/
+
+
+// HEADER GUARD ...
+#ifndef BUDGET_H
+#define BUDGET_H
+
+
+// DEPENDENCIES ...
+#include <stdint.h>
+#include <stdbool.h>
+#include "options.h"
+
+
+// THIRD PARTY MEMORY LEAK DETECTOR ...
+#ifdef DEBUG_DETECT_LEAKS
+    #include "leak_detector_c.h"
+#endif
+
+
+// CONSTANTS ...
+
+// Number of basic blocks executed between each wall time check
+#define BUDGET_TIME_CHECK_INTERVAL (4096)
+
+// Cycle estimate - Every instruction takes one cycle, and each branch or
+// jump (basic block end) takes this many more to refill the pipeline
+#define BUDGET_BLOCK_END_CYCLES    (2)
+
+
+// DATA STRUCTURES ...
+
+// Usage counters and limits for the current run
+typedef struct budget_t budget_t;
+struct budget_t {
+
+    // Usage
+    uint64_t instr_retired;  // Guest instructions in completed basic blocks
+    uint64_t output_bytes;   // Bytes written to stdout by virtual routines
+    uint64_t input_bytes;    // Bytes read from stdin by virtual routines
+    int32_t block_start;     // Address of the first instr of the current block
+    uint32_t block_compressed; // Compressed instrs fetched in the current block
+    uint64_t blocks_ended;   // Completed basic blocks
+    uint64_t start_us;       // Monotonic time (us) at which the run started
+
+    // Limits - UINT64_MAX when not enforced
+    uint64_t max_instr;
+    uint64_t max_output_bytes;
+    uint64_t max_input_bytes;
+    uint64_t deadline_ms;    // Monotonic time (ms) at which to stop
+
+    // Blocks remaining until the next wall time check
+    uint32_t time_check_countdown;
+};
+
+
+// GLOBAL BUDGET VARS ...
+
+// The execution budget for the current run
+extern budget_t budget;
+
+
+// FUNCTIONS ...
+
+/* Initialises the execution budget from the given options
+    Zeroes all usage counters and starts the wall time clock
+*/
+extern void budget_init(const vm_options_t* const opts);
+
+/* Ends the current basic block
+
+    * Adds the instructions of the block ending at 'branch_pc' to the
+      retired instruction count
+    * Starts the next block at the current program counter
+    * Throws a limit exceeded error if any limit has been passed
+
+    Must be called after the program counter has been updated.
+*/
+extern void end_basic_block(const int32_t branch_pc);
+
+/* Ends the current basic block as end_basic_block() does, unless that would
+   throw a limit exceeded error or check the wall time
+
+    * Lets callers holding guest registers outside the vm (see hot_loops.h)
+      only write them back when a limit may be hit
+
+    RETURNS
+    true  | The block was ended
+    false | Nothing was changed - The caller must call end_basic_block()
+*/
+extern bool try_end_basic_block(const int32_t branch_pc);
+
+/* Returns the number of guest instructions retired before the current one
+    Includes the instructions of the current block before the program counter
+*/
+extern uint64_t budget_instr_count();
+
+/* Returns the deterministic cycle estimate for the instructions counted by
+   budget_instr_count() (see BUDGET_BLOCK_END_CYCLES)
+*/
+extern uint64_t budget_cycle_count();
+
+/* Returns the wall time in microseconds since the budget was initialised */
+extern uint64_t budget_time_us();
+
+
+// END HEADER GUARD ...
+#endif
@@ -0,0 +1,124 @@
+// Name:   Isaak Choi
+// UniKey: icho6322
+// SID:    520488399
+
+
+/* guard_pages.h
+
+    Contains the guard page memory mode, in which the host MMU rather than
+    software range checks keeps guest accesses within instruction and data
+    memory.
+
+    * The memory image is stored in a single host page which is mapped into
+      two 4 GiB windows that are otherwise PROT_NONE
+      - Read view  | vm address a is at read_base + (uint32_t)a and only
+                     instruction and data memory are readable
+      - Write view | vm address a is at write_base + (uint32_t)(a - 0x400)
+                     and only data memory is writable
+    * Any other image access faults and the SIGSEGV handler turns the fault
+      into an illegal operation error
+
+    NOTE
+    * Host pages (4 KiB) are larger than instruction and data memory, so
+      each view is offset so that its legal addresses end exactly at a page
+      boundary and unsigned offsets can never reach before them.
+    * Heap banks (64 bytes) are far smaller than a page, so heap accesses are
+      still checked by the heap manager in software.
+    * Only meant for well-behaved guests - Printing the error report from
+      the signal handler is not async-signal-safe in general, which is fine
+      here as faults only happen on guest loads and stores.
+
+*/
+
+
+// HEADER GUARD ...
+#ifndef GUARD_PAGES_H
+#define GUARD_PAGES_H
+
+
+// DEPENDENCIES ...
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "system.h"
+
+
+// THIRD PARTY MEMORY LEAK DETECTOR ...
+#ifdef DEBUG_DETECT_LEAKS
+    #include "leak_detector_c.h"
+#endif
+
+
+// CONSTANTS ...
+
+// The size of each guard window - Every uint32_t offset (plus a word) from
+// a view base lands within its window
+#define GUARD_WINDOW_SPAN ((size_t)1 << 32)
+
+
+// DATA STRUCTURES ...
+
+// Host mappings used by the guard page memory mode
+typedef struct guard_pages_t guard_pages_t;
+struct guard_pages_t {
+    bool enabled;       // Whether the guard page memory mode is in use
+    byte* read_base;    // Host address of vm address 0 in the read view
+    byte* write_base;   // Host address of DATA_MEM_START in the write view
+    byte* read_window;  // Start of the reserved read view window
+    byte* write_window; // Start of the reserved write view window
+    size_t window_size; // Size of each reserved window in bytes
+    size_t page_size;   // Size of a host page in bytes
+};
+
+
+// GLOBAL GUARD PAGE VARS ...
+
+// The guard page mappings for the current run
+extern guard_pages_t guard_pages;
+
+
+// FUNCTIONS ...
+
+/* Reserves the guard windows, maps the memory image page into them, and
+    installs the SIGSEGV handler
+
+    * The read view stays writable until guard_pages_seal() so that the
+      memory image can be loaded through it
+
+    RETURNS
+    true  | On success
+    false | If the host could not create the mappings or handler
+*/
+extern bool guard_pages_init();
+
+/* Makes the read view read only - Call once the memory image is loaded */
+extern void guard_pages_seal();
+
+/* Unmaps the guard windows and restores the default SIGSEGV handler */
+extern void guard_pages_deinit();
+
+/* Reads from image memory through the read view
+    Faults (raising an illegal operation error) if outside instr / data mem
+
+    PARAMS
+    dst_ptr   | Pointer to the memory that should be overwritten with read data
+    src_addr  | Source address in vm memory space
+    data_size | The size of the data to be read in bytes (at most a word)
+*/
+extern void guarded_read(void* const dst_ptr, const int32_t src_addr,
+                         const int data_size);
+
+/* Writes to image memory through the write view
+    Faults (raising an illegal operation error) if outside data mem
+
+    PARAMS
+    src_ptr   | Pointer to the data source to be copied
+    dst_addr  | Destination address in vm memory space
+    data_size | The size of the data to be copied in bytes (at most a word)
+*/
+extern void guarded_write(const void* const src_ptr, const int32_t dst_addr,
+                          const int data_size);
+
+
+// END HEADER GUARD ...
+#endif
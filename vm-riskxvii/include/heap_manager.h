@@ -8,11 +8,21 @@
     Contains typedefs, structs, constants, macros, and declarations for 
     methods used to construct and operate the heap manager.
 
-    * node_t           // Each node within the allocation tracking list
-    * linked_list_t    // List used to track currently allocated chunks
+    * free_run_t       // Free run lengths of a range of heap banks
+    * free_map_t       // Free bank bitmap with a segment tree for first fit
+    * free_runs_t      // Free runs in size class lists for best / segregated fit
     * heap_manager_t   // Heap manager object that abstracts all underlying
                        //  methods into single malloc() and free() calls
 
+    NOTE
+    * Every structure is sized from the heap geometry once at init so that
+      no host memory is allocated while the guest runs
+    * malloc() is O(log n) in the number of heap banks and access validation
+      is O(1) per allocated chunk touched, whatever the heap size
+    * free() finds its allocation with a single ownership map lookup and
+      leaves the ownership entries of the freed banks stale rather than
+      clearing them
+
 */
 
 
@@ -23,6 +33,7 @@
 
 // DEPENDENCIES ...
 #include <stdlib.h>
+#include <string.h>
 #include <stdio.h>
 #include <stdbool.h>
 #include <stdint.h>
@@ -43,31 +54,83 @@
 // The value to be returned from a failed malloc request
 #define MALLOC_FAIL_RETURN_VAL (0x00000000)
 
+// The number of heap banks held by each free map bitmap word
+#define FREE_MAP_WORD_BANKS    (64)
+
+// Marks a heap bank that is not part of any allocation in the ownership map
+#define BANK_NOT_OWNED         (-1)
+
+// Marks the end of a free run size class list
+#define NO_FREE_RUN            (-1)
+
+// The number of free run size classes - Class c holds runs of
+// [2^c, 2^(c+1)) banks
+#define FREE_RUN_CLASSES       (32)
+
+// HEAP ALLOCATION POLICIES
+
+#define HEAP_POLICY_FIRST_FIT  (0) // Lowest addressed run that fits (default)
+#define HEAP_POLICY_NEXT_FIT   (1) // First fit on from the last allocation
+#define HEAP_POLICY_BEST_FIT   (2) // Smallest run that fits
+#define HEAP_POLICY_SEGREGATED (3) // Most recently freed run of the smallest
+                                   //  size class that is sure to fit
+#define HEAP_POLICY_NUM        (4) // The number of policies
+
+// Policy names as given on the command line, indexed by policy
+#define HEAP_POLICY_NAMES {"first-fit", "next-fit", "best-fit", "segregated"}
+
 
 // DATA STRUCTURES ...
 
-// Node for the heap manager linked list
-typedef struct node_t node_t;
-struct node_t{
-    int start;    // The index (zero start) of the first allocated bank
-    int size;     // The number of banks allocated
-    node_t* next; // Pointer to the next node
-    node_t* prev; // Pointer to the previous node
+// Free run lengths (in banks) of a range of heap banks
+typedef struct free_run_t free_run_t;
+struct free_run_t {
+    int32_t prefix; // Free banks at the start of the range
+    int32_t suffix; // Free banks at the end of the range
+    int32_t best;   // The longest run of free banks anywhere in the range
+};
+
+// Bitmap of free heap banks with a segment tree of free runs built over it
+// Finds the first fit for any number of banks in O(log n)
+typedef struct free_map_t free_map_t;
+struct free_map_t {
+
+    // Attributes
+    uint64_t* words;    // Bit b of word w is set if bank (w * 64 + b) is free
+    free_run_t* tree;   // Node 1 is the root, the leaf of word w is node
+                        //  (num_leaves + w) and node n has children 2n, 2n+1
+    int32_t num_leaves; // The number of words rounded up to a power of two
+
+    // Methods
+    void (*set_range)(free_map_t* const, const int32_t, const int32_t,
+                      const bool);
+    int32_t (*first_fit)(const free_map_t* const, const int32_t);
+    int32_t (*first_fit_from)(const free_map_t* const, const int32_t,
+                              const int32_t);
+    bool (*is_free)(const free_map_t* const, const int32_t);
+    void (*deallocate)(free_map_t* const);
 };
 
-// Double linked list to hold vr_malloc information
-typedef struct linked_list_t linked_list_t;
-struct linked_list_t {
+// Free runs of heap banks kept in power of two size class lists
+// Each run is tagged at both ends so neighbours can be merged in O(1)
+// Only kept by the best-fit and segregated policies
+typedef struct free_runs_t free_runs_t;
+struct free_runs_t {
 
     // Attributes
-    node_t* head; // Pointer to the first node of the list
-    int size;     // The number of elements in the list
+    int32_t* run_banks; // Length of the free run starting at each bank
+                        //  - 0 if no free run starts there
+    int32_t* run_start; // Start of the free run ending at each bank
+    int32_t* next;      // Next run in the same size class, by start bank
+    int32_t* prev;      // Previous run in the same size class, by start bank
+    int32_t class_head[FREE_RUN_CLASSES]; // First run of each size class
 
     // Methods
-    void (*insert)(linked_list_t* const, node_t* const, const int);
-    void (*remove)(linked_list_t* const, const int);
-    node_t* (*get)(const linked_list_t* const, const int);
-    void (*deallocate)(linked_list_t* const list);
+    void (*add)(free_runs_t* const, const int32_t, const int32_t);
+    void (*remove)(free_runs_t* const, const int32_t);
+    int32_t (*best_fit)(const free_runs_t* const, const int32_t);
+    int32_t (*segregated_fit)(const free_runs_t* const, const int32_t);
+    void (*deallocate)(free_runs_t* const);
 };
 
 // Heap manager to manage memory allocation and deallocation
@@ -75,76 +138,150 @@ typedef struct heap_manager_t heap_manager_t;
 struct heap_manager_t {
 
     // Attributes
-    linked_list_t allocations; // List containing heap bank allocation information
+    free_map_t free_map;  // Which heap banks are free
+    int32_t* bank_owner;  // Start bank of the allocation last holding each
+                          //  bank or BANK_NOT_OWNED - May be stale
+    int32_t* alloc_banks; // Number of banks allocated, indexed by start bank
+                          //  - 0 if no allocation starts there
+    int policy;           // The HEAP_POLICY_* used to choose free banks
+    free_runs_t free_runs; // Free runs by size - Best-fit / segregated only
+    int32_t next_fit_from; // Where the next-fit policy starts searching
+    int32_t free_banks;   // The number of free heap banks
 
     // Methods
     void (*malloc)(heap_manager_t* const, const int32_t);
     void (*free)(heap_manager_t* const, const int32_t);
+    void (*calloc)(heap_manager_t* const, const int32_t);
+    void (*realloc)(heap_manager_t* const, const int32_t, const int32_t);
     bool (*is_valid_memory)(heap_manager_t* const, const int32_t, const int32_t);
+    bool (*is_freeable)(const heap_manager_t* const, const int32_t);
+    int32_t (*valid_span)(const heap_manager_t* const, const int32_t);
     void (*deallocate)(heap_manager_t* const);
 };
 
 
-// DOUBLE LINKED LIST METHODS ...
+// FREE MAP METHODS ...
 
-/* Initialises a new list object
-    Zeroes all attributes
+/* Initialises the given free map with every heap bank free
+
+    RETURNS
+    true  | On success
+    false | If the host failed to allocate the bitmap or tree
 */
-void list_init(linked_list_t* const list);
+bool free_map_init(free_map_t* const map);
+
+/* Marks the given range of heap banks as free or allocated
 
-/* Create a new node with the given data as contents
-    Returns NULL if an error occured
+    * Updates only the covered words and their ancestors in the tree
+    * O(n / 64 + log n) for a range of n banks
+
+    PARAMETERS
+    <free_map_t*> map | Pointer to the free map
+    <int32_t> start   | Index of the first bank in the range
+    <int32_t> num     | Number of banks in the range
+    <bool> is_free    | Whether the banks are now free
 */
-node_t* new_node(const int, const int);
+void free_map_set_range(free_map_t* const map, const int32_t start,
+                        const int32_t num, const bool is_free);
 
-/* Inserts the given node at the given index in the given list
+/* Finds the lowest indexed run of at least the given number of free banks
 
-    * Throws error if index is out of range
-    * Given index must be > 0
-    * Index range: [0, list.size - 1]
+    RETURNS
+    Index of the first bank of the run | If one exists
+    -1                                 | If no run is long enough
+*/
+int32_t free_map_first_fit(const free_map_t* const map, const int32_t num);
+
+/* Finds the lowest indexed run of at least the given number of free banks
+    that starts at or after the given bank
 
+    * O(log n) plus a scan of at most two bitmap words
+
+    RETURNS
+    Index of the first bank of the run | If one exists
+    -1                                 | If no run is long enough
 */
-void list_insert_node(linked_list_t* const list,
-                      node_t* const node, const int index);
+int32_t free_map_first_fit_from(const free_map_t* const map, const int32_t num,
+                                const int32_t from);
 
-/* Returns the node at the given index in the given list
+/* Returns whether the given heap bank is free */
+bool free_map_is_free(const free_map_t* const map, const int32_t bank);
 
-    * Returns NULL if given index is out of range
-    * Index range: [0, list.size - 1]
+/* Frees the bitmap and tree of the given free map */
+void free_map_deallocate(free_map_t* const map);
 
+
+// FREE RUN METHODS ...
+
+/* Initialises the given free runs with one run covering every heap bank
+
+    RETURNS
+    true  | On success
+    false | If the host failed to allocate the run tags or lists
 */
-node_t* list_get_node(const linked_list_t* const list, const int index);
+bool free_runs_init(free_runs_t* const runs);
 
-/* Removes the node at the given index in the given list
-    Index range: [0, list.size - 1]
+/* Adds the free run of the given number of banks starting at the given bank
+    Pushed onto the front of its size class list
 */
-void list_remove_node(linked_list_t* const list, const int index);
+void free_runs_add(free_runs_t* const runs, const int32_t start,
+                   const int32_t num);
+
+/* Removes the free run starting at the given bank */
+void free_runs_remove(free_runs_t* const runs, const int32_t start);
 
-/* Frees all malloc'd memory used by the list
+/* Finds the smallest free run of at least the given number of banks
+    Ties go to the lowest addressed run
 
-    * Removes all elements
-    * Frees all malloc'd memory
+    * Scans a single size class list
 
+    RETURNS
+    Start bank of the run | If one exists
+    NO_FREE_RUN           | If no run is long enough
 */
-void list_deallocate(linked_list_t* const list);
+int32_t free_runs_best_fit(const free_runs_t* const runs, const int32_t num);
+
+/* Finds a free run of at least the given number of banks by size class
+
+    * Takes the first run of the smallest class whose runs all fit
+    * Falls back to the first fitting run in the class of the request
+
+    RETURNS
+    Start bank of the run | If one exists
+    NO_FREE_RUN           | If no run is long enough
+*/
+int32_t free_runs_segregated_fit(const free_runs_t* const runs,
+                                 const int32_t num);
+
+/* Frees the run tags and lists of the given free runs */
+void free_runs_deallocate(free_runs_t* const runs);
 
 
 // HEAP MANAGER METHODS ...
 
 /* Initialises the referenced heap bank manager object
-    * Sets up empty list to store bank allocation data
+    * Sets up the free map and ownership map for the current heap geometry
+    * Sets up the free runs if the given policy needs them
     * Links methods as attributes
 
     PARAMETERS
     <heap_manager*> manager | Pointer to the heap manager
+    <int> policy            | The HEAP_POLICY_* used to choose free banks
+
+    RETURNS
+    true  | On success
+    false | If the host failed to allocate the manager's storage
 */
-extern heap_manager_t* heap_manager_init();
+extern bool heap_manager_init(heap_manager_t* const manager, const int policy);
 
-/* Deallocates all malloc'd memory within the heap manager
+/* Frees all storage held by the heap manager
     NOTE: Invalidates the heap manager. Only call when done.
 */
 extern void heap_manager_deallocate(heap_manager_t* const manager);
 
+/* Returns the HEAP_POLICY_* with the given name, or -1 if there is none */
+extern int heap_policy_from_name(const char* const name);
+
 /* Converts the given heap bank index to a memory address in the virtual machine
 
     PARAMETERS
@@ -181,6 +318,7 @@ int32_t addr_to_heap_index(const int32_t addr);
 bool is_heap_bank_addr(int32_t addr);
 
 /* Attempts to allocate the given ammount of memory in the heap banks
+    The banks are chosen by the manager's allocation policy
 
     PARAMETERS
     <heap_manager*> manager | Pointer to the heap manager
@@ -197,6 +335,7 @@ void heap_malloc(heap_manager_t* const manager, const int32_t size);
 /* Attempts to free the referenced memory
     Throws an illegal operation error if the given memory is not allocated
     or outside vm heap memory space.
+    O(1) lookup plus O(log n) to mark the banks free in the free map.
 
     PARAMETERS
     <heap_manager*> manager | Pointer to the heap manager
@@ -204,8 +343,62 @@ void heap_malloc(heap_manager_t* const manager, const int32_t size);
 */
 void heap_free(heap_manager_t* const manager, const int32_t addr);
 
+/* Attempts to allocate the given ammount of zeroed memory in the heap banks
+    As heap_malloc(), but every byte of the allocated banks is zeroed
+
+    PARAMETERS
+    <heap_manager*> manager | Pointer to the heap manager
+    <int32_t> size          | The size of the memory to be allocated in bytes
+
+    RETURNS
+    None - However ...
+    Saves pointer to allocated memory in register 28:
+    * NULL if couldn't allocate
+    * Pointer to allocated memory if successful
+*/
+void heap_calloc(heap_manager_t* const manager, const int32_t size);
+
+/* Attempts to resize the referenced memory to the given ammount of bytes
+
+    * A null address is the same as heap_malloc()
+    * Shrinks in place, releasing the banks no longer needed
+    * Grows in place if the banks directly after are free, otherwise moves
+      the memory to a new allocation (host memcpy) and frees the old one
+    * Throws an illegal operation error if the given memory is not allocated
+      or outside vm heap memory space (as heap_free())
+
+    PARAMETERS
+    <heap_manager*> manager | Pointer to the heap manager
+    <int32_t> addr          | The address of the memory block to be resized
+    <int32_t> size          | The new size of the memory block in bytes
+
+    RETURNS
+    None - However ...
+    Saves pointer to the resized memory in register 28:
+    * NULL if couldn't allocate - The memory is left as it was
+    * Pointer to the resized memory if successful
+*/
+void heap_realloc(heap_manager_t* const manager, const int32_t addr,
+                  const int32_t size);
+
+/* Returns whether freeing the given address would succeed
+
+    * The null address can always be freed (it does nothing)
+    * Otherwise it must point to the first bank of an allocation - One
+      lookup in the ownership map, whatever the number of allocations
+
+    PARAMETERS
+    <heap_manager*> manager | Pointer to the heap manager
+    <int32_t> addr          | The address of the memory block to be freed
+*/
+bool heap_is_freeable(const heap_manager_t* const manager, const int32_t addr);
+
 /* Returns whether the given memory field is allocated
 
+    * Checks that all addresses within the given field are allocated
+    * Checks addresses within the given field are in the same allocated chunk
+      or in directly adjacent allocated chunks
+
     PARAMETERS
     <heap_manager*> manager | Pointer to the heap manager
     <int32_t> start_addr    | The address (in vm memory space) to be checked
@@ -215,18 +408,32 @@ bool heap_is_valid_memory(heap_manager_t* const manager,
                   const int32_t start_addr, const int32_t size);
 
 
+/* Returns the number of bytes from the given address that can be accessed
+    (up to the end of the allocation holding it, extended through directly
+    adjacent allocations as heap_is_valid_memory() allows)
+
+    PARAMETERS
+    <heap_manager*> manager | Pointer to the heap manager
+    <int32_t> addr          | The address (in vm memory space) to start from
+
+    RETURNS
+    0   | If the address is not allocated
+    n   | Otherwise
+*/
+int32_t heap_valid_span(const heap_manager_t* const manager,
+                        const int32_t addr);
+
+
 // MANAGER INTERFACE METHODS ...
 
 /* Links the given heap manager to the system virtual routines
-    Saves a pointer to the heap manager in virtual routine memory
-    when is then accessed by other virtual machine sys calls
+    Saves a host side pointer to the heap manager which is then accessed
+    by other virtual machine sys calls
 */
 extern void link_heap_manager(heap_manager_t*);
 
 /* Returns a pointer to the heap manager object
-    Retrieves and returns the pointer to the heap manager object stored in the
-    virtual routine memory space. This pointer must originally be set using 
-    link_heap_manager()
+    This pointer must originally be set using link_heap_manager()
 */
 extern heap_manager_t* get_heap_manager();
 
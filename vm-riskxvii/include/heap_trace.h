@@ -0,0 +1,145 @@
+// Name:   Isaak Choi
+// UniKey: icho6322
+// SID:    520488399
+
+
+/* heap_trace.h
+
+    Contains the guest heap event trace - A compact binary log of every
+    malloc and free virtual routine call - and the functions used to write
+    and read it.
+
+    FORMAT (all fields little endian)
+    Header | 20 bytes
+      magic      | 4 bytes  | "RXHT"
+      version    | uint32_t | HEAP_TRACE_VERSION
+      bank_size  | int32_t  | Heap bank size in bytes
+      heap_size  | int32_t  | Heap bank mem size in bytes
+      policy     | int32_t  | HEAP_POLICY_* of the traced run
+    Event  | 17 bytes, one per call, in call order
+      kind       | uint8_t  | HEAP_TRACE_*
+      instr      | uint64_t | Guest instructions retired before the call
+      arg        | int32_t  | malloc / calloc / realloc size: size requested
+                            | free / realloc addr: address given
+      result     | int32_t  | malloc / calloc / realloc size: address
+                              returned (0 if failed)
+                            | free / realloc addr: HEAP_TRACE_FREE_OK or
+                              HEAP_TRACE_FREE_ERR
+
+    NOTE
+    * An erroring free or realloc stops the guest, so can only be the last
+      event
+    * A realloc is recorded as a realloc addr event followed (unless it
+      errored) by a realloc size event
+
+*/
+
+
+// HEADER GUARD ...
+#ifndef HEAP_TRACE_H
+#define HEAP_TRACE_H
+
+
+// DEPENDENCIES ...
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+
+// THIRD PARTY MEMORY LEAK DETECTOR ...
+#ifdef DEBUG_DETECT_LEAKS
+    #include "leak_detector_c.h"
+#endif
+
+
+// CONSTANTS ...
+
+// File identification
+#define HEAP_TRACE_MAGIC        "RXHT"
+#define HEAP_TRACE_MAGIC_SIZE   (4)
+#define HEAP_TRACE_VERSION      (1)
+
+// Encoded sizes in bytes
+#define HEAP_TRACE_HEADER_SIZE  (20)
+#define HEAP_TRACE_EVENT_SIZE   (17)
+
+// Event kinds
+#define HEAP_TRACE_MALLOC       (0)
+#define HEAP_TRACE_FREE         (1)
+#define HEAP_TRACE_CALLOC       (2)
+#define HEAP_TRACE_REALLOC_ADDR (3)
+#define HEAP_TRACE_REALLOC_SIZE (4)
+
+// Free results
+#define HEAP_TRACE_FREE_OK      (0)
+#define HEAP_TRACE_FREE_ERR     (-1)
+
+// Size of the host buffer in front of the trace file
+#define HEAP_TRACE_BUFFER_SIZE  (1 << 16)
+
+
+// DATA STRUCTURES ...
+
+// Heap geometry and policy of the traced run
+typedef struct heap_trace_header_t heap_trace_header_t;
+struct heap_trace_header_t {
+    int32_t bank_size;
+    int32_t heap_size;
+    int32_t policy;
+};
+
+// A single malloc or free call
+typedef struct heap_trace_event_t heap_trace_event_t;
+struct heap_trace_event_t {
+    uint8_t kind;   // HEAP_TRACE_*
+    uint64_t instr; // Guest instructions retired before the call
+    int32_t arg;    // Size requested or address given
+    int32_t result; // Address returned or HEAP_TRACE_FREE_*
+};
+
+
+// TRACE WRITER ...
+
+/* Opens the given file and writes the trace header to it
+    Events are recorded from then on until heap_trace_close()
+
+    RETURNS
+    true  | On success
+    false | If the file couldn't be opened or written
+*/
+extern bool heap_trace_open(const char* const path,
+                            const heap_trace_header_t* const header);
+
+/* Returns whether heap events are being recorded */
+extern bool heap_trace_is_open();
+
+/* Records the given event - Does nothing if no trace is open */
+extern void heap_trace_record(const heap_trace_event_t* const event);
+
+/* Flushes and closes the trace file - Does nothing if no trace is open */
+extern void heap_trace_close();
+
+
+// TRACE READER ...
+
+/* Reads and checks the trace header from the given file
+
+    RETURNS
+    true  | On success
+    false | If the file is not a heap trace of this version
+*/
+extern bool heap_trace_read_header(FILE* const file,
+                                   heap_trace_header_t* const header);
+
+/* Reads the next event from the given file
+
+    RETURNS
+    true  | On success
+    false | At the end of the file (or a truncated event)
+*/
+extern bool heap_trace_read_event(FILE* const file,
+                                  heap_trace_event_t* const event);
+
+
+// END HEADER GUARD ...
+#endif
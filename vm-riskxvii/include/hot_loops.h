@@ -0,0 +1,87 @@
+// Name:   Isaak Choi
+// UniKey: icho6322
+// SID:    520488399
+
+
+/* hot_loops.h
+
+    Contains hot loop detection and specialised loop traces for the
+    interpreter.
+
+    * Every taken backward branch or jump counts towards its target (the
+      loop head). Once a head has been branched back to
+      --hot-loop-threshold times, the loop - the instructions from the head
+      to the branch back to it - is predecoded into a trace
+    * A trace runs the loop on its own until the loop exits:
+      - The guest registers are held in host locals
+      - Branches inside the loop go straight to their target in the trace
+      - Loads and stores whose base register the loop never writes are
+        validated once when the trace is entered, and run without checks
+      - Other loads and stores of instruction / data memory only have an
+        inline range check
+    * The trace deoptimises - Writes the registers back and returns to the
+      interpreter at that instruction - on any access outside instruction /
+      data memory (virtual routines, the heap, errors), so the interpreter
+      handles it exactly as before
+
+    NOTE
+    * Only loops made up of base instructions, with no jal / jalr other
+      than a jal back to the head, are traced
+    * Loops with loads or stores aren't traced with --guard-pages, as that
+      mode relies on the interpreter's guarded accesses
+    * The execution budget is kept exactly - Every branch in a trace ends a
+      basic block, and a limit (or the wall time check) writes the
+      registers back before anything can throw
+
+*/
+
+
+// HEADER GUARD ...
+#ifndef HOT_LOOPS_H
+#define HOT_LOOPS_H
+
+
+// DEPENDENCIES ...
+#include <stdint.h>
+#include <stdbool.h>
+#include "system.h"
+#include "options.h"
+
+
+// THIRD PARTY MEMORY LEAK DETECTOR ...
+#ifdef DEBUG_DETECT_LEAKS
+    #include "leak_detector_c.h"
+#endif
+
+
+// CONSTANTS ...
+
+// Number of times a loop head is branched back to before it is traced
+#define DFLT_HOT_LOOP_THRESHOLD (64)
+
+// Longest loop traced (instructions)
+#define HOT_LOOP_MAX_OPS        (128)
+
+
+// FUNCTIONS ...
+
+/* Sets up hot loop detection for the given options (a threshold of 0
+   turns it off) - Must be called after the memory image has been read
+*/
+extern void hot_loops_init(const vm_options_t* const opts);
+
+/* Frees every loop trace */
+extern void hot_loops_deinit();
+
+/* Counts the taken backward branch or jump at 'branch_pc' towards its loop
+   head (the program counter), tracing the loop once it is hot, then runs
+   the loop's trace if it has one
+
+    * Must be called after the branch has run
+    * Leaves the program counter where the trace exited or deoptimised
+*/
+extern void hot_loop_back_edge(const int32_t branch_pc);
+
+
+// END HEADER GUARD ...
+#endif
@@ -18,8 +18,11 @@
 
 // DEPENDENCIES ...
 #include <stdint.h>
+#include <math.h>
+#include <fenv.h>
 #include "system.h"
 #include "utils.h"
+#include "mem_proofs.h"
 
 
 // THIRD PARTY MEMORY LEAK DETECTOR ...
@@ -62,10 +65,12 @@
 #define ID_EXTRACT_MASK_1  (OPCODE_EXTRACT_MASK)                    // opcode
 #define ID_EXTRACT_MASK_2  (ID_EXTRACT_MASK_1 | FUNC3_EXTRACT_MASK) // ^ + func3
 #define ID_EXTRACT_MASK_3  (ID_EXTRACT_MASK_2 | FUNC7_EXTRACT_MASK) // ^ + func7
+#define ID_EXTRACT_MASK_4  (ID_EXTRACT_MASK_3 | RS2_EXTRACT_MASK)   // ^ + rs2
 
 // Multipliers to move bit masks from least-significant aligned to original pos
-#define FUNC3_OFFSET_MULTIPLIER (0x1000)    // Shifts bits 7 places
-#define FUNC7_OFFSET_MULTIPLIER (0x2000000) // Shifts bits 25 places
+#define FUNC3_OFFSET_MULTIPLIER (0x1000)     // Shifts bits 7 places
+#define RS2_OFFSET_MULTIPLIER   (0x100000)   // Shifts bits 20 places
+#define FUNC7_OFFSET_MULTIPLIER (0x2000000u) // Shifts bits 25 places
 
 
 // INDIVIDUAL INSTRUCTION BIT INFO ...
@@ -285,6 +290,575 @@
                          JALR_FUNC3 * FUNC3_OFFSET_MULTIPLIER)
 
 
+// RV32M MULTIPLY / DIVIDE EXTENSION (--ext-m) ...
+
+// mul
+#define MUL_OPCODE      (0x33) // 0b00110011
+#define MUL_FUNC3       (0x00) // 0b00000000
+#define MUL_FUNC7       (0x01) // 0b00000001
+#define MUL_ID_BITS     (MUL_OPCODE + \
+                         MUL_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                         MUL_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// mulh
+#define MULH_OPCODE     (0x33) // 0b00110011
+#define MULH_FUNC3      (0x01) // 0b00000001
+#define MULH_FUNC7      (0x01) // 0b00000001
+#define MULH_ID_BITS    (MULH_OPCODE + \
+                         MULH_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                         MULH_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// mulhsu
+#define MULHSU_OPCODE   (0x33) // 0b00110011
+#define MULHSU_FUNC3    (0x02) // 0b00000010
+#define MULHSU_FUNC7    (0x01) // 0b00000001
+#define MULHSU_ID_BITS  (MULHSU_OPCODE + \
+                         MULHSU_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                         MULHSU_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// mulhu
+#define MULHU_OPCODE    (0x33) // 0b00110011
+#define MULHU_FUNC3     (0x03) // 0b00000011
+#define MULHU_FUNC7     (0x01) // 0b00000001
+#define MULHU_ID_BITS   (MULHU_OPCODE + \
+                         MULHU_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                         MULHU_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// div
+#define DIV_OPCODE      (0x33) // 0b00110011
+#define DIV_FUNC3       (0x04) // 0b00000100
+#define DIV_FUNC7       (0x01) // 0b00000001
+#define DIV_ID_BITS     (DIV_OPCODE + \
+                         DIV_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                         DIV_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// divu
+#define DIVU_OPCODE     (0x33) // 0b00110011
+#define DIVU_FUNC3      (0x05) // 0b00000101
+#define DIVU_FUNC7      (0x01) // 0b00000001
+#define DIVU_ID_BITS    (DIVU_OPCODE + \
+                         DIVU_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                         DIVU_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// rem
+#define REM_OPCODE      (0x33) // 0b00110011
+#define REM_FUNC3       (0x06) // 0b00000110
+#define REM_FUNC7       (0x01) // 0b00000001
+#define REM_ID_BITS     (REM_OPCODE + \
+                         REM_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                         REM_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// remu
+#define REMU_OPCODE     (0x33) // 0b00110011
+#define REMU_FUNC3      (0x07) // 0b00000111
+#define REMU_FUNC7      (0x01) // 0b00000001
+#define REMU_ID_BITS    (REMU_OPCODE + \
+                         REMU_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                         REMU_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+
+// ZBA ADDRESS GENERATION EXTENSION (--ext-zba) ...
+
+// sh1add
+#define SH1ADD_OPCODE   (0x33) // 0b00110011
+#define SH1ADD_FUNC3    (0x02) // 0b00000010
+#define SH1ADD_FUNC7    (0x10) // 0b00010000
+#define SH1ADD_ID_BITS  (SH1ADD_OPCODE + \
+                         SH1ADD_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                         SH1ADD_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// sh2add
+#define SH2ADD_OPCODE   (0x33) // 0b00110011
+#define SH2ADD_FUNC3    (0x04) // 0b00000100
+#define SH2ADD_FUNC7    (0x10) // 0b00010000
+#define SH2ADD_ID_BITS  (SH2ADD_OPCODE + \
+                         SH2ADD_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                         SH2ADD_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// sh3add
+#define SH3ADD_OPCODE   (0x33) // 0b00110011
+#define SH3ADD_FUNC3    (0x06) // 0b00000110
+#define SH3ADD_FUNC7    (0x10) // 0b00010000
+#define SH3ADD_ID_BITS  (SH3ADD_OPCODE + \
+                         SH3ADD_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                         SH3ADD_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+
+// ZBB BASIC BIT MANIPULATION EXTENSION (--ext-zbb) ...
+
+// andn
+#define ANDN_OPCODE     (0x33) // 0b00110011
+#define ANDN_FUNC3      (0x07) // 0b00000111
+#define ANDN_FUNC7      (0x20) // 0b00100000
+#define ANDN_ID_BITS    (ANDN_OPCODE + \
+                         ANDN_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                         ANDN_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// orn
+#define ORN_OPCODE      (0x33) // 0b00110011
+#define ORN_FUNC3       (0x06) // 0b00000110
+#define ORN_FUNC7       (0x20) // 0b00100000
+#define ORN_ID_BITS     (ORN_OPCODE + \
+                         ORN_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                         ORN_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// xnor
+#define XNOR_OPCODE     (0x33) // 0b00110011
+#define XNOR_FUNC3      (0x04) // 0b00000100
+#define XNOR_FUNC7      (0x20) // 0b00100000
+#define XNOR_ID_BITS    (XNOR_OPCODE + \
+                         XNOR_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                         XNOR_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// clz
+#define CLZ_OPCODE      (0x13) // 0b00010011
+#define CLZ_FUNC3       (0x01) // 0b00000001
+#define CLZ_FUNC7       (0x30) // 0b00110000
+#define CLZ_RS2         (0x00) // 0b00000000
+#define CLZ_ID_BITS     (CLZ_OPCODE + \
+                         CLZ_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                         CLZ_FUNC7 * FUNC7_OFFSET_MULTIPLIER + \
+                         CLZ_RS2 * RS2_OFFSET_MULTIPLIER)
+
+// ctz
+#define CTZ_OPCODE      (0x13) // 0b00010011
+#define CTZ_FUNC3       (0x01) // 0b00000001
+#define CTZ_FUNC7       (0x30) // 0b00110000
+#define CTZ_RS2         (0x01) // 0b00000001
+#define CTZ_ID_BITS     (CTZ_OPCODE + \
+                         CTZ_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                         CTZ_FUNC7 * FUNC7_OFFSET_MULTIPLIER + \
+                         CTZ_RS2 * RS2_OFFSET_MULTIPLIER)
+
+// cpop
+#define CPOP_OPCODE     (0x13) // 0b00010011
+#define CPOP_FUNC3      (0x01) // 0b00000001
+#define CPOP_FUNC7      (0x30) // 0b00110000
+#define CPOP_RS2        (0x02) // 0b00000010
+#define CPOP_ID_BITS    (CPOP_OPCODE + \
+                         CPOP_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                         CPOP_FUNC7 * FUNC7_OFFSET_MULTIPLIER + \
+                         CPOP_RS2 * RS2_OFFSET_MULTIPLIER)
+
+// sext.b
+#define SEXT_B_OPCODE   (0x13) // 0b00010011
+#define SEXT_B_FUNC3    (0x01) // 0b00000001
+#define SEXT_B_FUNC7    (0x30) // 0b00110000
+#define SEXT_B_RS2      (0x04) // 0b00000100
+#define SEXT_B_ID_BITS  (SEXT_B_OPCODE + \
+                         SEXT_B_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                         SEXT_B_FUNC7 * FUNC7_OFFSET_MULTIPLIER + \
+                         SEXT_B_RS2 * RS2_OFFSET_MULTIPLIER)
+
+// sext.h
+#define SEXT_H_OPCODE   (0x13) // 0b00010011
+#define SEXT_H_FUNC3    (0x01) // 0b00000001
+#define SEXT_H_FUNC7    (0x30) // 0b00110000
+#define SEXT_H_RS2      (0x05) // 0b00000101
+#define SEXT_H_ID_BITS  (SEXT_H_OPCODE + \
+                         SEXT_H_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                         SEXT_H_FUNC7 * FUNC7_OFFSET_MULTIPLIER + \
+                         SEXT_H_RS2 * RS2_OFFSET_MULTIPLIER)
+
+// zext.h
+#define ZEXT_H_OPCODE   (0x33) // 0b00110011
+#define ZEXT_H_FUNC3    (0x04) // 0b00000100
+#define ZEXT_H_FUNC7    (0x04) // 0b00000100
+#define ZEXT_H_RS2      (0x00) // 0b00000000
+#define ZEXT_H_ID_BITS  (ZEXT_H_OPCODE + \
+                         ZEXT_H_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                         ZEXT_H_FUNC7 * FUNC7_OFFSET_MULTIPLIER + \
+                         ZEXT_H_RS2 * RS2_OFFSET_MULTIPLIER)
+
+// min
+#define MIN_OPCODE      (0x33) // 0b00110011
+#define MIN_FUNC3       (0x04) // 0b00000100
+#define MIN_FUNC7       (0x05) // 0b00000101
+#define MIN_ID_BITS     (MIN_OPCODE + \
+                         MIN_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                         MIN_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// minu
+#define MINU_OPCODE     (0x33) // 0b00110011
+#define MINU_FUNC3      (0x05) // 0b00000101
+#define MINU_FUNC7      (0x05) // 0b00000101
+#define MINU_ID_BITS    (MINU_OPCODE + \
+                         MINU_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                         MINU_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// max
+#define MAX_OPCODE      (0x33) // 0b00110011
+#define MAX_FUNC3       (0x06) // 0b00000110
+#define MAX_FUNC7       (0x05) // 0b00000101
+#define MAX_ID_BITS     (MAX_OPCODE + \
+                         MAX_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                         MAX_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// maxu
+#define MAXU_OPCODE     (0x33) // 0b00110011
+#define MAXU_FUNC3      (0x07) // 0b00000111
+#define MAXU_FUNC7      (0x05) // 0b00000101
+#define MAXU_ID_BITS    (MAXU_OPCODE + \
+                         MAXU_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                         MAXU_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// rol
+#define ROL_OPCODE      (0x33) // 0b00110011
+#define ROL_FUNC3       (0x01) // 0b00000001
+#define ROL_FUNC7       (0x30) // 0b00110000
+#define ROL_ID_BITS     (ROL_OPCODE + \
+                         ROL_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                         ROL_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// ror
+#define ROR_OPCODE      (0x33) // 0b00110011
+#define ROR_FUNC3       (0x05) // 0b00000101
+#define ROR_FUNC7       (0x30) // 0b00110000
+#define ROR_ID_BITS     (ROR_OPCODE + \
+                         ROR_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                         ROR_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// rori
+#define RORI_OPCODE     (0x13) // 0b00010011
+#define RORI_FUNC3      (0x05) // 0b00000101
+#define RORI_FUNC7      (0x30) // 0b00110000
+#define RORI_ID_BITS    (RORI_OPCODE + \
+                         RORI_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                         RORI_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// orc.b
+#define ORC_B_OPCODE    (0x13) // 0b00010011
+#define ORC_B_FUNC3     (0x05) // 0b00000101
+#define ORC_B_FUNC7     (0x14) // 0b00010100
+#define ORC_B_RS2       (0x07) // 0b00000111
+#define ORC_B_ID_BITS   (ORC_B_OPCODE + \
+                         ORC_B_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                         ORC_B_FUNC7 * FUNC7_OFFSET_MULTIPLIER + \
+                         ORC_B_RS2 * RS2_OFFSET_MULTIPLIER)
+
+// rev8
+#define REV8_OPCODE     (0x13) // 0b00010011
+#define REV8_FUNC3      (0x05) // 0b00000101
+#define REV8_FUNC7      (0x34) // 0b00110100
+#define REV8_RS2        (0x18) // 0b00011000
+#define REV8_ID_BITS    (REV8_OPCODE + \
+                         REV8_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                         REV8_FUNC7 * FUNC7_OFFSET_MULTIPLIER + \
+                         REV8_RS2 * RS2_OFFSET_MULTIPLIER)
+
+
+// ZICSR CONTROL AND STATUS REGISTER ACCESS (--ext-zicntr, --ext-f) ...
+
+// Only the counters (--ext-zicntr) and the floating point csrs (--ext-f) are
+//  implemented, so these are only decoded when one of those is enabled.
+//  The imm forms use the rs1 field as an unsigned 5 bit source value.
+
+// csrrw
+#define CSRRW_OPCODE    (0x73) // 0b01110011
+#define CSRRW_FUNC3     (0x01) // 0b00000001
+#define CSRRW_ID_BITS   (CSRRW_OPCODE + \
+                         CSRRW_FUNC3 * FUNC3_OFFSET_MULTIPLIER)
+
+// csrrs
+#define CSRRS_OPCODE    (0x73) // 0b01110011
+#define CSRRS_FUNC3     (0x02) // 0b00000010
+#define CSRRS_ID_BITS   (CSRRS_OPCODE + \
+                         CSRRS_FUNC3 * FUNC3_OFFSET_MULTIPLIER)
+
+// csrrc
+#define CSRRC_OPCODE    (0x73) // 0b01110011
+#define CSRRC_FUNC3     (0x03) // 0b00000011
+#define CSRRC_ID_BITS   (CSRRC_OPCODE + \
+                         CSRRC_FUNC3 * FUNC3_OFFSET_MULTIPLIER)
+
+// csrrwi
+#define CSRRWI_OPCODE   (0x73) // 0b01110011
+#define CSRRWI_FUNC3    (0x05) // 0b00000101
+#define CSRRWI_ID_BITS  (CSRRWI_OPCODE + \
+                         CSRRWI_FUNC3 * FUNC3_OFFSET_MULTIPLIER)
+
+// csrrsi
+#define CSRRSI_OPCODE   (0x73) // 0b01110011
+#define CSRRSI_FUNC3    (0x06) // 0b00000110
+#define CSRRSI_ID_BITS  (CSRRSI_OPCODE + \
+                         CSRRSI_FUNC3 * FUNC3_OFFSET_MULTIPLIER)
+
+// csrrci
+#define CSRRCI_OPCODE   (0x73) // 0b01110011
+#define CSRRCI_FUNC3    (0x07) // 0b00000111
+#define CSRRCI_ID_BITS  (CSRRCI_OPCODE + \
+                         CSRRCI_FUNC3 * FUNC3_OFFSET_MULTIPLIER)
+
+// Mask for the csr number in the imm field of a csr instruction
+#define CSR_NUM_MASK    (0xFFF)
+
+// Counter csr numbers (low words) - Read only
+#define CSR_CYCLE       (0xC00)
+#define CSR_TIME        (0xC01)
+#define CSR_INSTRET     (0xC02)
+
+// Set in a counter csr number to read its high word (cycleh, timeh, ...)
+#define CSR_HIGH_WORD   (0x080)
+
+// Floating point csr numbers - fflags and frm are fields of fcsr
+#define CSR_FFLAGS      (0x001)
+#define CSR_FRM         (0x002)
+#define CSR_FCSR        (0x003)
+
+
+// RV32F SINGLE PRECISION FLOATING POINT EXTENSION (--ext-f) ...
+
+// Bit mask of the fmt field (bits 26:25) - 0 (single precision) for all
+//  the implemented instructions
+#define FMT_EXTRACT_MASK    (0x06000000)
+
+// Bit masks used to extract floating point instruction identifiers
+#define ID_EXTRACT_MASK_R4  (ID_EXTRACT_MASK_1 | FMT_EXTRACT_MASK)   // op + fmt
+#define ID_EXTRACT_MASK_RM  (ID_EXTRACT_MASK_1 | FUNC7_EXTRACT_MASK) // op + f7
+#define ID_EXTRACT_MASK_RM2 (ID_EXTRACT_MASK_RM | RS2_EXTRACT_MASK)  // ^ + rs2
+
+// Position of rs3 within the func7 field of the fused multiply add (R4)
+//  instructions - Its low two bits are fmt
+#define R4_RS3_SHIFT        (2)
+
+// Rounding modes - Held in the func3 (rm) field of instructions that round,
+//  where FRM_DYN selects the mode in fcsr. Other values are reserved.
+#define FRM_RNE             (0x0) // Round to nearest, ties to even
+#define FRM_RTZ             (0x1) // Round towards zero
+#define FRM_RDN             (0x2) // Round down (towards -infinity)
+#define FRM_RUP             (0x3) // Round up (towards +infinity)
+#define FRM_RMM             (0x4) // Round to nearest, ties to max magnitude
+#define FRM_DYN             (0x7) // Use the rounding mode in fcsr
+
+// Fields of the fcsr register
+#define FCSR_FFLAGS_MASK    (0x1F)
+#define FCSR_FRM_MASK       (0x07)
+#define FCSR_FRM_SHIFT      (5)
+#define FCSR_MASK           (0xFF)
+
+// Accrued exception flags (fflags)
+#define FFLAG_NX            (0x01) // Inexact
+#define FFLAG_UF            (0x02) // Underflow
+#define FFLAG_OF            (0x04) // Overflow
+#define FFLAG_DZ            (0x08) // Divide by zero
+#define FFLAG_NV            (0x10) // Invalid operation
+
+// Single precision bit patterns
+#define FP_SIGN_BIT         (0x80000000)
+#define FP_EXP_MASK         (0x7F800000)
+#define FP_FRAC_MASK        (0x007FFFFF)
+#define FP_QUIET_BIT        (0x00400000) // Set in quiet NaNs
+#define FP_CANONICAL_NAN    (0x7FC00000) // The NaN produced by arithmetic
+
+// Smallest floats too large to convert to an int32 and uint32 (2^31, 2^32)
+#define FP_INT32_LIMIT      (2147483648.0f)
+#define FP_UINT32_LIMIT     (4294967296.0f)
+
+// fclass result bits
+#define FCLASS_NEG_INF      (0x001)
+#define FCLASS_NEG_NORMAL   (0x002)
+#define FCLASS_NEG_SUBNORM  (0x004)
+#define FCLASS_NEG_ZERO     (0x008)
+#define FCLASS_POS_ZERO     (0x010)
+#define FCLASS_POS_SUBNORM  (0x020)
+#define FCLASS_POS_NORMAL   (0x040)
+#define FCLASS_POS_INF      (0x080)
+#define FCLASS_SNAN         (0x100)
+#define FCLASS_QNAN         (0x200)
+
+// flw
+#define FLW_OPCODE        (0x07) // 0b00000111
+#define FLW_FUNC3         (0x02) // 0b00000010
+#define FLW_ID_BITS       (FLW_OPCODE + \
+                           FLW_FUNC3 * FUNC3_OFFSET_MULTIPLIER)
+
+// fsw
+#define FSW_OPCODE        (0x27) // 0b00100111
+#define FSW_FUNC3         (0x02) // 0b00000010
+#define FSW_ID_BITS       (FSW_OPCODE + \
+                           FSW_FUNC3 * FUNC3_OFFSET_MULTIPLIER)
+
+// Fused multiply add (R4) instructions - Matched by opcode and fmt
+
+// fmadd.s
+#define FMADD_S_OPCODE    (0x43) // 0b01000011
+#define FMADD_S_ID_BITS   (FMADD_S_OPCODE)
+
+// fmsub.s
+#define FMSUB_S_OPCODE    (0x47) // 0b01000111
+#define FMSUB_S_ID_BITS   (FMSUB_S_OPCODE)
+
+// fnmsub.s
+#define FNMSUB_S_OPCODE   (0x4B) // 0b01001011
+#define FNMSUB_S_ID_BITS  (FNMSUB_S_OPCODE)
+
+// fnmadd.s
+#define FNMADD_S_OPCODE   (0x4F) // 0b01001111
+#define FNMADD_S_ID_BITS  (FNMADD_S_OPCODE)
+
+// Instructions that round - Matched by opcode and func7 (and rs2)
+
+// fadd.s
+#define FADD_S_OPCODE     (0x53) // 0b01010011
+#define FADD_S_FUNC7      (0x00) // 0b00000000
+#define FADD_S_ID_BITS    (FADD_S_OPCODE + \
+                           FADD_S_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// fsub.s
+#define FSUB_S_OPCODE     (0x53) // 0b01010011
+#define FSUB_S_FUNC7      (0x04) // 0b00000100
+#define FSUB_S_ID_BITS    (FSUB_S_OPCODE + \
+                           FSUB_S_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// fmul.s
+#define FMUL_S_OPCODE     (0x53) // 0b01010011
+#define FMUL_S_FUNC7      (0x08) // 0b00001000
+#define FMUL_S_ID_BITS    (FMUL_S_OPCODE + \
+                           FMUL_S_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// fdiv.s
+#define FDIV_S_OPCODE     (0x53) // 0b01010011
+#define FDIV_S_FUNC7      (0x0C) // 0b00001100
+#define FDIV_S_ID_BITS    (FDIV_S_OPCODE + \
+                           FDIV_S_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// fsqrt.s
+#define FSQRT_S_OPCODE    (0x53) // 0b01010011
+#define FSQRT_S_FUNC7     (0x2C) // 0b00101100
+#define FSQRT_S_RS2       (0x00) // 0b00000000
+#define FSQRT_S_ID_BITS   (FSQRT_S_OPCODE + \
+                           FSQRT_S_FUNC7 * FUNC7_OFFSET_MULTIPLIER + \
+                           FSQRT_S_RS2 * RS2_OFFSET_MULTIPLIER)
+
+// fcvt.w.s
+#define FCVT_W_S_OPCODE   (0x53) // 0b01010011
+#define FCVT_W_S_FUNC7    (0x60) // 0b01100000
+#define FCVT_W_S_RS2      (0x00) // 0b00000000
+#define FCVT_W_S_ID_BITS  (FCVT_W_S_OPCODE + \
+                           FCVT_W_S_FUNC7 * FUNC7_OFFSET_MULTIPLIER + \
+                           FCVT_W_S_RS2 * RS2_OFFSET_MULTIPLIER)
+
+// fcvt.wu.s
+#define FCVT_WU_S_OPCODE  (0x53) // 0b01010011
+#define FCVT_WU_S_FUNC7   (0x60) // 0b01100000
+#define FCVT_WU_S_RS2     (0x01) // 0b00000001
+#define FCVT_WU_S_ID_BITS (FCVT_WU_S_OPCODE + \
+                           FCVT_WU_S_FUNC7 * FUNC7_OFFSET_MULTIPLIER + \
+                           FCVT_WU_S_RS2 * RS2_OFFSET_MULTIPLIER)
+
+// fcvt.s.w
+#define FCVT_S_W_OPCODE   (0x53) // 0b01010011
+#define FCVT_S_W_FUNC7    (0x68) // 0b01101000
+#define FCVT_S_W_RS2      (0x00) // 0b00000000
+#define FCVT_S_W_ID_BITS  (FCVT_S_W_OPCODE + \
+                           FCVT_S_W_FUNC7 * FUNC7_OFFSET_MULTIPLIER + \
+                           FCVT_S_W_RS2 * RS2_OFFSET_MULTIPLIER)
+
+// fcvt.s.wu
+#define FCVT_S_WU_OPCODE  (0x53) // 0b01010011
+#define FCVT_S_WU_FUNC7   (0x68) // 0b01101000
+#define FCVT_S_WU_RS2     (0x01) // 0b00000001
+#define FCVT_S_WU_ID_BITS (FCVT_S_WU_OPCODE + \
+                           FCVT_S_WU_FUNC7 * FUNC7_OFFSET_MULTIPLIER + \
+                           FCVT_S_WU_RS2 * RS2_OFFSET_MULTIPLIER)
+
+// Instructions that don't round - Matched by opcode, func3, func7 (and rs2)
+
+// fsgnj.s
+#define FSGNJ_S_OPCODE    (0x53) // 0b01010011
+#define FSGNJ_S_FUNC3     (0x00) // 0b00000000
+#define FSGNJ_S_FUNC7     (0x10) // 0b00010000
+#define FSGNJ_S_ID_BITS   (FSGNJ_S_OPCODE + \
+                           FSGNJ_S_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                           FSGNJ_S_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// fsgnjn.s
+#define FSGNJN_S_OPCODE   (0x53) // 0b01010011
+#define FSGNJN_S_FUNC3    (0x01) // 0b00000001
+#define FSGNJN_S_FUNC7    (0x10) // 0b00010000
+#define FSGNJN_S_ID_BITS  (FSGNJN_S_OPCODE + \
+                           FSGNJN_S_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                           FSGNJN_S_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// fsgnjx.s
+#define FSGNJX_S_OPCODE   (0x53) // 0b01010011
+#define FSGNJX_S_FUNC3    (0x02) // 0b00000010
+#define FSGNJX_S_FUNC7    (0x10) // 0b00010000
+#define FSGNJX_S_ID_BITS  (FSGNJX_S_OPCODE + \
+                           FSGNJX_S_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                           FSGNJX_S_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// fmin.s
+#define FMIN_S_OPCODE     (0x53) // 0b01010011
+#define FMIN_S_FUNC3      (0x00) // 0b00000000
+#define FMIN_S_FUNC7      (0x14) // 0b00010100
+#define FMIN_S_ID_BITS    (FMIN_S_OPCODE + \
+                           FMIN_S_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                           FMIN_S_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// fmax.s
+#define FMAX_S_OPCODE     (0x53) // 0b01010011
+#define FMAX_S_FUNC3      (0x01) // 0b00000001
+#define FMAX_S_FUNC7      (0x14) // 0b00010100
+#define FMAX_S_ID_BITS    (FMAX_S_OPCODE + \
+                           FMAX_S_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                           FMAX_S_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// feq.s
+#define FEQ_S_OPCODE      (0x53) // 0b01010011
+#define FEQ_S_FUNC3       (0x02) // 0b00000010
+#define FEQ_S_FUNC7       (0x50) // 0b01010000
+#define FEQ_S_ID_BITS     (FEQ_S_OPCODE + \
+                           FEQ_S_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                           FEQ_S_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// flt.s
+#define FLT_S_OPCODE      (0x53) // 0b01010011
+#define FLT_S_FUNC3       (0x01) // 0b00000001
+#define FLT_S_FUNC7       (0x50) // 0b01010000
+#define FLT_S_ID_BITS     (FLT_S_OPCODE + \
+                           FLT_S_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                           FLT_S_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// fle.s
+#define FLE_S_OPCODE      (0x53) // 0b01010011
+#define FLE_S_FUNC3       (0x00) // 0b00000000
+#define FLE_S_FUNC7       (0x50) // 0b01010000
+#define FLE_S_ID_BITS     (FLE_S_OPCODE + \
+                           FLE_S_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                           FLE_S_FUNC7 * FUNC7_OFFSET_MULTIPLIER)
+
+// fmv.x.w
+#define FMV_X_W_OPCODE    (0x53) // 0b01010011
+#define FMV_X_W_FUNC3     (0x00) // 0b00000000
+#define FMV_X_W_FUNC7     (0x70) // 0b01110000
+#define FMV_X_W_RS2       (0x00) // 0b00000000
+#define FMV_X_W_ID_BITS   (FMV_X_W_OPCODE + \
+                           FMV_X_W_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                           FMV_X_W_FUNC7 * FUNC7_OFFSET_MULTIPLIER + \
+                           FMV_X_W_RS2 * RS2_OFFSET_MULTIPLIER)
+
+// fclass.s
+#define FCLASS_S_OPCODE   (0x53) // 0b01010011
+#define FCLASS_S_FUNC3    (0x01) // 0b00000001
+#define FCLASS_S_FUNC7    (0x70) // 0b01110000
+#define FCLASS_S_RS2      (0x00) // 0b00000000
+#define FCLASS_S_ID_BITS  (FCLASS_S_OPCODE + \
+                           FCLASS_S_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                           FCLASS_S_FUNC7 * FUNC7_OFFSET_MULTIPLIER + \
+                           FCLASS_S_RS2 * RS2_OFFSET_MULTIPLIER)
+
+// fmv.w.x
+#define FMV_W_X_OPCODE    (0x53) // 0b01010011
+#define FMV_W_X_FUNC3     (0x00) // 0b00000000
+#define FMV_W_X_FUNC7     (0x78) // 0b01111000
+#define FMV_W_X_RS2       (0x00) // 0b00000000
+#define FMV_W_X_ID_BITS   (FMV_W_X_OPCODE + \
+                           FMV_W_X_FUNC3 * FUNC3_OFFSET_MULTIPLIER + \
+                           FMV_W_X_FUNC7 * FUNC7_OFFSET_MULTIPLIER + \
+                           FMV_W_X_RS2 * RS2_OFFSET_MULTIPLIER)
+
+
 // ADDITIONAL INSTRUCTION TYPE ANATOMY INFO FOR INSTRUCTION BIT PARSING ...
 
 // Length in bits of each immediate number after joining for each instr type
@@ -706,6 +1280,447 @@ void exec_jal(instruction_t* const instr);
 */
 void exec_jalr(instruction_t* const instr);
 
+// MULTIPLY AND DIVIDE OPERATIONS (RV32M - only decoded with --ext-m)
+
+/* Executes the 'mul' instruction
+    Uses the given 'instr' data to execute the 'mul' instruction.
+    Format    | R
+    Operation | R[rd] = (R[rs1] * R[rs2])[31:0]
+*/
+void exec_mul(instruction_t* const instr);
+
+/* Executes the 'mulh' instruction
+    Uses the given 'instr' data to execute the 'mulh' instruction.
+    Format    | R
+    Operation | R[rd] = (sext(R[rs1]) * sext(R[rs2]))[63:32]
+*/
+void exec_mulh(instruction_t* const instr);
+
+/* Executes the 'mulhsu' instruction
+    Uses the given 'instr' data to execute the 'mulhsu' instruction.
+    Format    | R
+    Operation | R[rd] = (sext(R[rs1]) * zext(R[rs2]))[63:32]
+*/
+void exec_mulhsu(instruction_t* const instr);
+
+/* Executes the 'mulhu' instruction
+    Uses the given 'instr' data to execute the 'mulhu' instruction.
+    Format    | R
+    Operation | R[rd] = (zext(R[rs1]) * zext(R[rs2]))[63:32]
+*/
+void exec_mulhu(instruction_t* const instr);
+
+/* Executes the 'div' instruction
+    Uses the given 'instr' data to execute the 'div' instruction.
+    Format    | R
+    Operation | R[rd] = R[rs1] / R[rs2] (rounded towards zero)
+*/
+void exec_div(instruction_t* const instr);
+
+/* Executes the 'divu' instruction
+    Uses the given 'instr' data to execute the 'divu' instruction.
+    Format    | R
+    Operation | R[rd] = R[rs1] / R[rs2] (unsigned)
+*/
+void exec_divu(instruction_t* const instr);
+
+/* Executes the 'rem' instruction
+    Uses the given 'instr' data to execute the 'rem' instruction.
+    Format    | R
+    Operation | R[rd] = R[rs1] % R[rs2] (sign of R[rs1])
+*/
+void exec_rem(instruction_t* const instr);
+
+/* Executes the 'remu' instruction
+    Uses the given 'instr' data to execute the 'remu' instruction.
+    Format    | R
+    Operation | R[rd] = R[rs1] % R[rs2] (unsigned)
+*/
+void exec_remu(instruction_t* const instr);
+
+// ADDRESS GENERATION OPERATIONS (ZBA - only decoded with --ext-zba)
+
+/* Executes the 'sh1add' instruction
+    Uses the given 'instr' data to execute the 'sh1add' instruction.
+    Format    | R
+    Operation | R[rd] = R[rs2] + (R[rs1] « 1)
+*/
+void exec_sh1add(instruction_t* const instr);
+
+/* Executes the 'sh2add' instruction
+    Uses the given 'instr' data to execute the 'sh2add' instruction.
+    Format    | R
+    Operation | R[rd] = R[rs2] + (R[rs1] « 2)
+*/
+void exec_sh2add(instruction_t* const instr);
+
+/* Executes the 'sh3add' instruction
+    Uses the given 'instr' data to execute the 'sh3add' instruction.
+    Format    | R
+    Operation | R[rd] = R[rs2] + (R[rs1] « 3)
+*/
+void exec_sh3add(instruction_t* const instr);
+
+// BIT MANIPULATION OPERATIONS (ZBB - only decoded with --ext-zbb)
+
+/* Executes the 'andn' instruction
+    Uses the given 'instr' data to execute the 'andn' instruction.
+    Format    | R
+    Operation | R[rd] = R[rs1] & ~R[rs2]
+*/
+void exec_andn(instruction_t* const instr);
+
+/* Executes the 'orn' instruction
+    Uses the given 'instr' data to execute the 'orn' instruction.
+    Format    | R
+    Operation | R[rd] = R[rs1] | ~R[rs2]
+*/
+void exec_orn(instruction_t* const instr);
+
+/* Executes the 'xnor' instruction
+    Uses the given 'instr' data to execute the 'xnor' instruction.
+    Format    | R
+    Operation | R[rd] = ~(R[rs1] ˆ R[rs2])
+*/
+void exec_xnor(instruction_t* const instr);
+
+/* Executes the 'clz' instruction
+    Uses the given 'instr' data to execute the 'clz' instruction.
+    Format    | I
+    Operation | R[rd] = number of leading zero bits in R[rs1]
+*/
+void exec_clz(instruction_t* const instr);
+
+/* Executes the 'ctz' instruction
+    Uses the given 'instr' data to execute the 'ctz' instruction.
+    Format    | I
+    Operation | R[rd] = number of trailing zero bits in R[rs1]
+*/
+void exec_ctz(instruction_t* const instr);
+
+/* Executes the 'cpop' instruction
+    Uses the given 'instr' data to execute the 'cpop' instruction.
+    Format    | I
+    Operation | R[rd] = number of set bits in R[rs1]
+*/
+void exec_cpop(instruction_t* const instr);
+
+/* Executes the 'sext.b' instruction
+    Uses the given 'instr' data to execute the 'sext.b' instruction.
+    Format    | I
+    Operation | R[rd] = sext(R[rs1][7:0])
+*/
+void exec_sext_b(instruction_t* const instr);
+
+/* Executes the 'sext.h' instruction
+    Uses the given 'instr' data to execute the 'sext.h' instruction.
+    Format    | I
+    Operation | R[rd] = sext(R[rs1][15:0])
+*/
+void exec_sext_h(instruction_t* const instr);
+
+/* Executes the 'zext.h' instruction
+    Uses the given 'instr' data to execute the 'zext.h' instruction.
+    Format    | R
+    Operation | R[rd] = zext(R[rs1][15:0])
+*/
+void exec_zext_h(instruction_t* const instr);
+
+/* Executes the 'min' instruction
+    Uses the given 'instr' data to execute the 'min' instruction.
+    Format    | R
+    Operation | R[rd] = (R[rs1] < R[rs2]) ? R[rs1] : R[rs2]
+*/
+void exec_min(instruction_t* const instr);
+
+/* Executes the 'minu' instruction
+    Uses the given 'instr' data to execute the 'minu' instruction.
+    Format    | R
+    Operation | R[rd] = (R[rs1] < R[rs2]) ? R[rs1] : R[rs2] (unsigned)
+*/
+void exec_minu(instruction_t* const instr);
+
+/* Executes the 'max' instruction
+    Uses the given 'instr' data to execute the 'max' instruction.
+    Format    | R
+    Operation | R[rd] = (R[rs1] > R[rs2]) ? R[rs1] : R[rs2]
+*/
+void exec_max(instruction_t* const instr);
+
+/* Executes the 'maxu' instruction
+    Uses the given 'instr' data to execute the 'maxu' instruction.
+    Format    | R
+    Operation | R[rd] = (R[rs1] > R[rs2]) ? R[rs1] : R[rs2] (unsigned)
+*/
+void exec_maxu(instruction_t* const instr);
+
+/* Executes the 'rol' instruction
+    Uses the given 'instr' data to execute the 'rol' instruction.
+    Format    | R
+    Operation | R[rd] = R[rs1] rotated left by R[rs2][4:0]
+*/
+void exec_rol(instruction_t* const instr);
+
+/* Executes the 'ror' instruction
+    Uses the given 'instr' data to execute the 'ror' instruction.
+    Format    | R
+    Operation | R[rd] = R[rs1] rotated right by R[rs2][4:0]
+*/
+void exec_ror(instruction_t* const instr);
+
+/* Executes the 'rori' instruction
+    Uses the given 'instr' data to execute the 'rori' instruction.
+    Format    | I
+    Operation | R[rd] = R[rs1] rotated right by imm[4:0]
+*/
+void exec_rori(instruction_t* const instr);
+
+/* Executes the 'orc.b' instruction
+    Uses the given 'instr' data to execute the 'orc.b' instruction.
+    Format    | I
+    Operation | R[rd][8i+7:8i] = (R[rs1][8i+7:8i] != 0) ? 0xFF : 0x00
+*/
+void exec_orc_b(instruction_t* const instr);
+
+/* Executes the 'rev8' instruction
+    Uses the given 'instr' data to execute the 'rev8' instruction.
+    Format    | I
+    Operation | R[rd] = R[rs1] with its byte order reversed
+*/
+void exec_rev8(instruction_t* const instr);
+
+// CONTROL AND STATUS REGISTER OPERATIONS (ZICSR - only decoded with
+//  --ext-zicntr or --ext-f)
+
+/* Executes the 'csrrw' instruction
+    Uses the given 'instr' data to execute the 'csrrw' instruction.
+    Format    | I
+    Operation | R[rd] = CSR[imm], CSR[imm] = R[rs1]
+*/
+void exec_csrrw(instruction_t* const instr);
+
+/* Executes the 'csrrs' instruction
+    Uses the given 'instr' data to execute the 'csrrs' instruction.
+    Format    | I
+    Operation | R[rd] = CSR[imm], CSR[imm] = CSR[imm] | R[rs1]
+*/
+void exec_csrrs(instruction_t* const instr);
+
+/* Executes the 'csrrc' instruction
+    Uses the given 'instr' data to execute the 'csrrc' instruction.
+    Format    | I
+    Operation | R[rd] = CSR[imm], CSR[imm] = CSR[imm] & ~R[rs1]
+*/
+void exec_csrrc(instruction_t* const instr);
+
+/* Executes the 'csrrwi' instruction
+    Uses the given 'instr' data to execute the 'csrrwi' instruction.
+    Format    | I
+    Operation | R[rd] = CSR[imm], CSR[imm] = uimm (the rs1 field)
+*/
+void exec_csrrwi(instruction_t* const instr);
+
+/* Executes the 'csrrsi' instruction
+    Uses the given 'instr' data to execute the 'csrrsi' instruction.
+    Format    | I
+    Operation | R[rd] = CSR[imm], CSR[imm] = CSR[imm] | uimm (the rs1 field)
+*/
+void exec_csrrsi(instruction_t* const instr);
+
+/* Executes the 'csrrci' instruction
+    Uses the given 'instr' data to execute the 'csrrci' instruction.
+    Format    | I
+    Operation | R[rd] = CSR[imm], CSR[imm] = CSR[imm] & ~uimm (the rs1 field)
+*/
+void exec_csrrci(instruction_t* const instr);
+
+// SINGLE PRECISION FLOATING POINT OPERATIONS (RV32F - only decoded with
+//  --ext-f)
+
+/* Executes the 'flw' instruction
+    Uses the given 'instr' data to execute the 'flw' instruction.
+    Format    | I
+    Operation | F[rd] = M[R[rs1] + imm]
+*/
+void exec_flw(instruction_t* const instr);
+
+/* Executes the 'fsw' instruction
+    Uses the given 'instr' data to execute the 'fsw' instruction.
+    Format    | S
+    Operation | M[R[rs1] + imm] = F[rs2]
+*/
+void exec_fsw(instruction_t* const instr);
+
+/* Executes the 'fmadd.s' instruction
+    Uses the given 'instr' data to execute the 'fmadd.s' instruction.
+    Format    | R4
+    Operation | F[rd] = F[rs1] * F[rs2] + F[rs3] (rounded once)
+*/
+void exec_fmadd_s(instruction_t* const instr);
+
+/* Executes the 'fmsub.s' instruction
+    Uses the given 'instr' data to execute the 'fmsub.s' instruction.
+    Format    | R4
+    Operation | F[rd] = F[rs1] * F[rs2] - F[rs3] (rounded once)
+*/
+void exec_fmsub_s(instruction_t* const instr);
+
+/* Executes the 'fnmsub.s' instruction
+    Uses the given 'instr' data to execute the 'fnmsub.s' instruction.
+    Format    | R4
+    Operation | F[rd] = -(F[rs1] * F[rs2]) + F[rs3] (rounded once)
+*/
+void exec_fnmsub_s(instruction_t* const instr);
+
+/* Executes the 'fnmadd.s' instruction
+    Uses the given 'instr' data to execute the 'fnmadd.s' instruction.
+    Format    | R4
+    Operation | F[rd] = -(F[rs1] * F[rs2]) - F[rs3] (rounded once)
+*/
+void exec_fnmadd_s(instruction_t* const instr);
+
+/* Executes the 'fadd.s' instruction
+    Uses the given 'instr' data to execute the 'fadd.s' instruction.
+    Format    | R
+    Operation | F[rd] = F[rs1] + F[rs2]
+*/
+void exec_fadd_s(instruction_t* const instr);
+
+/* Executes the 'fsub.s' instruction
+    Uses the given 'instr' data to execute the 'fsub.s' instruction.
+    Format    | R
+    Operation | F[rd] = F[rs1] - F[rs2]
+*/
+void exec_fsub_s(instruction_t* const instr);
+
+/* Executes the 'fmul.s' instruction
+    Uses the given 'instr' data to execute the 'fmul.s' instruction.
+    Format    | R
+    Operation | F[rd] = F[rs1] * F[rs2]
+*/
+void exec_fmul_s(instruction_t* const instr);
+
+/* Executes the 'fdiv.s' instruction
+    Uses the given 'instr' data to execute the 'fdiv.s' instruction.
+    Format    | R
+    Operation | F[rd] = F[rs1] / F[rs2]
+*/
+void exec_fdiv_s(instruction_t* const instr);
+
+/* Executes the 'fsqrt.s' instruction
+    Uses the given 'instr' data to execute the 'fsqrt.s' instruction.
+    Format    | R
+    Operation | F[rd] = sqrt(F[rs1])
+*/
+void exec_fsqrt_s(instruction_t* const instr);
+
+/* Executes the 'fcvt.w.s' instruction
+    Uses the given 'instr' data to execute the 'fcvt.w.s' instruction.
+    Format    | R
+    Operation | R[rd] = int32(F[rs1])
+                Out of range values and NaNs saturate (NaN to INT32_MAX)
+*/
+void exec_fcvt_w_s(instruction_t* const instr);
+
+/* Executes the 'fcvt.wu.s' instruction
+    Uses the given 'instr' data to execute the 'fcvt.wu.s' instruction.
+    Format    | R
+    Operation | R[rd] = uint32(F[rs1])
+                Out of range values and NaNs saturate (NaN to UINT32_MAX)
+*/
+void exec_fcvt_wu_s(instruction_t* const instr);
+
+/* Executes the 'fcvt.s.w' instruction
+    Uses the given 'instr' data to execute the 'fcvt.s.w' instruction.
+    Format    | R
+    Operation | F[rd] = float(R[rs1])
+*/
+void exec_fcvt_s_w(instruction_t* const instr);
+
+/* Executes the 'fcvt.s.wu' instruction
+    Uses the given 'instr' data to execute the 'fcvt.s.wu' instruction.
+    Format    | R
+    Operation | F[rd] = float((unsigned)R[rs1])
+*/
+void exec_fcvt_s_wu(instruction_t* const instr);
+
+/* Executes the 'fsgnj.s' instruction
+    Uses the given 'instr' data to execute the 'fsgnj.s' instruction.
+    Format    | R
+    Operation | F[rd] = |F[rs1]| with the sign of F[rs2]
+*/
+void exec_fsgnj_s(instruction_t* const instr);
+
+/* Executes the 'fsgnjn.s' instruction
+    Uses the given 'instr' data to execute the 'fsgnjn.s' instruction.
+    Format    | R
+    Operation | F[rd] = |F[rs1]| with the opposite sign of F[rs2]
+*/
+void exec_fsgnjn_s(instruction_t* const instr);
+
+/* Executes the 'fsgnjx.s' instruction
+    Uses the given 'instr' data to execute the 'fsgnjx.s' instruction.
+    Format    | R
+    Operation | F[rd] = F[rs1] with its sign xored with the sign of F[rs2]
+*/
+void exec_fsgnjx_s(instruction_t* const instr);
+
+/* Executes the 'fmin.s' instruction
+    Uses the given 'instr' data to execute the 'fmin.s' instruction.
+    Format    | R
+    Operation | F[rd] = min(F[rs1], F[rs2])
+*/
+void exec_fmin_s(instruction_t* const instr);
+
+/* Executes the 'fmax.s' instruction
+    Uses the given 'instr' data to execute the 'fmax.s' instruction.
+    Format    | R
+    Operation | F[rd] = max(F[rs1], F[rs2])
+*/
+void exec_fmax_s(instruction_t* const instr);
+
+/* Executes the 'feq.s' instruction
+    Uses the given 'instr' data to execute the 'feq.s' instruction.
+    Format    | R
+    Operation | R[rd] = (F[rs1] == F[rs2]) ? 1 : 0
+*/
+void exec_feq_s(instruction_t* const instr);
+
+/* Executes the 'flt.s' instruction
+    Uses the given 'instr' data to execute the 'flt.s' instruction.
+    Format    | R
+    Operation | R[rd] = (F[rs1] < F[rs2]) ? 1 : 0
+*/
+void exec_flt_s(instruction_t* const instr);
+
+/* Executes the 'fle.s' instruction
+    Uses the given 'instr' data to execute the 'fle.s' instruction.
+    Format    | R
+    Operation | R[rd] = (F[rs1] <= F[rs2]) ? 1 : 0
+*/
+void exec_fle_s(instruction_t* const instr);
+
+/* Executes the 'fmv.x.w' instruction
+    Uses the given 'instr' data to execute the 'fmv.x.w' instruction.
+    Format    | R
+    Operation | R[rd] = F[rs1] (raw bits)
+*/
+void exec_fmv_x_w(instruction_t* const instr);
+
+/* Executes the 'fclass.s' instruction
+    Uses the given 'instr' data to execute the 'fclass.s' instruction.
+    Format    | R
+    Operation | R[rd] = the FCLASS_* bit of the class of F[rs1]
+*/
+void exec_fclass_s(instruction_t* const instr);
+
+/* Executes the 'fmv.w.x' instruction
+    Uses the given 'instr' data to execute the 'fmv.w.x' instruction.
+    Format    | R
+    Operation | F[rd] = R[rs1] (raw bits)
+*/
+void exec_fmv_w_x(instruction_t* const instr);
+
 
 // INSTRUCTION PARSER AND EXECUTOR ...
 
@@ -0,0 +1,85 @@
+// Name:   Isaak Choi
+// UniKey: icho6322
+// SID:    520488399
+
+
+/* mem_proofs.h
+
+    Contains the load time memory access analysis, which proves where the
+    loads and stores of a memory image can go so that the executor can skip
+    the checks mem_read() / mem_write() would make.
+
+    * A dataflow pass over instruction memory follows every path from the
+      entry point, tracking the range of values each register and data
+      memory word (spilled registers and locals) can hold - Enough for the
+      stack pointer and lui built constant bases
+    * Each base load / store (lb, lh, lw, lbu, lhu, sb, sh, sw) reached is
+      given one of the MEM_PROOF_* facts below, indexed by its address
+    * A jalr whose target isn't a constant is assumed to land on a return
+      address (the instruction after a jal / jalr that links) or a constant
+      jalr target in the range of its target - One landing anywhere else
+      voids every proof for the rest of the run
+
+    NOTE
+    * The pass isn't run with --guard-pages, --aot or --no-mem-proofs, and
+      proves nothing if a path can run an instruction fetched partly from
+      data memory
+    * The only registers virtual routines write (VR_RESULT_REGISTER and
+      HEAP_PTR_OUT_REGISTER) are assumed changed by any access that may
+      call one, as is all of data memory unless the routine is known to
+      leave it alone (console output, halt, dumps, the heap, memcmp)
+
+*/
+
+
+// HEADER GUARD ...
+#ifndef MEM_PROOFS_H
+#define MEM_PROOFS_H
+
+
+// DEPENDENCIES ...
+#include <stdint.h>
+#include <stdbool.h>
+#include "system.h"
+#include "options.h"
+
+
+// THIRD PARTY MEMORY LEAK DETECTOR ...
+#ifdef DEBUG_DETECT_LEAKS
+    #include "leak_detector_c.h"
+#endif
+
+
+// CONSTANTS ...
+
+// What is proven about the address of the load / store at an address
+#define MEM_PROOF_UNKNOWN     (0) // Nothing - Fully checked
+#define MEM_PROOF_NOT_VIRTUAL (1) // Never a virtual routine
+#define MEM_PROOF_IN_MEMORY   (2) // Always fully inside instruction / data
+                                  //  memory (loads) or data memory (stores)
+
+
+// GLOBAL MEMORY PROOF VARS ...
+
+// The MEM_PROOF_* of the load / store at each address of instruction memory
+extern uint8_t mem_proofs[INST_MEM_SIZE];
+
+// Whether a jalr landing at each address voids the proofs
+extern bool mem_proof_voiding_targets[INST_MEM_SIZE];
+
+
+// FUNCTIONS ...
+
+/* Runs the analysis for the given options - Must be called after the memory
+   image has been read (and compressed instructions predecoded)
+*/
+extern void mem_proofs_init(const vm_options_t* const opts);
+
+/* Voids every proof - Called when a jalr lands somewhere the analysis didn't
+   follow it to
+*/
+extern void mem_proofs_void();
+
+
+// END HEADER GUARD ...
+#endif
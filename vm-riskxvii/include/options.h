@@ -0,0 +1,153 @@
+// Name:   Isaak Choi
+// UniKey: icho6322
+// SID:    520488399
+
+
+/* options.h
+
+    Contains the command line option parser and the option values
+    selected for the current run of the virtual machine.
+
+    USAGE
+    vm_riskxvii [options] <memory_image_binary>
+
+    OPTIONS
+    --max-instr=<n>   | Stop after n guest instructions have been executed
+    --max-time-ms=<n> | Stop after n milliseconds of wall time
+    --max-output=<n>  | Stop after n bytes have been written to stdout
+    --max-input=<n>   | Stop after n bytes have been read from stdin
+    --heap-size=<n>   | Size of heap bank memory in bytes (default 8192)
+    --heap-bank-size=<n> | Size of each heap bank in bytes (default 64)
+    --heap-policy=<p> | Heap allocation policy - first-fit (default),
+                        next-fit, best-fit, or segregated
+    --guard-pages     | Bounds check instruction and data memory accesses
+                        with host guard pages instead of in software
+    --heap-trace=<f>  | Record every malloc and free call to the binary
+                        heap trace file f (see heap_trace.h)
+    --aot=<f>         | Run the ahead of time translation of the memory image
+                        in the shared object f where it has one (see aot.h)
+    --ext-m           | Decode the RV32M multiply and divide instructions
+    --ext-zba         | Decode the Zba address generation instructions
+    --ext-zbb         | Decode the Zbb basic bit manipulation instructions
+    --ext-c           | Decode RV32C compressed (16 bit) instructions
+    --ext-zicntr      | Decode the Zicntr counter reads (rdcycle, rdtime,
+                        rdinstret and their high words)
+    --ext-f           | Decode RV32F single precision floating point
+                        instructions (and the fcsr csrs)
+    --hot-loop-threshold=<n> | Trace loops once they have been branched back
+                        to n times (default 64, 0 never traces them, see
+                        hot_loops.h)
+    --no-mem-proofs   | Fully check every load and store, rather than only
+                        those the load time analysis can't prove safe (see
+                        mem_proofs.h)
+    --stats           | Print the number of guest instructions executed to
+                        stderr when the guest stops
+
+    NOTE
+    * A limit of 0 (the default) means unlimited
+    * The heap size must be a non-zero multiple of the heap bank size and
+      no larger than MAX_HEAP_MEM_SIZE
+
+*/
+
+
+// HEADER GUARD ...
+#ifndef OPTIONS_H
+#define OPTIONS_H
+
+
+// DEPENDENCIES ...
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// THIRD PARTY MEMORY LEAK DETECTOR ...
+#ifdef DEBUG_DETECT_LEAKS
+    #include "leak_detector_c.h"
+#endif
+
+
+// CONSTANTS ...
+
+// Prefix shared by all command line options
+#define OPT_PREFIX          "--"
+
+// Option names (without the leading OPT_PREFIX)
+#define OPT_MAX_INSTR       "max-instr="
+#define OPT_MAX_TIME_MS     "max-time-ms="
+#define OPT_MAX_OUTPUT      "max-output="
+#define OPT_MAX_INPUT       "max-input="
+#define OPT_HEAP_SIZE       "heap-size="
+#define OPT_HEAP_BANK_SIZE  "heap-bank-size="
+#define OPT_HEAP_POLICY     "heap-policy="
+#define OPT_GUARD_PAGES     "guard-pages"
+#define OPT_HEAP_TRACE      "heap-trace="
+#define OPT_AOT             "aot="
+#define OPT_EXT_M           "ext-m"
+#define OPT_EXT_ZBA         "ext-zba"
+#define OPT_EXT_ZBB         "ext-zbb"
+#define OPT_EXT_C           "ext-c"
+#define OPT_EXT_ZICNTR      "ext-zicntr"
+#define OPT_EXT_F           "ext-f"
+#define OPT_STATS           "stats"
+#define OPT_NO_MEM_PROOFS   "no-mem-proofs"
+#define OPT_HOT_LOOP_THRESHOLD "hot-loop-threshold="
+
+// The value of a limit that is not enforced
+#define OPT_UNLIMITED       (0)
+
+
+// DATA STRUCTURES ...
+
+// Holds every option selected on the command line
+typedef struct vm_options_t vm_options_t;
+struct vm_options_t {
+    const char* bin_path;      // Path to the memory image binary file
+    uint64_t max_instr;        // Guest instruction limit
+    uint64_t max_time_ms;      // Wall time limit in milliseconds
+    uint64_t max_output_bytes; // Console output limit in bytes
+    uint64_t max_input_bytes;  // Console input limit in bytes
+    uint64_t heap_size;        // Size of heap bank memory in bytes
+    uint64_t heap_bank_size;   // Size of each heap bank in bytes
+    int heap_policy;           // The HEAP_POLICY_* used by the heap manager
+    bool guard_pages;          // Whether to use the guard page memory mode
+    const char* heap_trace_path; // Heap trace file path (NULL if not traced)
+    const char* aot_path;      // Translated image path (NULL if interpreted)
+    bool ext_m;                // Whether RV32M instructions are decoded
+    bool ext_zba;              // Whether Zba instructions are decoded
+    bool ext_zbb;              // Whether Zbb instructions are decoded
+    bool ext_c;                // Whether compressed instructions are decoded
+    bool ext_zicntr;           // Whether counter reads are decoded
+    bool ext_f;                // Whether floating point instrs are decoded
+    bool stats;                // Whether to print run statistics at exit
+    bool no_mem_proofs;        // Whether to skip the memory access analysis
+    uint64_t hot_loop_threshold; // Back edges before a loop is traced (0 off)
+};
+
+
+// GLOBAL OPTION VARS ...
+
+// The options selected for the current run
+extern vm_options_t options;
+
+
+// FUNCTIONS ...
+
+/* Parses the command line arguments into the global 'options' struct
+
+    * Exactly one argument not starting with OPT_PREFIX must be given,
+      which is used as the memory image binary path
+    * Options not given keep their default values
+
+    RETURNS
+    true  | On success
+    false | On unknown option, malformed value, invalid heap geometry,
+            or wrong number of paths
+*/
+extern bool parse_options(int argc, char** argv);
+
+
+// END HEADER GUARD ...
+#endif
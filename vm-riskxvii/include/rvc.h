@@ -0,0 +1,95 @@
+// Name:   Isaak Choi
+// UniKey: icho6322
+// SID:    520488399
+
+
+/* rvc.h
+
+    Contains the RV32C compressed instruction support (--ext-c).
+
+    * Every 16 bit compressed instruction has an equivalent 32 bit
+      instruction, so compressed instructions are expanded and then run by
+      the normal instruction handlers
+    * Instruction memory can't be written by the guest, so the instruction
+      at each instruction memory offset is expanded once after the memory
+      image is loaded and the fetch only has to look the expansion up
+    * While an expanded instruction runs 'instr_size' is RVC_SIZE_BYTES, so
+      the handlers advance the program counter (and save return addresses)
+      by 2 instead of 4
+
+    NOTE
+    * A compressed instruction is one whose lowest two bits are not 0b11
+    * Instructions may then start at any half word, and an instruction
+      running past the end of instruction memory is out of bounds
+    * The single precision loads and stores (c.flw, c.fsw, c.flwsp,
+      c.fswsp) expand to flw and fsw, which are only decoded with --ext-f
+    * The double precision loads and stores (c.fld, ...) and reserved
+      encodings expand to RVC_ILLEGAL_INSTR, which is not implemented.
+      So are compressed forms of instructions this vm doesn't implement
+      (c.slli, c.srli, c.srai, c.ebreak).
+
+*/
+
+
+// HEADER GUARD ...
+#ifndef RVC_H
+#define RVC_H
+
+
+// DEPENDENCIES ...
+#include <stdint.h>
+#include <stdbool.h>
+#include "system.h"
+
+
+// THIRD PARTY MEMORY LEAK DETECTOR ...
+#ifdef DEBUG_DETECT_LEAKS
+    #include "leak_detector_c.h"
+#endif
+
+
+// CONSTANTS ...
+
+// Size of a compressed instruction
+#define RVC_SIZE_BYTES      (2)
+
+// The low two bits of an instruction that is not compressed
+#define RVC_QUADRANT_MASK   (0x3)
+#define RVC_NOT_COMPRESSED  (0x3)
+
+// Expansion of encodings with no supported 32 bit equivalent - Decodes as
+// an unknown instruction
+#define RVC_ILLEGAL_INSTR   (0x00000000)
+
+
+// MACROS ...
+
+// Returns whether the instruction starting with the given byte is compressed
+#define IS_RVC_INSTR(first_byte) \
+            (((first_byte) & RVC_QUADRANT_MASK) != RVC_NOT_COMPRESSED)
+
+
+// FUNCTIONS ...
+
+/* Returns the 32 bit instruction equivalent to the given compressed
+   instruction, or RVC_ILLEGAL_INSTR if there is none
+*/
+extern uint32_t rvc_expand(const uint16_t instr);
+
+/* Expands the compressed instruction starting at every byte of instruction
+   memory - Must be called after the memory image has been loaded
+*/
+extern void rvc_predecode();
+
+/* Fetches the instruction at the program counter
+
+    * Sets 'instr_size' to the size of the fetched instruction
+    * Returns compressed instructions already expanded to 32 bits
+    * Throws a program counter out of bounds error if the instruction runs
+      past the end of instruction memory
+*/
+extern uint32_t rvc_fetch_instruction();
+
+
+// END HEADER GUARD ...
+#endif
@@ -8,7 +8,7 @@
     Contains system information for the virtual machine, including 
     types, consts, system globals, and virtual routines:
 
-    * Memory
+    * Memory (stored as an image segment and a heap bank segment)
     * Registers
     * Program counter
     * System run globals
@@ -16,10 +16,10 @@
     * Memory interface functions
 
     NOTE
-    * Uses virtual routine memory space to store system errors
-      and cpu run status information:
-      * 0x0850 - System CPU run status in form of <boolean>
-      * 0x0854 - System error status in form of <int> error code
+    * The CPU run status and system error code are kept host side in
+      'cpu_status', out of reach of the guest.
+    * Halts and errors raise a trap which longjmps straight back to the
+      CPU run loop, so the loop doesn't need to poll for them.
 
 */
 
@@ -31,9 +31,12 @@
 
 // DEPENDENCIES ...
 #include <stdio.h>
+#include <stdlib.h>
 #include <stdint.h>
 #include <stdbool.h>
-#include "heap_manager.h"
+#include <string.h>
+#include <setjmp.h>
+#include "budget.h"
 
 
 // THIRD PARTY MEMORY LEAK DETECTOR ...
@@ -48,6 +51,10 @@
 #define ERR_ILLEGAL_OPERATION  (-0x02) // Illegal operation encountered
 #define ERR_PC_OUT_OF_BOUNDS   (-0x03) // Program counter exceeded allowed bounds
 #define ERR_HOST_MALLOC_FAILED (-0x04) // Malloc request on host computer failed 
+#define ERR_INSTR_LIMIT        (-0x05) // Guest instruction limit exceeded
+#define ERR_TIME_LIMIT         (-0x06) // Wall time limit exceeded
+#define ERR_OUTPUT_LIMIT       (-0x07) // Console output byte limit exceeded
+#define ERR_INPUT_LIMIT        (-0x08) // Console input byte limit exceeded
 
 
 // SYSTEM ANATOMY CONSTANTS ...
@@ -123,71 +130,170 @@
 
 // HEAP BANKS
 
-// The size of each heap bank in bytes
-#define HEAP_BANK_SIZE (64) 
+// The default size of each heap bank in bytes
+#define DFLT_HEAP_BANK_SIZE (64) 
 
-// The number of heap banks
-#define HEAP_BANK_NUM  (128)
+// The default number of heap banks
+#define DFLT_HEAP_BANK_NUM  (128)
 
-// The size of heap bank mem in bytes
-#define HEAP_MEM_SIZE  (HEAP_BANK_SIZE * HEAP_BANK_NUM)
+// The default size of heap bank mem in bytes
+#define DFLT_HEAP_MEM_SIZE  (DFLT_HEAP_BANK_SIZE * DFLT_HEAP_BANK_NUM)
+
+// The largest heap bank mem that can be selected in bytes
+//  Keeps every heap address (and field end) a positive int32_t
+#define MAX_HEAP_MEM_SIZE   (0x40000000)
 
 // The starting address of heap banks
 #define HEAP_MEM_START (0xb700)
 
 // The end address (inclusive) of heap banks
-#define HEAP_MEM_END   (HEAP_MEM_START + HEAP_MEM_SIZE - 0x01)
+#define HEAP_MEM_END   (heap_geometry.mem_end)
 
 // OTHER MEMORY RELATED CONSTS
 
 // The location at which memory indexing starts
 #define MEM_START_ADDR (0x0000)
 
-// The total size of the memory in bytes
-#define MEM_SIZE_BYTES (HEAP_MEM_END + 0x01)
-
 // The size of the input memory image binary file in bytes
 #define MEM_IMG_BIN_FILE_SIZE (INST_MEM_SIZE + DATA_MEM_SIZE)
 
+// MEMORY SEGMENTS
+ // NOTE
+ // Only the memory image and heap banks are stored. Virtual routine
+ // addresses and the gap before the heap banks are never backed by memory.
+
+// The offset of the heap bank segment within stored memory
+#define HEAP_SEG_OFFSET (MEM_IMG_BIN_FILE_SIZE)
+
+// The total size of stored memory in bytes
+#define MEM_SIZE_BYTES  (HEAP_SEG_OFFSET + heap_geometry.mem_size)
+
 // The lower bound (inclusive) of readable memory
 #define MEM_READABLE_LOWER_BOUND (0x0000)
 
 
 // UNIVERSAL VIRTUAL ROUTINE CONSTANTS ...
-#define VR_WRITE_CHAR_ADDR       (0x0800) // Console Write Character
-#define VR_WRITE_INT_ADDR        (0x0804) // Console Write Signed Integer
-#define VR_WRITE_UINT_ADDR       (0x0808) // Console Write Unsigned Integer
-#define VR_HALT_ADDR             (0x080C) // Halt
-#define VR_READ_CHAR_ADDR        (0x0812) // Console Read Character
-#define VR_READ_INT_ADDR         (0x0816) // Console Read Signed Integer
-#define VR_DUMP_PC_ADDR          (0x0820) // Dump PC
-#define VR_DUMP_REG_ADDR         (0x0824) // Dump Register Banks
-#define VR_DUMP_MEM_WORD_ADDR    (0x0828) // Dump Memory Word
-#define VR_HEAP_BANK_MALLOC_ADDR (0x0830) // Heap Bank - Malloc
-#define VR_HEAP_BANK_FREE_ADDR   (0x0834) // Heap Bank - Free
-
-
-// CUSTOM VIRTUAL ROUTINE CONSTANTS ...
-#define VR_CPU_RUN_ADDR          (0x0850) // Stores whether the vm CPU runs
-#define VR_SYS_ERR_ADDR          (0x0854) // Stores the vm system error code
-#define VR_HEAP_MANAGER_ADDR     (0x0858) // Stores a ptr to the heap manager
-#define VR_HEAP_MANAGER_RESERVED (0x085C) // Reserved for manager addr overflow
+#define VR_WRITE_CHAR_ADDR        (0x0800) // Console Write Character
+#define VR_WRITE_INT_ADDR         (0x0804) // Console Write Signed Integer
+#define VR_WRITE_UINT_ADDR        (0x0808) // Console Write Unsigned Integer
+#define VR_HALT_ADDR              (0x080C) // Halt
+#define VR_READ_CHAR_ADDR         (0x0812) // Console Read Character
+#define VR_READ_INT_ADDR          (0x0816) // Console Read Signed Integer
+#define VR_DUMP_PC_ADDR           (0x0820) // Dump PC
+#define VR_DUMP_REG_ADDR          (0x0824) // Dump Register Banks
+#define VR_DUMP_MEM_WORD_ADDR     (0x0828) // Dump Memory Word
+#define VR_HEAP_BANK_MALLOC_ADDR  (0x0830) // Heap Bank - Malloc
+#define VR_HEAP_BANK_FREE_ADDR    (0x0834) // Heap Bank - Free
+#define VR_HEAP_BANK_CALLOC_ADDR  (0x0838) // Heap Bank - Calloc
+#define VR_HEAP_BANK_REALLOC_ADDR (0x083C) // Heap Bank - Realloc
+#define VR_MEMCPY_ADDR            (0x0840) // Bulk Memory - Copy
+#define VR_MEMSET_ADDR            (0x0844) // Bulk Memory - Set
+#define VR_MEMCMP_ADDR            (0x0848) // Bulk Memory - Compare
+#define VR_WRITE_BUF_ADDR         (0x084C) // Console Write Buffer
+#define VR_WRITE_STR_ADDR         (0x0850) // Console Write String
+#define VR_READ_BUF_ADDR          (0x0854) // Console Read Buffer
+#define VR_READ_LINE_ADDR         (0x0858) // Console Read Line
+#define VR_VECTOR_RUN_ADDR        (0x085C) // Vector Unit - Run (vector_unit.h)
+
+// The register virtual routines save their results in
+#define VR_RESULT_REGISTER        (28)
+
+// The number of virtual routine table slots - One per word of virtual mem
+#define VR_TABLE_SIZE (VIRT_MEM_SIZE / WORD_SIZE)
+
+// The virtual routine table slot of the given virtual mem address
+#define VR_SLOT(addr) (((addr) - VIRT_MEM_START) / WORD_SIZE)
 
 
 // TYPEDEFS FOR READABILITY AND MAINTAINABILITY ...
 typedef unsigned char byte;
 
+// Defined in heap_manager.h, which itself depends on the constants above
+typedef struct heap_manager_t heap_manager_t;
+
+
+// HEAP GEOMETRY ...
+
+// Size and number of heap banks - Chosen at startup
+typedef struct heap_geometry_t heap_geometry_t;
+struct heap_geometry_t {
+    int32_t bank_size; // The size of each heap bank in bytes
+    int32_t bank_num;  // The number of heap banks
+    int32_t mem_size;  // The size of heap bank mem in bytes
+    int32_t mem_end;   // The end address (inclusive) of heap banks
+};
+
+
+// VIRTUAL ROUTINE TABLES ...
+
+// Called on a store to a virtual routine address with the data stored
+typedef void (*vr_write_handler_t)(const void* const src_ptr);
+
+// Called on a load from a virtual routine address with where to load to
+typedef void (*vr_read_handler_t)(void* const dst_ptr);
+
+// A virtual routine triggered by stores - Only called for an exact address
+typedef struct vr_write_entry_t vr_write_entry_t;
+struct vr_write_entry_t {
+    int32_t addr;               // 0 if the slot is unused
+    vr_write_handler_t handler;
+};
+
+// A virtual routine triggered by loads - Only called for an exact address
+typedef struct vr_read_entry_t vr_read_entry_t;
+struct vr_read_entry_t {
+    int32_t addr;               // 0 if the slot is unused
+    vr_read_handler_t handler;
+};
+
+
+// HOST SIDE CPU STATUS ...
+
+// Run status, error code, and trap handler of the simulated CPU
+typedef struct cpu_status_t cpu_status_t;
+struct cpu_status_t {
+    bool running;     // Whether the CPU is/should run
+    int32_t err;      // The system error code - Non zero denotes an error
+    bool trap_armed;  // Whether 'trap_env' has been set by the run loop
+    jmp_buf trap_env; // Where raised traps jump back to
+};
+
 
 // GLOBAL SYSTEM VARS ...
 
 // The program counter
 extern int32_t pc;
 
+// Size in bytes of the instruction at the program counter - Only differs
+//  from DFLT_PC_INCREMENT for compressed instructions (see rvc.h)
+extern int32_t instr_size;
+
 // Stores register data, with each index being a unique register
 extern int32_t registers[NUM_REGISTERS];
 
-// The main system memory
-extern byte memory[MEM_SIZE_BYTES];
+// Stores floating point register data as raw single precision bits, with
+//  each index being a unique register (--ext-f, see instructions.h)
+extern uint32_t fregisters[NUM_REGISTERS];
+
+// The floating point control and status register - The rounding mode 'frm'
+//  in bits 7:5 and the accrued exception flags 'fflags' in bits 4:0
+extern uint32_t fcsr;
+
+// The main system memory - MEM_SIZE_BYTES long, allocated by system_init()
+//  Starts with the memory image segment, indexed directly by vm address
+extern byte* memory;
+
+// The heap bank segment of memory, indexed by (vm address - HEAP_MEM_START)
+extern byte* heap_memory;
+
+// The heap bank geometry of the current run
+extern heap_geometry_t heap_geometry;
+
+// The run status, error code, and trap handler of the CPU
+extern cpu_status_t cpu_status;
+
+// Manages allocation of the heap banks - Holds all of its own storage
+extern heap_manager_t heap_manager;
 
 
 // SYSTEM SUB-OPERATION FUNCTIONS ...
@@ -211,28 +317,37 @@ extern int32_t sign_extend_int32(int32_t num, int curr_len_bits,
 
 // ERROR CALL ABSTRACTIONS ...
 
+/* Raises a trap, stopping the simulated CPU
+
+    * Saves the given error code (ERR_NO_ERR for a requested halt)
+    * Jumps straight back to the CPU run loop if it has armed the trap 
+      handler, otherwise returns so the caller can report the error
+
+*/
+extern void raise_trap(const int32_t err);
+
 /* Throws the error required when an unknown instruction is encountered
 
-    * Sets appropriate error code
     * Prints error identifier text, the instruction in hex, and a register dump
       to stdout.
+    * Raises a trap with the appropriate error code
 
 */
 extern void throw_not_implemented_err();
 
 /* Throws the error required when an illegal operation is encountered
 
-    * Sets appropriate error code
     * Prints error identifier text, the instruction in hex, and a register dump
       to stdout.
+    * Raises a trap with the appropriate error code
 
 */
 extern void throw_illegal_operation_err();
 
 /* Throws the error required when an the program counter exceeds allowed bounds
 
-    * Sets appropriate error code
     * Prints error identifier text and a register dump to stdout
+    * Raises a trap with the appropriate error code
 
 */
 extern void throw_pc_out_of_bounds_err();
@@ -246,13 +361,22 @@ extern void throw_pc_out_of_bounds_err();
 */
 extern void throw_host_malloc_failed_err();
 
+/* Throws the error required when an execution limit is exceeded
+
+    * Prints the name of the exceeded limit and a register dump to stdout
+    * Raises a trap with the given error code (one of the ERR_*_LIMIT codes)
+
+*/
+extern void throw_limit_exceeded_err(const int32_t err);
+
 
 // SYSTEM INTERFACE FUNCTIONS ...
 
 /* Performs a register dump to stdout
     Prints the value pc followed by the value of registers 0 to NUM_REGISTERS
+    Returns the number of bytes printed
 */
-extern void register_dump();
+extern int register_dump();
 
 /* Sets the CPU run status for the system
     Setting to false will cause the simulated CPU to stop running
@@ -276,10 +400,18 @@ extern int32_t get_system_error_code();
 
 /* Retrieves the current instruction
     Returns the current instruction, pointed to by the program counter, 
-    as a uint32_t.
+    as a uint32_t. Compressed instructions are returned unexpanded.
 */
 extern uint32_t get_instruction();
 
+/* Translates the given vm address to a host pointer into stored memory
+
+    RETURNS
+    Host pointer | If the address is within the memory image or heap banks
+    NULL         | If the address is not backed by stored memory
+*/
+extern byte* translate_addr(const int32_t addr);
+
 
 // VIRTUAL ROUTINES ...
 
@@ -287,46 +419,47 @@ extern uint32_t get_instruction();
     Prints the value at the given location as a single ASCII 
     encoded character to stdout
 */
-void vr_write_char(const char* const char_src_ptr);
+void vr_write_char(const void* const src_ptr);
 
 /* Console Write Int
     Prints the value at the given location as a single signed integer to stdout
 */
-void vr_write_int(const int32_t* const int_src);
+void vr_write_int(const void* const src_ptr);
 
 /* Console Write Unsigned Int
     Prints the value at the given location as a single 
     unsigned integer to stdout
 */
-void vr_write_uint(const uint32_t* const uint_src);
+void vr_write_uint(const void* const src_ptr);
 
 /* Halt
-    Prints CPU halt message to stdout and stops the simulated CPU
+    Prints CPU halt message to stdout and stops the simulated CPU by 
+    raising a trap with no error
 */
-void vr_halt();
+void vr_halt(const void* const src_ptr);
 
 /* Console Read Character
     Reads a single char from stdin and stores as a single ASCII encoded char
     at the given location
 */
-void vr_read_char(const void* const dst_ptr);
+void vr_read_char(void* const dst_ptr);
 
 /* Console Read Signed Integer
     Reads a single signed int from stdin and stores as an int32 
     at the given location
 */
-void vr_read_int(const void* const dst_ptr);
+void vr_read_int(void* const dst_ptr);
 
 /* Dump PC
     Prints the value of the program counter to stdout
 */
-void vr_dump_pc();
+void vr_dump_pc(const void* const src_ptr);
 
 /* Dump Register Banks
     Invokes the register_dump() method, printing the values of 
     the PC and all registers to stdout
 */
-void vr_dump_registers();
+void vr_dump_registers(const void* const src_ptr);
 
 /* Dump Memory Word
     Prints the value (4 bytes interpreted in little endian) 
@@ -348,6 +481,115 @@ void vr_malloc(const void* src_ptr);
 */
 void vr_free(const void* src_ptr);
 
+/* Calloc
+    * Attempts to malloc() the given ammount of bytes in virtual machine memory
+      and zeroes them
+    * Saves the address of allocated memory chunk in R[28]
+    * Saves NULL in R[28] if calloc failed
+*/
+void vr_calloc(const void* src_ptr);
+
+/* Realloc
+    * Attempts to realloc() malloc'd memory - The value written is the
+      address of a descriptor in vm memory of two int32_t words:
+      { address of the memory to resize (or NULL), new size in bytes }
+    * Saves the address of the resized memory chunk in R[28]
+    * Saves NULL in R[28] if realloc failed, leaving the memory untouched
+    * Throws illegal operation error if the descriptor can't be read, or the
+      memory hasn't been allocated or is out of allowed bounds
+*/
+void vr_realloc(const void* src_ptr);
+
+/* Memory Copy
+    * Copies len bytes from src to dst - The value written is the address of
+      a descriptor in vm memory of three int32_t words: { dst, src, len }
+    * Overlapping fields are copied as if through a temporary buffer
+    * Each field is validated once as a whole, then copied by the host
+    * Throws illegal operation error if len < 0, or any byte of src can't
+      be read or any byte of dst can't be written
+*/
+void vr_memcpy(const void* src_ptr);
+
+/* Memory Set
+    * Sets len bytes at dst to the low byte of value - The value written is
+      the address of a descriptor in vm memory of three int32_t words:
+      { dst, value, len }
+    * Throws illegal operation error if len < 0, or any byte of dst can't be
+      written
+*/
+void vr_memset(const void* src_ptr);
+
+/* Memory Compare
+    * Compares len bytes at a and b - The value written is the address of a
+      descriptor in vm memory of three int32_t words: { a, b, len }
+    * Saves -1, 0, or 1 in R[28] as the first differing byte (unsigned) of
+      a is less than, (none) equal to, or greater than that of b
+    * Throws illegal operation error if len < 0, or any byte of a or b
+      can't be read
+*/
+void vr_memcmp(const void* src_ptr);
+
+/* Console Write Buffer
+    * Writes len bytes from buf to stdout - The value written is the address
+      of a descriptor in vm memory of two int32_t words: { buf, len }
+    * The field is validated once as a whole, then written by the host
+    * Throws illegal operation error if len < 0, or any byte of buf can't be
+      read
+*/
+void vr_write_buf(const void* src_ptr);
+
+/* Console Write String
+    * Writes the NUL terminated string at the given address to stdout
+    * Throws illegal operation error if the string runs (before its NUL)
+      into memory that can't be read
+*/
+void vr_write_str(const void* src_ptr);
+
+/* Console Read Buffer
+    * Reads up to n bytes from stdin into buf - The value written is the
+      address of a descriptor in vm memory of two int32_t words: { buf, n }
+    * Saves the number of bytes read in R[28] (less than n only at the end
+      of stdin)
+    * The whole of buf is validated once before anything is read
+    * Throws illegal operation error if n < 0, or any of the n bytes at buf
+      can't be written
+*/
+void vr_read_buf(const void* src_ptr);
+
+/* Console Read Line
+    * As Console Read Buffer, but also stops after the first newline, which
+      is kept in buf (no NUL is added)
+    * Saves the number of bytes read in R[28] (0 only at the end of stdin)
+*/
+void vr_read_line(const void* src_ptr);
+
+
+// VIRTUAL ROUTINE REGISTRY ...
+
+/* Registers a virtual routine called on stores to the given address
+    * Replaces any routine already registered at the address
+    * A NULL handler removes the routine at the address
+
+    RETURNS
+    true  | On success
+    false | If the address is outside virtual mem, or its table slot holds
+            a routine at another address
+*/
+extern bool register_vr_write(const int32_t addr,
+                              const vr_write_handler_t handler);
+
+/* Registers a virtual routine called on loads from the given address
+    * Replaces any routine already registered at the address
+    * A NULL handler removes the routine at the address
+
+    RETURNS
+    true  | On success
+    false | If the address is outside virtual mem, or its table slot holds
+            a routine at another address
+*/
+extern bool register_vr_read(const int32_t addr,
+                             const vr_read_handler_t handler);
+
 
 // MEMORY INTERFACE FUNCTIONS ...
 
@@ -365,6 +607,19 @@ void vr_free(const void* src_ptr);
 */
 extern void mem_write(const void* const src_ptr, const int32_t dst_addr, const int data_size);
 
+/* Handle write to memory request known not to be a virtual routine call
+
+    * Verifies memory destination integrity
+    * Performs write if necessary
+
+    PARAMS
+    src_ptr   | Pointer to the data source to be copied
+    dst_addr  | Destination address in vm memory space
+    data_size | The size of the data to be copied (in bytes)
+
+*/
+extern void mem_write_memory(const void* const src_ptr, const int32_t dst_addr, const int data_size);
+
 /* Handle read from memory request
 
     * Checks for virtual routine calls
@@ -379,13 +634,47 @@ extern void mem_write(const void* const src_ptr, const int32_t dst_addr, const i
 */
 extern void mem_read(void* const dst_ptr, const int32_t src_addr, const int data_size);
 
+/* Handle read from memory request known not to be a virtual routine call
+
+    * Verifies memory source integrity
+    * Performs read if necessary
+
+    PARAMS
+    dst_ptr   | Pointer to the memory that should be overwritten with read data
+    src_addr  | Source address in vm memory space
+    data_size | The size of the data to be read in bytes
+
+*/
+extern void mem_read_memory(void* const dst_ptr, const int32_t src_addr, const int data_size);
+
+/* Reads the given number of int32_t words of a virtual routine descriptor
+    from vm memory at the given address into 'args'
+    Throws illegal operation error if the descriptor is within virtual
+    routine memory, or can't be read
+*/
+extern void read_vr_descriptor(const int32_t addr, int32_t* const args,
+                               const int num);
+
+/* Translates a whole field of vm memory to host memory for a bulk memory
+    virtual routine
+    Throws illegal operation error if any byte of the field can't be read
+    (or written if 'write' is set), exactly as a load / store of it would
+
+    RETURNS
+    Host pointer to the start of the field | If every byte is accessible
+*/
+extern byte* translate_field(const int32_t addr, const int32_t size,
+                             const bool write);
+
 
 // SYSTEM INITIALISER ...
 
 /* Initialises the system
     Initialises, allocates, and links required system vars and methods
+    * Memory and the heap manager are sized by the heap geometry options
+    * Sets the system error code on host malloc failure
 */
-extern void system_init();
+extern void system_init(const vm_options_t* const opts);
 
 /* Deinitialises the system
     Deallocates any malloc'd memory used for the system so that 
@@ -0,0 +1,97 @@
+// Name:   Isaak Choi
+// UniKey: icho6322
+// SID:    520488399
+
+
+/* vector_unit.h
+
+    Contains the vector unit - A coprocessor in virtual routine memory that
+    runs one operation over whole arrays of vm memory per guest store.
+
+    * The guest stores the address of a descriptor to VR_VECTOR_RUN_ADDR.
+      The descriptor is six int32_t words in vm memory:
+        { op, width, src1, src2, dst, len }
+      op              | One of the VEC_OP_* operations
+      width           | Size in bytes of each (signed int) element - 1, 2, 4
+      src1, src2, dst | Addresses of the arrays, each len elements long
+      len             | The number of elements
+    * Each array is validated once as a whole, then the operation runs on
+      the host with SIMD kernels (AVX2 when the host has it, otherwise the
+      host's baseline, SSE2 on x86-64) and a scalar loop for the elements
+      left over
+    * Arithmetic wraps at the element width, as the scalar instructions do
+
+    OPERATIONS
+    VEC_OP_ADD        | dst[i] = src1[i] + src2[i]
+    VEC_OP_MUL        | dst[i] = src1[i] * src2[i] (low bits)
+    VEC_OP_MIN        | dst[i] = min(src1[i], src2[i])
+    VEC_OP_MAX        | dst[i] = max(src1[i], src2[i])
+    VEC_OP_DOT        | R[28] = the sum of src1[i] * src2[i], wrapping at 32
+                        bits (dst isn't used)
+    VEC_OP_PREFIX_SUM | dst[i] = src1[0] + ... + src1[i] (src2 isn't used)
+
+    NOTE
+    * Throws illegal operation error for an unknown op or width, len < 0,
+      an array that can't be read (src1, src2) or written (dst), or a dst
+      that partly overlaps a source - dst may be exactly a source
+    * Arrays an operation doesn't use aren't validated
+
+*/
+
+
+// HEADER GUARD ...
+#ifndef VECTOR_UNIT_H
+#define VECTOR_UNIT_H
+
+
+// DEPENDENCIES ...
+#include <stdint.h>
+#include <stdbool.h>
+#include "system.h"
+
+
+// THIRD PARTY MEMORY LEAK DETECTOR ...
+#ifdef DEBUG_DETECT_LEAKS
+    #include "leak_detector_c.h"
+#endif
+
+
+// CONSTANTS ...
+
+// Operations - The elementwise ones (VEC_OP_ADD to VEC_OP_MAX) come first
+#define VEC_OP_ADD          (0)
+#define VEC_OP_MUL          (1)
+#define VEC_OP_MIN          (2)
+#define VEC_OP_MAX          (3)
+#define VEC_OP_DOT          (4)
+#define VEC_OP_PREFIX_SUM   (5)
+
+// The number of elementwise operations
+#define VEC_NUM_MAP_OPS     (VEC_OP_MAX + 1)
+
+// Word index of each field of a descriptor
+#define VEC_DESC_OP         (0)
+#define VEC_DESC_WIDTH      (1)
+#define VEC_DESC_SRC1       (2)
+#define VEC_DESC_SRC2       (3)
+#define VEC_DESC_DST        (4)
+#define VEC_DESC_LEN        (5)
+#define VEC_DESC_WORDS      (6)
+
+
+// FUNCTIONS ...
+
+/* Vector Unit - Run
+    * Runs the operation of the descriptor at the given address (see the
+      top of vector_unit.h)
+*/
+extern void vr_vector_run(const void* src_ptr);
+
+/* Picks the SIMD kernels for the host and registers vr_vector_run() at
+   VR_VECTOR_RUN_ADDR
+*/
+extern void vector_unit_init();
+
+
+// END HEADER GUARD ...
+#endif
@@ -25,6 +25,15 @@
 #include "system.h"
 #include "utils.h"
 #include "heap_manager.h"
+#include "options.h"
+#include "budget.h"
+#include "guard_pages.h"
+#include "heap_trace.h"
+#include "rvc.h"
+#include "vector_unit.h"
+#include "aot.h"
+#include "hot_loops.h"
+#include "mem_proofs.h"
 
 
 // THIRD PARTY MEMORY LEAK DETECTOR ...
@@ -39,11 +48,7 @@
 #define ERR_COULDNT_CLOSE    (-0x13) // Couldn't close mem img binary fstream
 #define ERR_INVALID_BIN_SIZE (-0x14) // Invalid memory image binary size
 #define ERR_READING_FILE     (-0x15) // Read from file failed or invalid
-
-
-// OTHER ...
-#define REQUIRED_ARG_NUM (2) // Num of args required when running the program
-#define BIN_SRC_ARG_INDX (1) // Index of the binary file path in the args array
+#define ERR_AOT_LOAD         (-0x16) // Couldn't load translated image
 
 
 // END HEADER GUARD ...
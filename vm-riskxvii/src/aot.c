@@ -0,0 +1,102 @@
+// Name:   Isaak Choi
+// UniKey: icho6322
+// SID:    520488399
+
+
+/* aot.c
+
+    Contains the loader for ahead of time translated memory images
+    (see aot.h).
+
+*/
+
+
+// DEPENDENCIES ...
+#include "aot.h"
+#include <dlfcn.h>
+#include "instructions.h"
+#include "options.h"
+#include "budget.h"
+#include "guard_pages.h"
+
+
+// GLOBAL AOT VARS ...
+
+// No block anywhere - Used while no image is loaded
+static const aot_block_t no_blocks[INST_MEM_SIZE];
+
+// The translated block starting at each instruction memory address, or
+//  NULL where the interpreter runs - All NULL unless an image is loaded
+const aot_block_t* aot_blocks = no_blocks;
+
+// The vm interface handed to translated blocks - Set up by aot_load()
+aot_host_t aot_host;
+
+// Handle of the loaded shared object (NULL if none)
+static void* aot_handle = NULL;
+
+
+// FUNCTIONS ...
+
+/* Returns the FNV-1a hash of the given instruction memory
+   (INST_MEM_SIZE bytes)
+*/
+uint32_t aot_hash(const byte* const inst_mem) {
+    uint32_t hash = AOT_HASH_BASIS;
+    for (int i = 0; i < INST_MEM_SIZE; i++) {
+        hash = (hash ^ inst_mem[i]) * AOT_HASH_PRIME;
+    }
+    return hash;
+}
+
+/* Loads the translated memory image in the shared object at the given path
+
+    * Must be called after the memory image has been read into memory
+    * Picks the translation for the current options (--ext-c, and direct
+      data memory access unless --guard-pages)
+
+    RETURNS
+    true  | On success
+    false | If the shared object couldn't be loaded, isn't a translated
+            image, was built for another interface version, or was
+            translated from a different memory image
+*/
+bool aot_load(const char* const path) {
+
+    // Find the image
+    aot_handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    if (aot_handle == NULL) {
+        return false;
+    }
+    const aot_image_t* const image = dlsym(aot_handle, AOT_IMAGE_SYMBOL);
+    if (image == NULL || image->abi_version != AOT_ABI_VERSION ||
+        image->inst_mem_hash != aot_hash(&memory[INST_MEM_START])) {
+        aot_unload();
+        return false;
+    }
+
+    // Hand over the vm - Data memory is only read and written directly
+    // when it isn't behind guard pages
+    aot_host = (aot_host_t){
+        .registers = registers,
+        .pc = &pc,
+        .instr_size = &instr_size,
+        .block_compressed = &budget.block_compressed,
+        .memory = guard_pages.enabled ? NULL : memory,
+        .mem_read = mem_read,
+        .mem_write = mem_write,
+        .exec_instruction = exec_instruction,
+        .end_basic_block = end_basic_block,
+    };
+    aot_blocks = options.ext_c ? image->rvc_blocks : image->blocks;
+    return true;
+}
+
+/* Unloads any loaded translated image */
+void aot_unload() {
+    aot_blocks = no_blocks;
+    if (aot_handle != NULL) {
+        dlclose(aot_handle);
+        aot_handle = NULL;
+    }
+}
@@ -0,0 +1,184 @@
+// Name:   Isaak Choi
+// UniKey: icho6322
+// SID:    520488399
+
+
+/* budget.c
+
+    Contains the execution budget checks performed at the end of each
+    basic block.
+
+*/
+
+
+// Required for clock_gettime() under -std=c11
+#define _POSIX_C_SOURCE 199309L
+
+
+// INCLUDE HEADER ...
+#include "budget.h"
+
+#include <time.h>
+#include "system.h"
+#include "instructions.h"
+#include "rvc.h"
+
+
+// GLOBAL BUDGET VARS ...
+
+// The execution budget for the current run
+budget_t budget;
+
+
+// HELPERS ...
+
+/* Returns the current monotonic time in milliseconds */
+static uint64_t monotonic_ms() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000 + (uint64_t)now.tv_nsec / 1000000;
+}
+
+/* Returns the current monotonic time in microseconds */
+static uint64_t monotonic_us() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000 + (uint64_t)now.tv_nsec / 1000;
+}
+
+/* Returns the number of instructions in the current block before 'addr'
+
+    Each compressed instruction is counted as if it were full size - If the
+    instruction at 'addr' is itself compressed, its extra half is dropped
+    by the integer division
+*/
+static uint32_t block_instr_count(const int32_t addr) {
+    return ((uint32_t)(addr - budget.block_start) +
+            budget.block_compressed * (INST_SIZE_BYTES - RVC_SIZE_BYTES)) /
+           INST_SIZE_BYTES;
+}
+
+/* Converts an option limit to a budget limit
+    OPT_UNLIMITED becomes UINT64_MAX so that it can never be exceeded
+*/
+static uint64_t to_limit(const uint64_t opt_limit) {
+    return (opt_limit == OPT_UNLIMITED) ? UINT64_MAX : opt_limit;
+}
+
+
+// FUNCTIONS ...
+
+/* Initialises the execution budget from the given options
+    Zeroes all usage counters and starts the wall time clock
+*/
+void budget_init(const vm_options_t* const opts) {
+
+    // Zero usage
+    budget.instr_retired = 0;
+    budget.output_bytes = 0;
+    budget.input_bytes = 0;
+    budget.block_start = pc;
+    budget.block_compressed = 0;
+    budget.blocks_ended = 0;
+    budget.start_us = monotonic_us();
+
+    // Set limits
+    budget.max_instr = to_limit(opts->max_instr);
+    budget.max_output_bytes = to_limit(opts->max_output_bytes);
+    budget.max_input_bytes = to_limit(opts->max_input_bytes);
+
+    // Start the clock - Never checked if there is no time limit
+    budget.deadline_ms = UINT64_MAX;
+    budget.time_check_countdown = UINT32_MAX;
+    if (opts->max_time_ms != OPT_UNLIMITED) {
+        budget.deadline_ms = monotonic_ms() + opts->max_time_ms;
+        budget.time_check_countdown = BUDGET_TIME_CHECK_INTERVAL;
+    }
+}
+
+/* Ends the current basic block
+
+    * Adds the instructions of the block ending at 'branch_pc' to the
+      retired instruction count
+    * Starts the next block at the current program counter
+    * Throws a limit exceeded error if any limit has been passed
+
+    Must be called after the program counter has been updated.
+*/
+void end_basic_block(const int32_t branch_pc) {
+
+    // Count the instructions of the finished block (including the branch)
+    budget.instr_retired += block_instr_count(branch_pc) + 1;
+    budget.block_start = pc;
+    budget.block_compressed = 0;
+    budget.blocks_ended++;
+
+    // Check limits
+    if (budget.instr_retired > budget.max_instr) {
+        throw_limit_exceeded_err(ERR_INSTR_LIMIT);
+    }
+    else if (budget.output_bytes > budget.max_output_bytes) {
+        throw_limit_exceeded_err(ERR_OUTPUT_LIMIT);
+    }
+    else if (budget.input_bytes > budget.max_input_bytes) {
+        throw_limit_exceeded_err(ERR_INPUT_LIMIT);
+    }
+
+    // Check wall time every BUDGET_TIME_CHECK_INTERVAL blocks
+    else if (--budget.time_check_countdown == 0) {
+        budget.time_check_countdown = BUDGET_TIME_CHECK_INTERVAL;
+        if (monotonic_ms() >= budget.deadline_ms) {
+            throw_limit_exceeded_err(ERR_TIME_LIMIT);
+        }
+    }
+}
+
+/* Ends the current basic block as end_basic_block() does, unless that would
+   throw a limit exceeded error or check the wall time
+
+    * Lets callers holding guest registers outside the vm (see hot_loops.h)
+      only write them back when a limit may be hit
+
+    RETURNS
+    true  | The block was ended
+    false | Nothing was changed - The caller must call end_basic_block()
+*/
+bool try_end_basic_block(const int32_t branch_pc) {
+
+    // Leave anything that may throw to end_basic_block()
+    const uint64_t retired = budget.instr_retired +
+                             block_instr_count(branch_pc) + 1;
+    if (retired > budget.max_instr ||
+        budget.output_bytes > budget.max_output_bytes ||
+        budget.input_bytes > budget.max_input_bytes ||
+        budget.time_check_countdown == 1) {
+        return false;
+    }
+
+    // End the block
+    budget.instr_retired = retired;
+    budget.block_start = pc;
+    budget.block_compressed = 0;
+    budget.blocks_ended++;
+    budget.time_check_countdown--;
+    return true;
+}
+
+/* Returns the number of guest instructions retired before the current one
+    Includes the instructions of the current block before the program counter
+*/
+uint64_t budget_instr_count() {
+    return budget.instr_retired + block_instr_count(pc);
+}
+
+/* Returns the deterministic cycle estimate for the instructions counted by
+   budget_instr_count() (see BUDGET_BLOCK_END_CYCLES)
+*/
+uint64_t budget_cycle_count() {
+    return budget_instr_count() + budget.blocks_ended * BUDGET_BLOCK_END_CYCLES;
+}
+
+/* Returns the wall time in microseconds since the budget was initialised */
+uint64_t budget_time_us() {
+    return monotonic_us() - budget.start_us;
+}
@@ -0,0 +1,213 @@
+// Name:   Isaak Choi
+// UniKey: icho6322
+// SID:    520488399
+
+
+/* guard_pages.c
+
+    Contains the host mappings and SIGSEGV handler of the guard page
+    memory mode.
+
+*/
+
+
+// Required for memfd_create(), mmap() flags, and sigaction()
+#define _GNU_SOURCE
+
+
+// INCLUDE HEADER ...
+#include "guard_pages.h"
+
+#include <string.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+
+// GLOBAL GUARD PAGE VARS ...
+
+// The guard page mappings for the current run
+guard_pages_t guard_pages;
+
+
+// HELPERS ...
+
+/* Returns whether the given host address is within the given guard window */
+static bool is_in_window(const byte* const addr, const byte* const window) {
+    return (window != NULL && addr >= window &&
+            addr < window + guard_pages.window_size);
+}
+
+/* SIGSEGV handler
+    Raises an illegal operation error for faults within the guard windows.
+    Any other fault is a host bug, so the default handler is restored and
+    the faulting access is left to fault again.
+*/
+static void guard_fault_handler(int sig, siginfo_t* info, void* context) {
+
+    // Unused
+    (void)context;
+
+    // Not a guest access
+    const byte* const addr = (const byte*)info->si_addr;
+    if (!is_in_window(addr, guard_pages.read_window) &&
+        !is_in_window(addr, guard_pages.write_window)) {
+        signal(sig, SIG_DFL);
+        return;
+    }
+
+    // Guest access out of bounds - Longjmps back to the CPU run loop
+    throw_illegal_operation_err();
+}
+
+/* Reserves a PROT_NONE guard window and maps the image page at its start
+
+    RETURNS
+    Start of the window | On success
+    NULL                | On failure
+*/
+static byte* map_guard_window(const int fd) {
+
+    // Reserve the window - No host memory is committed for PROT_NONE pages
+    byte* const window = mmap(NULL, guard_pages.window_size, PROT_NONE,
+                              MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+                              -1, 0);
+    if (window == MAP_FAILED) {
+        return NULL;
+    }
+
+    // Share the image page at the start of the window
+    if (mmap(window, guard_pages.page_size, PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+        munmap(window, guard_pages.window_size);
+        return NULL;
+    }
+    return window;
+}
+
+
+// FUNCTIONS ...
+
+/* Reserves the guard windows, maps the memory image page into them, and
+    installs the SIGSEGV handler
+
+    * The read view stays writable until guard_pages_seal() so that the
+      memory image can be loaded through it
+
+    RETURNS
+    true  | On success
+    false | If the host could not create the mappings or handler
+*/
+bool guard_pages_init() {
+
+    // Window sizes - The image must fit in a single host page
+    guard_pages.page_size = (size_t)sysconf(_SC_PAGESIZE);
+    guard_pages.window_size = GUARD_WINDOW_SPAN + guard_pages.page_size;
+    if (guard_pages.page_size < MEM_IMG_BIN_FILE_SIZE) {
+        return false;
+    }
+
+    // Create the (zeroed) image page and map it into both windows
+    const int fd = memfd_create("vm_riskxvii_image", 0);
+    if (fd < 0) {
+        return false;
+    }
+    if (ftruncate(fd, guard_pages.page_size) != 0) {
+        close(fd);
+        return false;
+    }
+    guard_pages.read_window = map_guard_window(fd);
+    guard_pages.write_window = map_guard_window(fd);
+    close(fd);
+    if (guard_pages.read_window == NULL || guard_pages.write_window == NULL) {
+        guard_pages_deinit();
+        return false;
+    }
+
+    // Both views end their legal addresses (the end of data memory) at the
+    // end of the page, so the image sits at the same offset in each
+    const size_t image_offset = guard_pages.page_size - MEM_IMG_BIN_FILE_SIZE;
+    guard_pages.read_base = guard_pages.read_window + image_offset;
+    guard_pages.write_base = guard_pages.write_window + image_offset
+                             + DATA_MEM_START;
+
+    // Install fault handler - SA_NODEFER as the handler never returns
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_sigaction = &guard_fault_handler;
+    action.sa_flags = SA_SIGINFO | SA_NODEFER;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGSEGV, &action, NULL) != 0) {
+        guard_pages_deinit();
+        return false;
+    }
+
+    guard_pages.enabled = true;
+    return true;
+}
+
+/* Makes the read view read only - Call once the memory image is loaded */
+void guard_pages_seal() {
+    mprotect(guard_pages.read_window, guard_pages.page_size, PROT_READ);
+}
+
+/* Unmaps the guard windows and restores the default SIGSEGV handler */
+void guard_pages_deinit() {
+
+    // Restore handler first so a stray access can't be mistaken for a guest's
+    signal(SIGSEGV, SIG_DFL);
+
+    // Unmap windows
+    if (guard_pages.read_window != NULL) {
+        munmap(guard_pages.read_window, guard_pages.window_size);
+    }
+    if (guard_pages.write_window != NULL) {
+        munmap(guard_pages.write_window, guard_pages.window_size);
+    }
+    guard_pages.read_window = NULL;
+    guard_pages.write_window = NULL;
+    guard_pages.read_base = NULL;
+    guard_pages.write_base = NULL;
+    guard_pages.enabled = false;
+}
+
+/* Reads from image memory through the read view
+    Faults (raising an illegal operation error) if outside instr / data mem
+
+    PARAMS
+    dst_ptr   | Pointer to the memory that should be overwritten with read data
+    src_addr  | Source address in vm memory space
+    data_size | The size of the data to be read in bytes (at most a word)
+*/
+void guarded_read(void* const dst_ptr, const int32_t src_addr,
+                  const int data_size) {
+
+    // Make every earlier store to the system globals visible to the handler
+    atomic_signal_fence(memory_order_seq_cst);
+
+    // Read into a temporary first so that a fault leaves 'dst_ptr' untouched
+    uint32_t data;
+    memcpy(&data, guard_pages.read_base + (uint32_t)src_addr, data_size);
+    memcpy(dst_ptr, &data, data_size);
+}
+
+/* Writes to image memory through the write view
+    Faults (raising an illegal operation error) if outside data mem
+
+    PARAMS
+    src_ptr   | Pointer to the data source to be copied
+    dst_addr  | Destination address in vm memory space
+    data_size | The size of the data to be copied in bytes (at most a word)
+*/
+void guarded_write(const void* const src_ptr, const int32_t dst_addr,
+                   const int data_size) {
+
+    // Make every earlier store to the system globals visible to the handler
+    atomic_signal_fence(memory_order_seq_cst);
+
+    // Write - Offset is unsigned so addresses before data memory wrap far
+    // past its end
+    memcpy(guard_pages.write_base + (uint32_t)(dst_addr - DATA_MEM_START),
+           src_ptr, data_size);
+}
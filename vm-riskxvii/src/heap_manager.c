@@ -8,7 +8,8 @@
     Contains methods used to construct and operate the heap manager.
     * malloc() and free() API
     * heap manager initialiser and destructor
-    * command to link to virtual machine's virtual routine mem
+    * free map used to find the first fit for malloc()
+    * command to link to virtual machine's virtual routines
 
 */
 
@@ -17,276 +18,623 @@
 #include "heap_manager.h"
 
 
-// DOUBLE LINKED LIST METHODS ...
+// LINKED HEAP MANAGER ...
 
-/* Initialises a new list object
-    Zeroes all attributes and links methods
-*/
-void list_init(linked_list_t* const list) {
+// The heap manager used by the virtual routines
+static heap_manager_t* linked_manager = NULL;
 
-    // Zero all attributes
-    list->head = NULL;
-    list->size = 0;
 
-    // Link methods
-    list->insert = &list_insert_node;
-    list->remove = &list_remove_node;
-    list->get = &list_get_node;
-    list->deallocate = &list_deallocate;
+// FREE MAP HELPERS ...
+
+/* Returns the free runs of the 64 banks held by the given bitmap word */
+static free_run_t word_free_run(uint64_t word) {
+
+    free_run_t run;
+
+    // Free banks at either end - Count of trailing / leading set bits
+    run.prefix = (word == UINT64_MAX) ? FREE_MAP_WORD_BANKS :
+                                        __builtin_ctzll(~word);
+    run.suffix = (word == UINT64_MAX) ? FREE_MAP_WORD_BANKS :
+                                        __builtin_clzll(~word);
+
+    // Longest run - Each step shortens every run of set bits by one
+    run.best = 0;
+    while (word != 0) {
+        word &= word >> 1;
+        run.best++;
+    }
+
+    return run;
 }
 
-/* Create a new node with the given data as contents
+/* Returns the free runs of two neighbouring ranges of 'half_len' banks each */
+static free_run_t merge_free_runs(const free_run_t left, const free_run_t right,
+                                  const int32_t half_len) {
 
-    PARAMETERS
-    <int> start | The index (zero start) of the first allocated bank
-    <int> size  | The number of banks allocated
+    free_run_t run;
+
+    // Ends extend into the other half if their own half is entirely free
+    run.prefix = (left.prefix == half_len) ? half_len + right.prefix :
+                                             left.prefix;
+    run.suffix = (right.suffix == half_len) ? half_len + left.suffix :
+                                              right.suffix;
+
+    // Longest run is in either half or spans the middle
+    run.best = (left.best > right.best) ? left.best : right.best;
+    if (left.suffix + right.prefix > run.best) {
+        run.best = left.suffix + right.prefix;
+    }
+
+    return run;
+}
+
+
+/* Searches the given tree node for the lowest run of 'num' free banks that
+    starts at or after bank 'from'
+
+    * 'carry' is the number of free banks (at or after 'from') running up to
+      the start of the node, and is updated to those running up to its end
+    * Nodes wholly at or after 'from' are skipped using their free runs, so
+      at most one whole node is descended into
 
     RETURNS
-    On success | Pointer to the new node
-    On error   | NULL
+    Index of the first bank of the run | If found within (or before) the node
+    -1                                 | Otherwise
 */
-node_t* new_node(const int start, const int size) {
+static int32_t free_map_fit_from_node(const free_map_t* const map,
+    const int32_t node, const int32_t node_start, const int32_t node_len,
+    const int32_t from, const int32_t num, int32_t* const carry) {
 
-    // Allocate memory for head node
-    node_t* new_node = malloc(sizeof(node_t));
+    // Entirely before the search start
+    if (node_start + node_len <= from) {
+        return -1;
+    }
 
-    // Ensure allocation worked
-    if (new_node == NULL) {
-        printf("Error: Host system failed to malloc node\n");
-        throw_host_malloc_failed_err();
-        return NULL;
+    // Entirely at or after the search start - Skip if no run fits within
+    const bool is_whole = (node_start >= from);
+    const free_run_t run = map->tree[node];
+    if (is_whole) {
+        if (*carry + run.prefix >= num) {
+            return node_start - *carry;
+        }
+        if (run.best < num) {
+            *carry = (run.prefix == node_len) ? *carry + node_len : run.suffix;
+            return -1;
+        }
     }
 
-    // Set attributes
-    new_node->next = NULL;
-    new_node->prev = NULL;
-    new_node->start = start;
-    new_node->size = size;
+    // Leaf - Scan the bits of its word from the search start
+    if (node >= map->num_leaves) {
+        const uint64_t word = map->words[node - map->num_leaves];
+        for (int b = is_whole ? 0 : from - node_start; 
+             b < FREE_MAP_WORD_BANKS; b++) {
+            if ((word >> b) & 1) {
+                if (++*carry >= num) {
+                    return node_start + b - *carry + 1;
+                }
+            } 
+            else {
+                *carry = 0;
+            }
+        }
+        return -1;
+    }
 
-    // Return
-    return new_node;
+    // Search children in address order
+    const int32_t half_len = node_len / 2;
+    const int32_t found = free_map_fit_from_node(
+        map, 2 * node, node_start, half_len, from, num, carry);
+    if (found >= 0) {
+        return found;
+    }
+    return free_map_fit_from_node(
+        map, 2 * node + 1, node_start + half_len, half_len, from, num, carry);
 }
 
-/* Inserts the given node at the given index in the given list
 
-    * Throws error if index is out of range
-    * Given index must be > 0
-    * Index range: [0, list.size - 1]
+// FREE RUN HELPERS ...
 
+/* Returns the size class of a free run of the given number of banks
+    i.e., floor(log2(num))
 */
-void list_insert_node(linked_list_t* const list, 
-                        node_t* const node, const int index) {
-
-    // Ensure index is within range - Only check in debug build
-    #ifdef DEBUG_CHECK_LIST_RANGE
-        if (index < 0) {
-            printf("Err inserting node in list:\n");
-            printf("  index [%d] out of range\n", index);
-            return;
-        }
-    #endif
+static int free_run_class(const int32_t num) {
+    return 31 - __builtin_clz((uint32_t)num);
+}
 
-    // Ensure node to insert isn't null
-    if (node == NULL) {
-        printf("Error: list_insert_node() given null ptr as node\n");
-        return;
-    }
 
-    // Get nodes before and after insertion location
-    node_t* prev_cursor = NULL;
-    node_t* cursor = list->head;
-    for (int i = 0; i < index; i++) {
+// OWNERSHIP MAP HELPERS ...
 
-        // Ensure node exists - Only check in debug build
-        #ifdef DEBUG_CHECK_LIST_RANGE
-            if (cursor == NULL) {
-                printf("Error inserting new node in list: Encountered null\n");
-                return;
-            }
-        #endif
-        
-        // Get next
-        prev_cursor = cursor;
-        cursor = cursor->next;
-    }
-
-    // Link node
-      // Empty list
-    if (list->size == 0) {
-        list->head = node;
-        node->prev = NULL;
-        node->next = NULL;  
-    }
-      // At beginning
-    else if (index == 0) { 
-        list->head = node;
-        node->prev = NULL;
-        node->next = cursor;
-        cursor->prev = node;
-    }
-      // At end
-    else if (index == list->size) { 
-        node->prev = prev_cursor;
-        node->next = NULL;
-        prev_cursor->next = node;
-    } 
-      // Somewhere in middle
-    else { 
-        node->prev = prev_cursor;
-        node->next = cursor;
-        cursor->prev = node;
-        prev_cursor->next = node;
+/* Returns the start bank of the allocation holding the given bank
+
+    NOTE
+    * Ownership entries are not cleared by free(), so an entry may name a
+      freed (or since shrunk) allocation. It is only trusted if that
+      allocation still covers the bank - Any allocation that does is sure
+      to have rewritten the entry when it was made.
+
+    RETURNS
+    Start bank of the allocation | If the bank is allocated
+    BANK_NOT_OWNED               | If the bank is free
+*/
+static int32_t bank_owner_of(const heap_manager_t* const manager,
+                             const int32_t bank) {
+    const int32_t start = manager->bank_owner[bank];
+    if (start == BANK_NOT_OWNED || 
+        bank >= start + manager->alloc_banks[start]) {
+        return BANK_NOT_OWNED;
     }
+    return start;
+}
+
 
-    // Increment list metadata
-    list->size++;
+// POLICY HELPERS ...
+
+/* Returns whether the given policy keeps free runs by size */
+static bool uses_free_runs(const int policy) {
+    return (policy == HEAP_POLICY_BEST_FIT || policy == HEAP_POLICY_SEGREGATED);
 }
 
-/* Returns the node at the given index in the given list
+/* Adds the given newly freed banks to the free runs
+    Merges them with the free runs directly before and after (if any)
+*/
+static void add_merged_free_run(heap_manager_t* const manager,
+                                const int32_t start, const int32_t num) {
+
+    free_runs_t* const runs = &manager->free_runs;
+    const free_map_t* const map = &manager->free_map;
+    int32_t run_start = start;
+    int32_t run_banks = num;
+
+    // Run ending just before
+    if (start > 0 && map->is_free(map, start - 1)) {
+        run_start = runs->run_start[start - 1];
+        run_banks += runs->run_banks[run_start];
+        runs->remove(runs, run_start);
+    }
 
-    * Returns NULL if given index is out of range
-    * Index range: [0, list.size - 1]
+    // Run starting just after
+    const int32_t end = start + num;
+    if (end < heap_geometry.bank_num && map->is_free(map, end)) {
+        run_banks += runs->run_banks[end];
+        runs->remove(runs, end);
+    }
 
+    runs->add(runs, run_start, run_banks);
+}
+
+/* Returns the given allocated banks to the free map (and free runs)
+    Their ownership entries are left stale
 */
-node_t* list_get_node(const linked_list_t* const list, const int index) {
+static void release_banks(heap_manager_t* const manager, const int32_t start,
+                          const int32_t num) {
+    manager->free_map.set_range(&manager->free_map, start, num, true);
+    manager->free_banks += num;
+    if (uses_free_runs(manager->policy)) {
+        add_merged_free_run(manager, start, num);
+    }
+}
 
-    // If index out of range - Won't occur in final build
-    #ifdef DEBUG_CHECK_LIST_RANGE
-        if (index < 0 || index >= list->size) {
-            return NULL;
+/* Returns whether the given number of banks from 'start' are all free
+    (and within the heap)
+*/
+static bool is_free_range(const heap_manager_t* const manager,
+                          const int32_t start, const int32_t num) {
+    if (start + num > heap_geometry.bank_num) {
+        return false;
+    }
+    for (int32_t i = start; i < start + num; i++) {
+        if (!manager->free_map.is_free(&manager->free_map, i)) {
+            return false;
         }
-    #endif
+    }
+    return true;
+}
 
-    // Iterate to find requested node
-    node_t* cursor = list->head;
-    for (int i = 0; i < index; i++) {
+/* Returns the number of heap banks needed to hold the given number of bytes */
+static int32_t banks_for_size(const int32_t size) {
+    return size / heap_geometry.bank_size +
+           ((size % heap_geometry.bank_size != 0) ? 1 : 0);
+}
 
-        // Check for out of range / invalid error only if in debug mode
-        #ifdef DEBUG_CHECK_LIST_RANGE
-            if (cursor == NULL) {
-                return NULL;
-            }
-        #endif
 
-        // Move to next node
-        cursor = cursor->next;
+// FREE MAP METHODS ...
+
+/* Initialises the given free map with every heap bank free
+
+    RETURNS
+    true  | On success
+    false | If the host failed to allocate the bitmap or tree
+*/
+bool free_map_init(free_map_t* const map) {
+
+    // Link methods
+    map->set_range = &free_map_set_range;
+    map->first_fit = &free_map_first_fit;
+    map->first_fit_from = &free_map_first_fit_from;
+    map->is_free = &free_map_is_free;
+    map->deallocate = &free_map_deallocate;
+
+    // One leaf per bitmap word - Rounded up to a power of two so that every
+    // node at the same depth covers the same number of banks
+    const int32_t num_words = (heap_geometry.bank_num + FREE_MAP_WORD_BANKS - 1)
+                              / FREE_MAP_WORD_BANKS;
+    map->num_leaves = 1;
+    while (map->num_leaves < num_words) {
+        map->num_leaves *= 2;
+    }
+
+    // Zeroed storage is a map of allocated banks with a matching tree
+    map->words = calloc(map->num_leaves, sizeof(uint64_t));
+    map->tree = calloc(2 * (size_t)map->num_leaves, sizeof(free_run_t));
+    if (map->words == NULL || map->tree == NULL) {
+        free_map_deallocate(map);
+        return false;
     }
 
-    // Return
-    return cursor;
+    // Free every real bank - Padding after the last bank stays allocated
+    free_map_set_range(map, 0, heap_geometry.bank_num, true);
+    return true;
 }
 
-/* Removes the node at the given index in the given list
-    Index range: [0, list.size - 1]
-*/
-void list_remove_node(linked_list_t* const list, const int index) {
+/* Marks the given range of heap banks as free or allocated
+
+    * Updates only the covered words and their ancestors in the tree
+    * O(n / 64 + log n) for a range of n banks
 
-    // If index out of range or list is empty
-      // Won't occur in final build
-    #ifdef DEBUG_CHECK_LIST_RANGE
-        if (index < 0 || index >= list->size) {
-            printf("Err removing node from list: index [%d] out of range\n", index);
+    PARAMETERS
+    <free_map_t*> map | Pointer to the free map
+    <int32_t> start   | Index of the first bank in the range
+    <int32_t> num     | Number of banks in the range
+    <bool> is_free    | Whether the banks are now free
+*/
+void free_map_set_range(free_map_t* const map, const int32_t start,
+                        const int32_t num, const bool is_free) {
+
+    // Ensure range is within the heap banks - Only check in debug build
+    #ifdef DEBUG_CHECK_FREE_MAP_RANGE
+        if (start < 0 || num <= 0 || start + num > heap_geometry.bank_num) {
+            printf("Err setting free map range:\n");
+            printf("  banks [%d, %d) out of range\n", start, start + num);
             return;
         }
     #endif
 
-    // Iterate to find requested node
-    node_t* cursor = list->head;
-    for (int i = 0; i < index; i++) {
-        
-        // Catch null nodes when iterating
-          // For optimisation only check during debug because in final (correct)
-          // build this isn't possible
-        #ifdef DEBUG_CHECK_LIST_RANGE
-            if (cursor == NULL) {
-                printf("Error removing node from list... index out of range\n");
-                return;
-            }
-        #endif
+    // Update the covered bitmap words and their leaves
+    const int32_t end = start + num - 1;
+    const int32_t first_word = start / FREE_MAP_WORD_BANKS;
+    const int32_t last_word = end / FREE_MAP_WORD_BANKS;
+    for (int32_t w = first_word; w <= last_word; w++) {
+
+        // Bits of this word within the range
+        const int lo = (w == first_word) ? start % FREE_MAP_WORD_BANKS : 0;
+        const int hi = (w == last_word) ? end % FREE_MAP_WORD_BANKS :
+                                          FREE_MAP_WORD_BANKS - 1;
+        const uint64_t mask = (UINT64_MAX >> (FREE_MAP_WORD_BANKS - 1 - hi)) &
+                              (UINT64_MAX << lo);
+
+        map->words[w] = is_free ? (map->words[w] | mask) :
+                                  (map->words[w] & ~mask);
+        map->tree[map->num_leaves + w] = word_free_run(map->words[w]);
+    }
+
+    // Rebuild the ancestors of the updated leaves one level at a time
+    int32_t lo = map->num_leaves + first_word;
+    int32_t hi = map->num_leaves + last_word;
+    int32_t half_len = FREE_MAP_WORD_BANKS;
+    while (lo > 1) {
+        lo /= 2;
+        hi /= 2;
+        for (int32_t n = lo; n <= hi; n++) {
+            map->tree[n] = merge_free_runs(
+                map->tree[2 * n], map->tree[2 * n + 1], half_len);
+        }
+        half_len *= 2;
+    }
+}
+
+/* Finds the lowest indexed run of at least the given number of free banks
+
+    RETURNS
+    Index of the first bank of the run | If one exists
+    -1                                 | If no run is long enough
+*/
+int32_t free_map_first_fit(const free_map_t* const map, const int32_t num) {
+
+    // Check a long enough run exists anywhere
+    if (map->tree[1].best < num) {
+        return -1;
+    }
+
+    // Descend towards the lowest run - A run within the left half starts
+    // before one spanning the middle, which starts before one in the right
+    int32_t node = 1;
+    int32_t node_start = 0;
+    int32_t half_len = map->num_leaves * (FREE_MAP_WORD_BANKS / 2);
+    while (node < map->num_leaves) {
+        const free_run_t left = map->tree[2 * node];
+        const free_run_t right = map->tree[2 * node + 1];
+        if (left.best >= num) {
+            node = 2 * node;
+        } 
+        else if (left.suffix + right.prefix >= num) {
+            return node_start + half_len - left.suffix;
+        } 
+        else {
+            node = 2 * node + 1;
+            node_start += half_len;
+        }
+        half_len /= 2;
+    }
+
+    // Run is within a single word - Find the lowest bit that starts it
+    const uint64_t word = map->words[node - map->num_leaves];
+    uint64_t run_starts = word;
+    for (int32_t i = 1; i < num; i++) {
+        run_starts &= word >> i;
+    }
+    return node_start + __builtin_ctzll(run_starts);
+}
+
+/* Finds the lowest indexed run of at least the given number of free banks
+    that starts at or after the given bank
+
+    * O(log n) plus a scan of at most two bitmap words
+
+    RETURNS
+    Index of the first bank of the run | If one exists
+    -1                                 | If no run is long enough
+*/
+int32_t free_map_first_fit_from(const free_map_t* const map, const int32_t num,
+                                const int32_t from) {
+    int32_t carry = 0;
+    return free_map_fit_from_node(map, 1, 0, 
+        map->num_leaves * FREE_MAP_WORD_BANKS, from, num, &carry);
+}
+
+/* Returns whether the given heap bank is free */
+bool free_map_is_free(const free_map_t* const map, const int32_t bank) {
+    return (map->words[bank / FREE_MAP_WORD_BANKS] >>
+            (bank % FREE_MAP_WORD_BANKS)) & 1;
+}
+
+/* Frees the bitmap and tree of the given free map */
+void free_map_deallocate(free_map_t* const map) {
+    free(map->words);
+    free(map->tree);
+    map->words = NULL;
+    map->tree = NULL;
+}
+
+
+// FREE RUN METHODS ...
 
-        // Move to next node
-        cursor = cursor->next;
+/* Initialises the given free runs with one run covering every heap bank
+
+    RETURNS
+    true  | On success
+    false | If the host failed to allocate the run tags or lists
+*/
+bool free_runs_init(free_runs_t* const runs) {
+
+    // Link methods
+    runs->add = &free_runs_add;
+    runs->remove = &free_runs_remove;
+    runs->best_fit = &free_runs_best_fit;
+    runs->segregated_fit = &free_runs_segregated_fit;
+    runs->deallocate = &free_runs_deallocate;
+
+    // Allocate run tags and lists
+    const size_t num_banks = heap_geometry.bank_num;
+    runs->run_banks = calloc(num_banks, sizeof(int32_t));
+    runs->run_start = malloc(num_banks * sizeof(int32_t));
+    runs->next = malloc(num_banks * sizeof(int32_t));
+    runs->prev = malloc(num_banks * sizeof(int32_t));
+    if (runs->run_banks == NULL || runs->run_start == NULL ||
+        runs->next == NULL || runs->prev == NULL) {
+        free_runs_deallocate(runs);
+        return false;
     }
 
-    // Relink adjacent nodes
-      // Only one node in list
-    if (list->size == 1) {
-        list->head = NULL;
+    // Every bank starts in a single run
+    for (int c = 0; c < FREE_RUN_CLASSES; c++) {
+        runs->class_head[c] = NO_FREE_RUN;
     }
-      // At beginning
-    else if (index == 0) {
-        list->head = cursor->next;
-        cursor->prev = NULL;
+    free_runs_add(runs, 0, heap_geometry.bank_num);
+    return true;
+}
+
+/* Adds the free run of the given number of banks starting at the given bank
+    Pushed onto the front of its size class list
+*/
+void free_runs_add(free_runs_t* const runs, const int32_t start,
+                   const int32_t num) {
+
+    // Tag both ends
+    runs->run_banks[start] = num;
+    runs->run_start[start + num - 1] = start;
+
+    // Push onto size class list
+    const int c = free_run_class(num);
+    runs->prev[start] = NO_FREE_RUN;
+    runs->next[start] = runs->class_head[c];
+    if (runs->class_head[c] != NO_FREE_RUN) {
+        runs->prev[runs->class_head[c]] = start;
     }
-      // At end
-    else if (index == list->size - 1) {
-        cursor->prev->next = NULL;
+    runs->class_head[c] = start;
+}
+
+/* Removes the free run starting at the given bank */
+void free_runs_remove(free_runs_t* const runs, const int32_t start) {
+
+    // Unlink from size class list
+    const int c = free_run_class(runs->run_banks[start]);
+    if (runs->prev[start] != NO_FREE_RUN) {
+        runs->next[runs->prev[start]] = runs->next[start];
     } 
-      // Somewhere in middle
     else {
-        cursor->next->prev = cursor->prev;
-        cursor->prev->next = cursor->next;
+        runs->class_head[c] = runs->next[start];
+    }
+    if (runs->next[start] != NO_FREE_RUN) {
+        runs->prev[runs->next[start]] = runs->prev[start];
     }
 
-    // Delete node
-    free(cursor);
+    // Untag start - The end tag is only read for free runs so can be left
+    runs->run_banks[start] = 0;
+}
+
+/* Finds the smallest free run of at least the given number of banks
+    Ties go to the lowest addressed run
+
+    * Scans a single size class list
+
+    RETURNS
+    Start bank of the run | If one exists
+    NO_FREE_RUN           | If no run is long enough
+*/
+int32_t free_runs_best_fit(const free_runs_t* const runs, const int32_t num) {
+
+    // Runs of a larger class are all longer than any fitting run of a
+    // smaller class, so only the first class with a fitting run is scanned
+    for (int c = free_run_class(num); c < FREE_RUN_CLASSES; c++) {
+        int32_t best = NO_FREE_RUN;
+        for (int32_t r = runs->class_head[c]; r != NO_FREE_RUN; 
+             r = runs->next[r]) {
+            const int32_t len = runs->run_banks[r];
+            if (len >= num && (best == NO_FREE_RUN || 
+                len < runs->run_banks[best] ||
+                (len == runs->run_banks[best] && r < best))) {
+                best = r;
+            }
+        }
+        if (best != NO_FREE_RUN) {
+            return best;
+        }
+    }
 
-    // Update list metadata
-    list->size--;
+    // No run is long enough
+    return NO_FREE_RUN;
 }
 
-/* Frees all malloc'd memory used by the list
-    * Removes all elements
-    * Frees all malloc'd memory
+/* Finds a free run of at least the given number of banks by size class
+
+    * Takes the first run of the smallest class whose runs all fit
+    * Falls back to the first fitting run in the class of the request
+
+    RETURNS
+    Start bank of the run | If one exists
+    NO_FREE_RUN           | If no run is long enough
 */
-void list_deallocate(linked_list_t* const list) {
-    for (int i = 0; i < list->size; i++) {
-        list_remove_node(list, 0);
+int32_t free_runs_segregated_fit(const free_runs_t* const runs,
+                                 const int32_t num) {
+
+    // Smallest class whose runs are all long enough
+    const int request_class = free_run_class(num);
+    const int fit_class = request_class + (((int32_t)1 << request_class) < num);
+    for (int c = fit_class; c < FREE_RUN_CLASSES; c++) {
+        if (runs->class_head[c] != NO_FREE_RUN) {
+            return runs->class_head[c];
+        }
+    }
+
+    // Otherwise only some runs in the class of the request fit
+    for (int32_t r = runs->class_head[request_class]; r != NO_FREE_RUN;
+         r = runs->next[r]) {
+        if (runs->run_banks[r] >= num) {
+            return r;
+        }
     }
+
+    // No run is long enough
+    return NO_FREE_RUN;
+}
+
+/* Frees the run tags and lists of the given free runs */
+void free_runs_deallocate(free_runs_t* const runs) {
+    free(runs->run_banks);
+    free(runs->run_start);
+    free(runs->next);
+    free(runs->prev);
+    runs->run_banks = NULL;
+    runs->run_start = NULL;
+    runs->next = NULL;
+    runs->prev = NULL;
 }
 
 
 // HEAP MANAGER METHODS ...
 
 /* Initialises the referenced heap bank manager object
-    * Sets up empty list to store bank allocation data
+    * Sets up the free map and ownership map for the current heap geometry
+    * Sets up the free runs if the given policy needs them
     * Links methods as attributes
 
     PARAMETERS
     <heap_manager*> manager | Pointer to the heap manager
-*/
-heap_manager_t* heap_manager_init() {
+    <int> policy            | The HEAP_POLICY_* used to choose free banks
 
-    // Allocate new heap manager
-    heap_manager_t* const manager = malloc(sizeof(heap_manager_t));
-    if (manager == NULL) {
-        printf("Error: Host system failed to malloc heap manager\n");
-        throw_host_malloc_failed_err();
-    }
-
-    // Init attributes
-    list_init(&manager->allocations);
+    RETURNS
+    true  | On success
+    false | If the host failed to allocate the manager's storage
+*/
+bool heap_manager_init(heap_manager_t* const manager, const int policy) {
 
     // Link methods
     manager->free = &heap_free;
     manager->malloc = &heap_malloc;
+    manager->calloc = &heap_calloc;
+    manager->realloc = &heap_realloc;
     manager->is_valid_memory = &heap_is_valid_memory;
+    manager->is_freeable = &heap_is_freeable;
+    manager->valid_span = &heap_valid_span;
     manager->deallocate = &heap_manager_deallocate;
 
-    // Return pointer to new heap manager
-    return manager;
+    // Init attributes
+    manager->policy = policy;
+    manager->next_fit_from = 0;
+    manager->free_banks = heap_geometry.bank_num;
+    memset(&manager->free_runs, 0, sizeof(free_runs_t));
+
+    // Allocate free map, ownership map, and free runs (if used)
+    const bool map_allocated = free_map_init(&manager->free_map);
+    const bool runs_allocated = !uses_free_runs(policy) ||
+                                free_runs_init(&manager->free_runs);
+    const size_t num_banks = heap_geometry.bank_num;
+    manager->bank_owner = malloc(num_banks * sizeof(int32_t));
+    manager->alloc_banks = calloc(num_banks, sizeof(int32_t));
+    if (!map_allocated || !runs_allocated || manager->bank_owner == NULL ||
+        manager->alloc_banks == NULL) {
+        heap_manager_deallocate(manager);
+        return false;
+    }
+
+    // No bank is owned to begin with
+    for (size_t i = 0; i < num_banks; i++) {
+        manager->bank_owner[i] = BANK_NOT_OWNED;
+    }
+    return true;
 }
 
-/* Deallocates all malloc'd memory within the heap manager
+/* Frees all storage held by the heap manager
     NOTE: Invalidates the heap manager. Only call when finished using it.
 */
 void heap_manager_deallocate(heap_manager_t* const manager) {
+    free_map_deallocate(&manager->free_map);
+    free_runs_deallocate(&manager->free_runs);
+    free(manager->bank_owner);
+    free(manager->alloc_banks);
+    manager->bank_owner = NULL;
+    manager->alloc_banks = NULL;
+}
 
-    // Free allocations list
-    manager->allocations.deallocate(&manager->allocations);
-
-    // Free self
-    free(manager);
+/* Returns the HEAP_POLICY_* with the given name, or -1 if there is none */
+int heap_policy_from_name(const char* const name) {
+    static const char* const names[HEAP_POLICY_NUM] = HEAP_POLICY_NAMES;
+    for (int policy = 0; policy < HEAP_POLICY_NUM; policy++) {
+        if (strcmp(name, names[policy]) == 0) {
+            return policy;
+        }
+    }
+    return -1;
 }
 
 /* Converts the given heap bank index to a memory address in the virtual machine
@@ -298,7 +646,7 @@ void heap_manager_deallocate(heap_manager_t* const manager) {
     <int32_t> | The vm memory address corresponding to the given heap bank index
 */
 int32_t heap_index_to_addr(const int32_t heap_index) {
-    return HEAP_MEM_START + (heap_index * HEAP_BANK_SIZE);
+    return HEAP_MEM_START + (heap_index * heap_geometry.bank_size);
 }
 
 /* Converts the given address in virtual machine memory space to the index of 
@@ -314,7 +662,7 @@ int32_t heap_index_to_addr(const int32_t heap_index) {
     <int32_t> index | The heap bank index corresponding to the given address
 */
 int32_t addr_to_heap_index(const int32_t addr) {
-    return (addr - HEAP_MEM_START) / HEAP_BANK_SIZE;
+    return (addr - HEAP_MEM_START) / heap_geometry.bank_size;
 }
 
 /* Returns whether the given address points to the beginning of a heap bank
@@ -333,16 +681,17 @@ bool is_heap_bank_addr(int32_t addr) {
 
     // Whether the address is aligned with the start position of heap banks
     //  i.e., not pointing to the middle of a heap bank
-    const bool is_aligned = (addr % HEAP_BANK_SIZE == 0);
+    const bool is_aligned = (addr % heap_geometry.bank_size == 0);
 
     // Whether the address is within the bound of heap bank memory
-    const bool is_within_bounds = (addr >= 0 && addr < HEAP_MEM_SIZE);
+    const bool is_within_bounds = (addr >= 0 && addr < heap_geometry.mem_size);
 
     // If both are true then it is a heap bank address
     return (is_aligned && is_within_bounds);
 }
 
 /* Attempts to allocate the given ammount of memory in the heap banks
+    The banks are chosen by the manager's allocation policy
 
     PARAMETERS
     <heap_manager*> manager | Pointer to the heap manager
@@ -357,55 +706,71 @@ bool is_heap_bank_addr(int32_t addr) {
 void heap_malloc(heap_manager_t* const manager, const int32_t size) {
    
     // Check if requested alloction is within allowed memory bounds
-    if (size <= 0 || size > (HEAP_BANK_NUM * HEAP_BANK_SIZE)) {
+    if (size <= 0 || size > heap_geometry.mem_size) {
         registers[HEAP_PTR_OUT_REGISTER] = MALLOC_FAIL_RETURN_VAL;
         return;
     }
 
     // Calculate number of required heap banks
-    int num_banks = size / HEAP_BANK_SIZE;
-    num_banks += (size % HEAP_BANK_SIZE != 0) ? 1 : 0;
-
-    // Start at -1 because the first index after -1 is 0
-    int prev_end = -1;
-
-    // Iterate to find enough consecutive free memory banks
-    for (int i = 0; i < manager->allocations.size; i++) {
-
-        // Get next node
-        const node_t* const n = manager->allocations.get(
-            &manager->allocations, i);
-        
-        // Check for and allocate if possible
-        const int n_free = n->start - prev_end - 1;
-        const int start = prev_end + 1;
-        if (n_free >= num_banks) {
-            node_t* const heap_node = new_node(prev_end + 1, num_banks);
-            manager->allocations.insert(&manager->allocations, heap_node, i);
-            registers[HEAP_PTR_OUT_REGISTER] = heap_index_to_addr(start);
-            return;
-        }
-        prev_end = n->start + n->size - 1;
+    const int32_t num_banks = banks_for_size(size);
+
+    // Find enough consecutive free memory banks using the chosen policy
+    free_map_t* const map = &manager->free_map;
+    free_runs_t* const runs = &manager->free_runs;
+    int32_t start;
+    switch (manager->policy) {
+
+        // Search on from the last allocation, then wrap around
+        case HEAP_POLICY_NEXT_FIT:
+            start = map->first_fit_from(map, num_banks, manager->next_fit_from);
+            if (start < 0) {
+                start = map->first_fit(map, num_banks);
+            }
+            break;
+
+        case HEAP_POLICY_BEST_FIT:
+            start = runs->best_fit(runs, num_banks);
+            break;
+
+        case HEAP_POLICY_SEGREGATED:
+            start = runs->segregated_fit(runs, num_banks);
+            break;
+
+        // First fit
+        default:
+            start = map->first_fit(map, num_banks);
     }
 
-    // Check space from final allocation to end of heap banks
-    const int space = HEAP_BANK_NUM - prev_end - 1;
-    if (space >= num_banks) {
-        const int alloc_location = prev_end + 1;
-        const int index = manager->allocations.size;
-        node_t* const heap_node = new_node(alloc_location, num_banks);
-        manager->allocations.insert(&manager->allocations, heap_node, index);
-        registers[HEAP_PTR_OUT_REGISTER] = heap_index_to_addr(alloc_location);
+    // If failed to allocate return null
+    if (start < 0) {
+        registers[HEAP_PTR_OUT_REGISTER] = MALLOC_FAIL_RETURN_VAL;
         return;
     }
 
-    // If failed to allocate return null
-    registers[HEAP_PTR_OUT_REGISTER] = MALLOC_FAIL_RETURN_VAL;
+    // Split the run - These policies always allocate from the start of one
+    if (uses_free_runs(manager->policy)) {
+        const int32_t run_banks = runs->run_banks[start];
+        runs->remove(runs, start);
+        if (run_banks > num_banks) {
+            runs->add(runs, start + num_banks, run_banks - num_banks);
+        }
+    }
+
+    // Claim the banks
+    map->set_range(map, start, num_banks, false);
+    for (int32_t i = start; i < start + num_banks; i++) {
+        manager->bank_owner[i] = start;
+    }
+    manager->alloc_banks[start] = num_banks;
+    manager->free_banks -= num_banks;
+    manager->next_fit_from = (start + num_banks) % heap_geometry.bank_num;
+    registers[HEAP_PTR_OUT_REGISTER] = heap_index_to_addr(start);
 }
 
 /* Attempts to free the referenced memory
     Throws an illegal operation error if the given memory is not allocated
     or outside vm heap memory space.
+    O(1) lookup plus O(log n) to mark the banks free in the free map.
 
     PARAMETERS
     <heap_manager*> manager | Pointer to the heap manager
@@ -418,37 +783,164 @@ void heap_free(heap_manager_t* const manager, const int32_t addr) {
         return;
     }
 
-    // Convert address to heap bank index
+    // Must be the start of an allocation
+    if (!heap_is_freeable(manager, addr)) {
+        throw_illegal_operation_err();
+        return;
+    }
+
+    // Release the banks
     const int32_t index = addr_to_heap_index(addr);
+    const int32_t num_banks = manager->alloc_banks[index];
+    manager->alloc_banks[index] = 0;
+    release_banks(manager, index, num_banks);
+}
 
-    // Find and free allocation block with given start addr
-    bool found_match = false;
-    for (int i = 0; i < manager->allocations.size; i++) {
-
-        // Get next node
-        const node_t* const n = manager->allocations.get(
-            &manager->allocations, i);
-        
-        // Check for match with free location
-        if (n->start == index) {
-            found_match = true;
-            manager->allocations.remove(&manager->allocations, i);
-        }
+/* Attempts to allocate the given ammount of zeroed memory in the heap banks
+    As heap_malloc(), but every byte of the allocated banks is zeroed
+
+    PARAMETERS
+    <heap_manager*> manager | Pointer to the heap manager
+    <int32_t> size          | The size of the memory to be allocated in bytes
+
+    RETURNS
+    None - However ...
+    Saves pointer to allocated memory in register 28:
+    * NULL if couldn't allocate
+    * Pointer to allocated memory if successful
+*/
+void heap_calloc(heap_manager_t* const manager, const int32_t size) {
+
+    manager->malloc(manager, size);
+
+    // Zero the whole banks - Freed banks keep their old contents
+    const int32_t addr = registers[HEAP_PTR_OUT_REGISTER];
+    if (addr != MALLOC_FAIL_RETURN_VAL) {
+        const int32_t index = addr_to_heap_index(addr);
+        memset(&heap_memory[addr - HEAP_MEM_START], 0,
+               (size_t)manager->alloc_banks[index] * heap_geometry.bank_size);
     }
+}
+
+/* Attempts to resize the referenced memory to the given ammount of bytes
+
+    * A null address is the same as heap_malloc()
+    * Shrinks in place, releasing the banks no longer needed
+    * Grows in place if the banks directly after are free, otherwise moves
+      the memory to a new allocation (host memcpy) and frees the old one
+    * Throws an illegal operation error if the given memory is not allocated
+      or outside vm heap memory space (as heap_free())
 
-    // Throw error if none found or not valid addr
-    // NOTE: If not valid addr check fails, a heap allocation node may have
-    //       already been removed. however this is ok because the program 
-    //       will exit with the thrown illegal operation error.
-    if (!found_match || !is_heap_bank_addr(addr)) {
+    PARAMETERS
+    <heap_manager*> manager | Pointer to the heap manager
+    <int32_t> addr          | The address of the memory block to be resized
+    <int32_t> size          | The new size of the memory block in bytes
+
+    RETURNS
+    None - However ...
+    Saves pointer to the resized memory in register 28:
+    * NULL if couldn't allocate - The memory is left as it was
+    * Pointer to the resized memory if successful
+*/
+void heap_realloc(heap_manager_t* const manager, const int32_t addr,
+                  const int32_t size) {
+
+    // Same as malloc for null as per C spec
+    if (addr == NULL_ADDRESS) {
+        manager->malloc(manager, size);
+        return;
+    }
+
+    // Must be the start of an allocation
+    if (!heap_is_freeable(manager, addr)) {
         throw_illegal_operation_err();
+        return;
+    }
+
+    // Check if new size is within allowed memory bounds
+    if (size <= 0 || size > heap_geometry.mem_size) {
+        registers[HEAP_PTR_OUT_REGISTER] = MALLOC_FAIL_RETURN_VAL;
+        return;
+    }
+
+    const int32_t start = addr_to_heap_index(addr);
+    const int32_t old_banks = manager->alloc_banks[start];
+    const int32_t new_banks = banks_for_size(size);
+    const int32_t end = start + old_banks;
+    registers[HEAP_PTR_OUT_REGISTER] = addr;
+
+    // Shrink in place
+    if (new_banks <= old_banks) {
+        if (new_banks < old_banks) {
+            manager->alloc_banks[start] = new_banks;
+            release_banks(manager, start + new_banks, old_banks - new_banks);
+        }
+        return;
+    }
+
+    // Grow in place - The free run directly after must start at 'end' as
+    // the bank before it is allocated
+    const int32_t extra = new_banks - old_banks;
+    if (is_free_range(manager, end, extra)) {
+        if (uses_free_runs(manager->policy)) {
+            free_runs_t* const runs = &manager->free_runs;
+            const int32_t run_banks = runs->run_banks[end];
+            runs->remove(runs, end);
+            if (run_banks > extra) {
+                runs->add(runs, end + extra, run_banks - extra);
+            }
+        }
+        manager->free_map.set_range(&manager->free_map, end, extra, false);
+        for (int32_t i = end; i < end + extra; i++) {
+            manager->bank_owner[i] = start;
+        }
+        manager->alloc_banks[start] = new_banks;
+        manager->free_banks -= extra;
+        return;
+    }
+
+    // Move - Old memory is only freed once the new allocation succeeds
+    manager->malloc(manager, size);
+    const int32_t new_addr = registers[HEAP_PTR_OUT_REGISTER];
+    if (new_addr == MALLOC_FAIL_RETURN_VAL) {
+        return;
+    }
+    memcpy(&heap_memory[new_addr - HEAP_MEM_START],
+           &heap_memory[addr - HEAP_MEM_START],
+           (size_t)old_banks * heap_geometry.bank_size);
+    manager->alloc_banks[start] = 0;
+    release_banks(manager, start, old_banks);
+}
+
+/* Returns whether freeing the given address would succeed
+
+    * The null address can always be freed (it does nothing)
+    * Otherwise it must point to the first bank of an allocation - One
+      lookup in the ownership map, whatever the number of allocations
+
+    PARAMETERS
+    <heap_manager*> manager | Pointer to the heap manager
+    <int32_t> addr          | The address of the memory block to be freed
+*/
+bool heap_is_freeable(const heap_manager_t* const manager, const int32_t addr) {
+
+    // Null does nothing as per C spec
+    if (addr == NULL_ADDRESS) {
+        return true;
     }
+
+    // Must point to the first bank of an allocation
+    return is_heap_bank_addr(addr) &&
+        (bank_owner_of(manager, addr_to_heap_index(addr)) == 
+         addr_to_heap_index(addr));
 }
 
 /* Returns whether the given memory field is valid within the heap
 
     * Checks that all addresses within the given field are allocated
     * Checks addresses within the given field are in the same allocated chunk
+      or in directly adjacent allocated chunks
+    * O(1) for accesses within one chunk
 
     PARAMETERS
     <heap_manager*> manager | Pointer to the heap manager
@@ -458,34 +950,24 @@ void heap_free(heap_manager_t* const manager, const int32_t addr) {
 bool heap_is_valid_memory(heap_manager_t* const manager, 
                   const int32_t start_addr, const int32_t size) {
 
-    // Iterate and check if allocated for each byte in range
-    const linked_list_t* const allocations = &manager->allocations;
-    const int end_addr_iter = start_addr + size; 
-    for (int sub_addr = start_addr; sub_addr < end_addr_iter; sub_addr++) {
-
-        // Holds whether the current sub address is valid
-        bool valid = false;
+    // Banks containing the first and last byte of the field
+    const int32_t first_bank = addr_to_heap_index(start_addr);
+    const int32_t last_bank = addr_to_heap_index(start_addr + size - 1);
 
-        // Iterate allocation nodes
-        for (int j = 0; j < allocations->size; j++) {
-
-            // Get next node
-            const node_t* const n = allocations->get(allocations, j);
-            
-            // Check whether the current sub address is valid
-            const int after_end_index = n->start + n->size;
-            if ((sub_addr >= heap_index_to_addr(n->start)) && 
-                  (sub_addr < heap_index_to_addr(after_end_index))) {
-
-                // Set sub address to valid
-                valid = true;
-            }
-        }
+    // Find the allocation containing the first byte
+    const int32_t start = bank_owner_of(manager, first_bank);
+    if (start == BANK_NOT_OWNED) {
+        return false;
+    }
+    int32_t covered_end = start + manager->alloc_banks[start];
 
-        // If sub address isn't valid return invalid for whole range
-        if (!valid) {
+    // Extend through directly adjacent allocations until the last byte is
+    // covered - Accessing across consecutive allocated chunks is allowed
+    while (last_bank >= covered_end) {
+        if (bank_owner_of(manager, covered_end) != covered_end) {
             return false;
         }
+        covered_end += manager->alloc_banks[covered_end];
     }
 
     // Must be valid if this point reached
@@ -493,22 +975,51 @@ bool heap_is_valid_memory(heap_manager_t* const manager,
 }
 
 
+/* Returns the number of bytes from the given address that can be accessed
+    (up to the end of the allocation holding it, extended through directly
+    adjacent allocations as heap_is_valid_memory() allows)
+
+    PARAMETERS
+    <heap_manager*> manager | Pointer to the heap manager
+    <int32_t> addr          | The address (in vm memory space) to start from
+
+    RETURNS
+    0   | If the address is not allocated
+    n   | Otherwise
+*/
+int32_t heap_valid_span(const heap_manager_t* const manager,
+                        const int32_t addr) {
+
+    // Find the allocation containing the address
+    const int32_t start = bank_owner_of(manager, addr_to_heap_index(addr));
+    if (start == BANK_NOT_OWNED) {
+        return 0;
+    }
+
+    // Extend through directly adjacent allocations
+    int32_t covered_end = start + manager->alloc_banks[start];
+    while (covered_end < heap_geometry.bank_num &&
+           bank_owner_of(manager, covered_end) == covered_end) {
+        covered_end += manager->alloc_banks[covered_end];
+    }
+    return heap_index_to_addr(covered_end) - addr;
+}
+
+
 // MANAGER INTERFACE METHODS ...
 
 /* Links the given heap manager to the system virtual routines
-    Saves a pointer to the heap manager in virtual routine memory
-    when is then accessed by other virtual machine sys calls
+    Saves a host side pointer to the heap manager which is then accessed
+    by other virtual machine sys calls
 */
 void link_heap_manager(heap_manager_t* const manager) {
-    *(heap_manager_t**)&memory[VR_HEAP_MANAGER_ADDR] = manager;
+    linked_manager = manager;
 }
 
 /* Returns a pointer to the heap manager object
-    Retrieves and returns the pointer to the heap manager object stored in the
-    virtual routine memory space. This pointer must originally be set using 
-    link_heap_manager()
+    This pointer must originally be set using link_heap_manager()
 */
 heap_manager_t* get_heap_manager() {
-    return *(heap_manager_t**)&memory[VR_HEAP_MANAGER_ADDR];
+    return linked_manager;
 }
 
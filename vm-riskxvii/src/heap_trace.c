@@ -0,0 +1,146 @@
+// Name:   Isaak Choi
+// UniKey: icho6322
+// SID:    520488399
+
+
+/* heap_trace.c
+
+    Contains the writer and reader of the guest heap event trace.
+
+*/
+
+
+// INCLUDE HEADER ...
+#include "heap_trace.h"
+
+#include <string.h>
+
+
+// TRACE FILE ...
+
+// The trace being written - NULL when not recording
+static FILE* trace_file = NULL;
+
+
+// ENCODING HELPERS ...
+
+/* Writes the given value to 'buf' as 'size' little endian bytes */
+static void put_le(uint8_t* const buf, const uint64_t value, const int size) {
+    for (int i = 0; i < size; i++) {
+        buf[i] = (uint8_t)(value >> (i * 8));
+    }
+}
+
+/* Returns the value of the 'size' little endian bytes in 'buf' */
+static uint64_t get_le(const uint8_t* const buf, const int size) {
+    uint64_t value = 0;
+    for (int i = size - 1; i >= 0; i--) {
+        value = (value << 8) | buf[i];
+    }
+    return value;
+}
+
+
+// TRACE WRITER ...
+
+/* Opens the given file and writes the trace header to it
+    Events are recorded from then on until heap_trace_close()
+
+    RETURNS
+    true  | On success
+    false | If the file couldn't be opened or written
+*/
+bool heap_trace_open(const char* const path,
+                     const heap_trace_header_t* const header) {
+
+    // Open - Fully buffered as events are small and frequent
+    trace_file = fopen(path, "wb");
+    if (trace_file == NULL) {
+        return false;
+    }
+    setvbuf(trace_file, NULL, _IOFBF, HEAP_TRACE_BUFFER_SIZE);
+
+    // Write header
+    uint8_t buf[HEAP_TRACE_HEADER_SIZE];
+    memcpy(buf, HEAP_TRACE_MAGIC, HEAP_TRACE_MAGIC_SIZE);
+    put_le(buf + 4, HEAP_TRACE_VERSION, 4);
+    put_le(buf + 8, (uint32_t)header->bank_size, 4);
+    put_le(buf + 12, (uint32_t)header->heap_size, 4);
+    put_le(buf + 16, (uint32_t)header->policy, 4);
+    if (fwrite(buf, sizeof(buf), 1, trace_file) != 1) {
+        heap_trace_close();
+        return false;
+    }
+    return true;
+}
+
+/* Returns whether heap events are being recorded */
+bool heap_trace_is_open() {
+    return (trace_file != NULL);
+}
+
+/* Records the given event - Does nothing if no trace is open */
+void heap_trace_record(const heap_trace_event_t* const event) {
+
+    if (trace_file == NULL) {
+        return;
+    }
+
+    uint8_t buf[HEAP_TRACE_EVENT_SIZE];
+    buf[0] = event->kind;
+    put_le(buf + 1, event->instr, 8);
+    put_le(buf + 9, (uint32_t)event->arg, 4);
+    put_le(buf + 13, (uint32_t)event->result, 4);
+    fwrite(buf, sizeof(buf), 1, trace_file);
+}
+
+/* Flushes and closes the trace file - Does nothing if no trace is open */
+void heap_trace_close() {
+    if (trace_file != NULL) {
+        fclose(trace_file);
+        trace_file = NULL;
+    }
+}
+
+
+// TRACE READER ...
+
+/* Reads and checks the trace header from the given file
+
+    RETURNS
+    true  | On success
+    false | If the file is not a heap trace of this version
+*/
+bool heap_trace_read_header(FILE* const file,
+                            heap_trace_header_t* const header) {
+
+    uint8_t buf[HEAP_TRACE_HEADER_SIZE];
+    if (fread(buf, sizeof(buf), 1, file) != 1 ||
+        memcmp(buf, HEAP_TRACE_MAGIC, HEAP_TRACE_MAGIC_SIZE) != 0 ||
+        get_le(buf + 4, 4) != HEAP_TRACE_VERSION) {
+        return false;
+    }
+    header->bank_size = (int32_t)get_le(buf + 8, 4);
+    header->heap_size = (int32_t)get_le(buf + 12, 4);
+    header->policy = (int32_t)get_le(buf + 16, 4);
+    return true;
+}
+
+/* Reads the next event from the given file
+
+    RETURNS
+    true  | On success
+    false | At the end of the file (or a truncated event)
+*/
+bool heap_trace_read_event(FILE* const file, heap_trace_event_t* const event) {
+
+    uint8_t buf[HEAP_TRACE_EVENT_SIZE];
+    if (fread(buf, sizeof(buf), 1, file) != 1) {
+        return false;
+    }
+    event->kind = buf[0];
+    event->instr = get_le(buf + 1, 8);
+    event->arg = (int32_t)get_le(buf + 9, 4);
+    event->result = (int32_t)get_le(buf + 13, 4);
+    return true;
+}
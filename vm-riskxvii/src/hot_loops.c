@@ -0,0 +1,575 @@
+// Name:   Isaak Choi
+// UniKey: icho6322
+// SID:    520488399
+
+
+/* hot_loops.c
+
+    Contains hot loop detection, and the building and running of loop
+    traces (see hot_loops.h).
+
+*/
+
+
+// INCLUDE HEADER ...
+#include "hot_loops.h"
+
+#include <string.h>
+#include "instructions.h"
+#include "budget.h"
+#include "guard_pages.h"
+#include "rvc.h"
+
+
+// CONSTANTS ...
+
+// Trace operations - The base instructions a loop may be made of
+#define LOOP_OP_ADD         (0)
+#define LOOP_OP_ADDI        (1)
+#define LOOP_OP_SUB         (2)
+#define LOOP_OP_LUI         (3)
+#define LOOP_OP_XOR         (4)
+#define LOOP_OP_XORI        (5)
+#define LOOP_OP_OR          (6)
+#define LOOP_OP_ORI         (7)
+#define LOOP_OP_AND         (8)
+#define LOOP_OP_ANDI        (9)
+#define LOOP_OP_SLL         (10)
+#define LOOP_OP_SRL         (11)
+#define LOOP_OP_SRA         (12)
+#define LOOP_OP_LB          (13)
+#define LOOP_OP_LH          (14)
+#define LOOP_OP_LW          (15)
+#define LOOP_OP_LBU         (16)
+#define LOOP_OP_LHU         (17)
+#define LOOP_OP_SB          (18)
+#define LOOP_OP_SH          (19)
+#define LOOP_OP_SW          (20)
+#define LOOP_OP_SLT         (21)
+#define LOOP_OP_SLTI        (22)
+#define LOOP_OP_SLTU        (23)
+#define LOOP_OP_SLTIU       (24)
+#define LOOP_OP_BEQ         (25)
+#define LOOP_OP_BNE         (26)
+#define LOOP_OP_BLT         (27)
+#define LOOP_OP_BLTU        (28)
+#define LOOP_OP_BGE         (29)
+#define LOOP_OP_BGEU        (30)
+#define LOOP_OP_JAL         (31)
+#define LOOP_OP_JALR        (32)
+#define LOOP_NUM_OPS        (33)
+
+// Index of a branch target outside the trace - The trace exits there
+#define LOOP_EXIT           (-1)
+
+// Count of a loop head that couldn't be traced - Never counted again
+#define LOOP_UNTRACEABLE    (UINT32_MAX)
+
+// Deoptimisations (and failed entry checks) after which a trace is dropped
+// as the loop keeps leaving it, e.g. for heap accesses
+#define LOOP_MAX_DEOPTS     (16)
+
+
+// MACROS ...
+
+// Whether the given operation is a load / store / branch
+#define IS_LOAD_OP(op)      ((op) >= LOOP_OP_LB && (op) <= LOOP_OP_LHU)
+#define IS_STORE_OP(op)     ((op) >= LOOP_OP_SB && (op) <= LOOP_OP_SW)
+#define IS_BRANCH_OP(op)    ((op) >= LOOP_OP_BEQ && (op) <= LOOP_OP_BGEU)
+
+
+// DATA STRUCTURES ...
+
+// How a base instruction is matched and unpacked
+typedef struct loop_decoder_t loop_decoder_t;
+struct loop_decoder_t {
+    int32_t extract_mask;
+    int32_t id_bits;
+    void (*extract)(instruction_t* const, int32_t);
+};
+
+// A predecoded instruction of a trace
+typedef struct loop_op_t loop_op_t;
+struct loop_op_t {
+    int32_t op;          // One of LOOP_OP_*
+    int32_t rd;
+    int32_t rs1;
+    int32_t rs2;
+    int32_t imm;
+    int32_t pc;          // Address of the instruction
+    int32_t size;        // INST_SIZE_BYTES, or RVC_SIZE_BYTES if compressed
+    int32_t taken;       // Branches - Trace index of the target, or LOOP_EXIT
+    int32_t mem_size;    // Loads and stores - Bytes accessed
+    bool proven;         // Loads and stores - Address checked on entry
+};
+
+// A loop trace - The instructions from the loop head to the branch back
+typedef struct loop_trace_t loop_trace_t;
+struct loop_trace_t {
+    int32_t n_ops;
+    bool has_proven;     // Whether any access is checked on entry
+    uint32_t deopts;     // Times the trace has deoptimised
+    loop_op_t ops[HOT_LOOP_MAX_OPS];
+};
+
+
+// GLOBAL HOT LOOP VARS ...
+
+// The base instructions, indexed by LOOP_OP_* - In the order
+//  exec_instruction() matches them, as an encoding may match more than one
+static const loop_decoder_t decoders[LOOP_NUM_OPS] = {
+    [LOOP_OP_ADD]   = {ID_EXTRACT_MASK_3, ADD_ID_BITS,   extract_R},
+    [LOOP_OP_ADDI]  = {ID_EXTRACT_MASK_2, ADDI_ID_BITS,  extract_I},
+    [LOOP_OP_SUB]   = {ID_EXTRACT_MASK_3, SUB_ID_BITS,   extract_R},
+    [LOOP_OP_LUI]   = {ID_EXTRACT_MASK_1, LUI_ID_BITS,   extract_U},
+    [LOOP_OP_XOR]   = {ID_EXTRACT_MASK_3, XOR_ID_BITS,   extract_R},
+    [LOOP_OP_XORI]  = {ID_EXTRACT_MASK_2, XORI_ID_BITS,  extract_I},
+    [LOOP_OP_OR]    = {ID_EXTRACT_MASK_3, OR_ID_BITS,    extract_R},
+    [LOOP_OP_ORI]   = {ID_EXTRACT_MASK_2, ORI_ID_BITS,   extract_I},
+    [LOOP_OP_AND]   = {ID_EXTRACT_MASK_3, AND_ID_BITS,   extract_R},
+    [LOOP_OP_ANDI]  = {ID_EXTRACT_MASK_2, ANDI_ID_BITS,  extract_I},
+    [LOOP_OP_SLL]   = {ID_EXTRACT_MASK_3, SLL_ID_BITS,   extract_R},
+    [LOOP_OP_SRL]   = {ID_EXTRACT_MASK_3, SRL_ID_BITS,   extract_R},
+    [LOOP_OP_SRA]   = {ID_EXTRACT_MASK_3, SRA_ID_BITS,   extract_R},
+    [LOOP_OP_LB]    = {ID_EXTRACT_MASK_2, LB_ID_BITS,    extract_I},
+    [LOOP_OP_LH]    = {ID_EXTRACT_MASK_2, LH_ID_BITS,    extract_I},
+    [LOOP_OP_LW]    = {ID_EXTRACT_MASK_2, LW_ID_BITS,    extract_I},
+    [LOOP_OP_LBU]   = {ID_EXTRACT_MASK_2, LBU_ID_BITS,   extract_I},
+    [LOOP_OP_LHU]   = {ID_EXTRACT_MASK_2, LHU_ID_BITS,   extract_I},
+    [LOOP_OP_SB]    = {ID_EXTRACT_MASK_2, SB_ID_BITS,    extract_S},
+    [LOOP_OP_SH]    = {ID_EXTRACT_MASK_2, SH_ID_BITS,    extract_S},
+    [LOOP_OP_SW]    = {ID_EXTRACT_MASK_2, SW_ID_BITS,    extract_S},
+    [LOOP_OP_SLT]   = {ID_EXTRACT_MASK_3, SLT_ID_BITS,   extract_R},
+    [LOOP_OP_SLTI]  = {ID_EXTRACT_MASK_2, SLTI_ID_BITS,  extract_I},
+    [LOOP_OP_SLTU]  = {ID_EXTRACT_MASK_3, SLTU_ID_BITS,  extract_R},
+    [LOOP_OP_SLTIU] = {ID_EXTRACT_MASK_2, SLTIU_ID_BITS, extract_I},
+    [LOOP_OP_BEQ]   = {ID_EXTRACT_MASK_2, BEQ_ID_BITS,   extract_SB},
+    [LOOP_OP_BNE]   = {ID_EXTRACT_MASK_2, BNE_ID_BITS,   extract_SB},
+    [LOOP_OP_BLT]   = {ID_EXTRACT_MASK_2, BLT_ID_BITS,   extract_SB},
+    [LOOP_OP_BLTU]  = {ID_EXTRACT_MASK_2, BLTU_ID_BITS,  extract_SB},
+    [LOOP_OP_BGE]   = {ID_EXTRACT_MASK_2, BGE_ID_BITS,   extract_SB},
+    [LOOP_OP_BGEU]  = {ID_EXTRACT_MASK_2, BGEU_ID_BITS,  extract_SB},
+    [LOOP_OP_JAL]   = {ID_EXTRACT_MASK_1, JAL_ID_BITS,   extract_UJ},
+    [LOOP_OP_JALR]  = {ID_EXTRACT_MASK_2, JALR_ID_BITS,  extract_I},
+};
+
+// Times each loop head has been branched back to (or LOOP_UNTRACEABLE)
+static uint32_t back_edge_counts[INST_MEM_SIZE];
+
+// The trace of the loop starting at each loop head (NULL if none)
+static loop_trace_t* traces[INST_MEM_SIZE];
+
+// Count at which a loop is traced (0 if loops are never traced)
+static uint64_t hot_threshold = 0;
+
+
+// TRACE BUILDING ...
+
+/* Predecodes the instruction at the given address into 'op'
+
+    RETURNS
+    true  | On success
+    false | If it isn't a base instruction, or runs past the end of
+            instruction memory
+*/
+static bool decode_op(const int32_t addr, loop_op_t* const op) {
+
+    // Fetch - Compressed instructions are expanded
+    op->pc = addr;
+    op->size = (options.ext_c && IS_RVC_INSTR(memory[addr])) ?
+               RVC_SIZE_BYTES : INST_SIZE_BYTES;
+    if (addr > INST_MEM_SIZE - op->size) {
+        return false;
+    }
+    int32_t raw;
+    if (op->size == RVC_SIZE_BYTES) {
+        uint16_t half;
+        memcpy(&half, &memory[addr], sizeof(half));
+        raw = (int32_t)rvc_expand(half);
+    }
+    else {
+        memcpy(&raw, &memory[addr], sizeof(raw));
+    }
+
+    // Match
+    op->op = -1;
+    for (int i = 0; i < LOOP_NUM_OPS; i++) {
+        if (INSTR_MATCH(raw, decoders[i].extract_mask, decoders[i].id_bits)) {
+            op->op = i;
+            break;
+        }
+    }
+    if (op->op < 0) {
+        return false;
+    }
+
+    // Unpack
+    instruction_t f;
+    decoders[op->op].extract(&f, raw);
+    op->rd = op->rs1 = op->rs2 = ZERO_REGISTER_ADDR;
+    op->imm = 0;
+    if (decoders[op->op].extract == extract_R) {
+        op->rd = f.type_R.rd;
+        op->rs1 = f.type_R.rs1;
+        op->rs2 = f.type_R.rs2;
+    }
+    else if (decoders[op->op].extract == extract_I) {
+        op->rd = f.type_I.rd;
+        op->rs1 = f.type_I.rs1;
+        op->imm = f.type_I.imm;
+    }
+    else if (decoders[op->op].extract == extract_S) {
+        op->rs1 = f.type_S.rs1;
+        op->rs2 = f.type_S.rs2;
+        op->imm = f.type_S.imm;
+    }
+    else if (decoders[op->op].extract == extract_SB) {
+        op->rs1 = f.type_SB.rs1;
+        op->rs2 = f.type_SB.rs2;
+        op->imm = f.type_SB.imm;
+    }
+    else if (decoders[op->op].extract == extract_U) {
+        op->rd = f.type_U.rd;
+        op->imm = f.type_U.imm;
+    }
+    else {
+        op->rd = f.type_UJ.rd;
+        op->imm = f.type_UJ.imm;
+    }
+
+    // Access size of loads and stores
+    switch (op->op) {
+        case LOOP_OP_LB: case LOOP_OP_LBU: case LOOP_OP_SB:
+            op->mem_size = 1;
+            break;
+        case LOOP_OP_LH: case LOOP_OP_LHU: case LOOP_OP_SH:
+            op->mem_size = WORD_SIZE / 2;
+            break;
+        default:
+            op->mem_size = WORD_SIZE;
+            break;
+    }
+    return true;
+}
+
+/* Builds the trace of the loop from 'head' to the branch or jump back to
+   it at 'branch_pc'
+
+    RETURNS
+    The trace | On success (malloc'd)
+    NULL      | If the loop can't be traced
+*/
+static loop_trace_t* build_trace(const int32_t head, const int32_t branch_pc) {
+
+    loop_trace_t* const trace = malloc(sizeof(loop_trace_t));
+    if (trace == NULL) {
+        return NULL;
+    }
+    trace->n_ops = 0;
+    trace->has_proven = false;
+    trace->deopts = 0;
+
+    // Trace index of each address of the loop (LOOP_EXIT if none)
+    static int32_t index_at[HOT_LOOP_MAX_OPS * INST_SIZE_BYTES];
+    const int32_t span = branch_pc - head;
+    if (span < 0 || span >= HOT_LOOP_MAX_OPS * INST_SIZE_BYTES) {
+        free(trace);
+        return NULL;
+    }
+    for (int32_t i = 0; i <= span; i++) {
+        index_at[i] = LOOP_EXIT;
+    }
+
+    // Predecode the loop - Base instructions only, with the one jump
+    // allowed being a jal back to the head that ends the loop
+    uint32_t written = 0;
+    int32_t addr = head;
+    while (addr <= branch_pc) {
+        loop_op_t* const op = &trace->ops[trace->n_ops];
+        const bool ok = trace->n_ops < HOT_LOOP_MAX_OPS && decode_op(addr, op) &&
+            op->op != LOOP_OP_JALR &&
+            (op->op != LOOP_OP_JAL ||
+             (addr == branch_pc && addr + op->imm == head)) &&
+            (!guard_pages.enabled ||
+             (!IS_LOAD_OP(op->op) && !IS_STORE_OP(op->op)));
+        if (!ok) {
+            free(trace);
+            return NULL;
+        }
+        if (!IS_STORE_OP(op->op) && !IS_BRANCH_OP(op->op)) {
+            written |= 1u << op->rd;
+        }
+        index_at[addr - head] = trace->n_ops++;
+        addr += op->size;
+    }
+
+    // The loop must end with the branch back to the head
+    const loop_op_t* const last = &trace->ops[trace->n_ops - 1];
+    if (last->pc != branch_pc || last->pc + last->imm != head ||
+        (!IS_BRANCH_OP(last->op) && last->op != LOOP_OP_JAL)) {
+        free(trace);
+        return NULL;
+    }
+
+    // Link branches inside the loop, and find accesses whose base register
+    // the loop never writes - Their address is the same every iteration
+    for (int32_t i = 0; i < trace->n_ops; i++) {
+        loop_op_t* const op = &trace->ops[i];
+        if (IS_BRANCH_OP(op->op) || op->op == LOOP_OP_JAL) {
+            const int32_t target = op->pc + op->imm;
+            op->taken = (target >= head && target <= branch_pc) ?
+                        index_at[target - head] : LOOP_EXIT;
+        }
+        op->proven = (IS_LOAD_OP(op->op) || IS_STORE_OP(op->op)) &&
+                     !(written & (1u << op->rs1));
+        trace->has_proven |= op->proven;
+    }
+    return trace;
+}
+
+
+// TRACE EXECUTION ...
+
+/* Returns whether the load / store 'op' of the given address can be done
+   in place - Loads from instruction or data memory, stores to data memory
+*/
+static bool in_place(const loop_op_t* const op, const int32_t addr) {
+    if (IS_LOAD_OP(op->op)) {
+        return (uint32_t)addr <= (uint32_t)(DATA_MEM_END + 1 - op->mem_size);
+    }
+    return (uint32_t)(addr - DATA_MEM_START) <=
+           (uint32_t)(DATA_MEM_SIZE - op->mem_size);
+}
+
+/* Runs the given trace until the loop exits or the trace deoptimises
+
+    RETURNS
+    true  | If the loop exited
+    false | If the trace deoptimised (or couldn't be entered)
+*/
+static bool run_trace(loop_trace_t* const trace) {
+
+    // Hoist the registers
+    int32_t x[NUM_REGISTERS];
+    memcpy(x, registers, sizeof(x));
+    x[ZERO_REGISTER_ADDR] = ZERO_REGISTER_VAL;
+
+    // Validate the accesses whose address never changes once
+    if (trace->has_proven) {
+        for (int32_t i = 0; i < trace->n_ops; i++) {
+            const loop_op_t* const op = &trace->ops[i];
+            if (op->proven && !in_place(op, (int32_t)((uint32_t)x[op->rs1] +
+                                                      (uint32_t)op->imm))) {
+                return false;
+            }
+        }
+    }
+
+    int32_t i = 0;
+    while (true) {
+        const loop_op_t* const op = &trace->ops[i];
+        const int32_t rs1 = x[op->rs1];
+        const int32_t rs2 = x[op->rs2];
+        const int32_t addr = (int32_t)((uint32_t)rs1 + (uint32_t)op->imm);
+        bool taken = false;
+
+        // Deoptimise - The interpreter runs this access (and fetches it)
+        if ((IS_LOAD_OP(op->op) || IS_STORE_OP(op->op)) && !op->proven &&
+            !in_place(op, addr)) {
+            memcpy(registers, x, sizeof(x));
+            pc = op->pc;
+            return false;
+        }
+
+        // Fetch
+        if (op->size == RVC_SIZE_BYTES) {
+            budget.block_compressed++;
+        }
+
+        // Execute - As the interpreter's handlers do (see exec_*)
+        switch (op->op) {
+            case LOOP_OP_ADD:
+                x[op->rd] = (int32_t)((uint32_t)rs1 + (uint32_t)rs2);
+                break;
+            case LOOP_OP_ADDI:
+                x[op->rd] = addr;
+                break;
+            case LOOP_OP_SUB:
+                x[op->rd] = (int32_t)((uint32_t)rs1 - (uint32_t)rs2);
+                break;
+            case LOOP_OP_LUI:
+                x[op->rd] = op->imm;
+                break;
+            case LOOP_OP_XOR:
+                x[op->rd] = rs1 ^ rs2;
+                break;
+            case LOOP_OP_XORI:
+                x[op->rd] = rs1 ^ op->imm;
+                break;
+            case LOOP_OP_OR:
+                x[op->rd] = rs1 | rs2;
+                break;
+            case LOOP_OP_ORI:
+                x[op->rd] = rs1 | op->imm;
+                break;
+            case LOOP_OP_AND:
+                x[op->rd] = rs1 & rs2;
+                break;
+            case LOOP_OP_ANDI:
+                x[op->rd] = rs1 & op->imm;
+                break;
+            case LOOP_OP_SLL:
+                x[op->rd] = (rs2 < 0 || rs2 > REGISTER_SIZE_BITS) ? 0 :
+                    (int32_t)((uint32_t)rs1 << (rs2 & (REGISTER_SIZE_BITS - 1)));
+                break;
+            case LOOP_OP_SRL:
+                x[op->rd] = (rs2 < 0 || rs2 > REGISTER_SIZE_BITS) ? 0 :
+                    (int32_t)((uint32_t)rs1 >> (rs2 & (REGISTER_SIZE_BITS - 1)));
+                break;
+            case LOOP_OP_SRA:
+                if (rs2 < 0) {
+                    x[op->rd] = 0;
+                }
+                else {
+                    const int32_t shift = rs2 % REGISTER_SIZE_BITS;
+                    x[op->rd] = (int32_t)(((uint32_t)rs1 >> shift) |
+                        ((uint32_t)rs1 << ((REGISTER_SIZE_BITS - shift) &
+                                           (REGISTER_SIZE_BITS - 1))));
+                }
+                break;
+            case LOOP_OP_LB: {
+                int8_t value;
+                memcpy(&value, &memory[addr], sizeof(value));
+                x[op->rd] = value;
+                break;
+            }
+            case LOOP_OP_LH: {
+                int16_t value;
+                memcpy(&value, &memory[addr], sizeof(value));
+                x[op->rd] = value;
+                break;
+            }
+            case LOOP_OP_LW: {
+                int32_t value;
+                memcpy(&value, &memory[addr], sizeof(value));
+                x[op->rd] = value;
+                break;
+            }
+            case LOOP_OP_LBU: {
+                uint8_t value;
+                memcpy(&value, &memory[addr], sizeof(value));
+                x[op->rd] = value;
+                break;
+            }
+            case LOOP_OP_LHU: {
+                uint16_t value;
+                memcpy(&value, &memory[addr], sizeof(value));
+                x[op->rd] = value;
+                break;
+            }
+            case LOOP_OP_SB:
+            case LOOP_OP_SH:
+            case LOOP_OP_SW:
+                memcpy(&memory[addr], &rs2, op->mem_size);
+                break;
+            case LOOP_OP_SLT:
+                x[op->rd] = (rs1 < rs2) ? 1 : 0;
+                break;
+            case LOOP_OP_SLTI:
+                x[op->rd] = (rs1 < op->imm) ? 1 : 0;
+                break;
+            case LOOP_OP_SLTU:
+                x[op->rd] = ((uint32_t)rs1 < (uint32_t)rs2) ? 1 : 0;
+                break;
+            case LOOP_OP_SLTIU:
+                x[op->rd] = ((uint32_t)rs1 < (uint32_t)op->imm) ? 1 : 0;
+                break;
+            case LOOP_OP_BEQ:  taken = (rs1 == rs2);                     break;
+            case LOOP_OP_BNE:  taken = (rs1 != rs2);                     break;
+            case LOOP_OP_BLT:  taken = (rs1 < rs2);                      break;
+            case LOOP_OP_BLTU: taken = ((uint32_t)rs1 < (uint32_t)rs2);  break;
+            case LOOP_OP_BGE:  taken = (rs1 >= rs2);                     break;
+            case LOOP_OP_BGEU: taken = ((uint32_t)rs1 >= (uint32_t)rs2); break;
+            case LOOP_OP_JAL:
+                x[op->rd] = op->pc + op->size;
+                taken = true;
+                break;
+        }
+        x[ZERO_REGISTER_ADDR] = ZERO_REGISTER_VAL;
+
+        // Straight line instructions
+        if (!IS_BRANCH_OP(op->op) && op->op != LOOP_OP_JAL) {
+            i++;
+            continue;
+        }
+
+        // Branches end a basic block - The registers are written back
+        // before anything that may throw
+        pc = taken ? op->pc + op->imm : op->pc + op->size;
+        if (!try_end_basic_block(op->pc)) {
+            memcpy(registers, x, sizeof(x));
+            instr_size = op->size;
+            end_basic_block(op->pc);
+        }
+
+        // Go on in the trace, or leave the loop
+        i = taken ? op->taken : i + 1;
+        if (i == LOOP_EXIT || i == trace->n_ops) {
+            memcpy(registers, x, sizeof(x));
+            instr_size = op->size;
+            return true;
+        }
+    }
+}
+
+
+// FUNCTIONS ...
+
+/* Sets up hot loop detection for the given options (a threshold of 0
+   turns it off) - Must be called after the memory image has been read
+*/
+void hot_loops_init(const vm_options_t* const opts) {
+    hot_threshold = opts->hot_loop_threshold;
+    memset(back_edge_counts, 0, sizeof(back_edge_counts));
+    memset(traces, 0, sizeof(traces));
+}
+
+/* Frees every loop trace */
+void hot_loops_deinit() {
+    for (int32_t i = 0; i < INST_MEM_SIZE; i++) {
+        free(traces[i]);
+        traces[i] = NULL;
+    }
+}
+
+/* Counts the taken backward branch or jump at 'branch_pc' towards its loop
+   head (the program counter), tracing the loop once it is hot, then runs
+   the loop's trace if it has one
+
+    * Must be called after the branch has run
+    * Leaves the program counter where the trace exited or deoptimised
+*/
+void hot_loop_back_edge(const int32_t branch_pc) {
+
+    // Count until hot
+    const int32_t head = pc;
+    if (traces[head] == NULL) {
+        if (hot_threshold == 0 ||
+            back_edge_counts[head] == LOOP_UNTRACEABLE ||
+            ++back_edge_counts[head] < hot_threshold) {
+            return;
+        }
+        traces[head] = build_trace(head, branch_pc);
+        if (traces[head] == NULL) {
+            back_edge_counts[head] = LOOP_UNTRACEABLE;
+            return;
+        }
+    }
+
+    // Run the trace - Dropped if the loop keeps leaving it
+    if (!run_trace(traces[head]) && ++traces[head]->deopts > LOOP_MAX_DEOPTS) {
+        free(traces[head]);
+        traces[head] = NULL;
+        back_edge_counts[head] = LOOP_UNTRACEABLE;
+    }
+}
@@ -14,6 +14,8 @@
 // INCLUDE HEADER ...
 #include "instructions.h"
 
+#include <string.h>
+
 
 // FUNCTIONS TO EXTRACT BIT FIELDS FROM INSTRUCTIONS ...
 
@@ -199,6 +201,342 @@ void extract_UJ(instruction_t* const instr, int32_t raw_instr) {
 }
 
 
+// HELPERS ...
+
+/* Returns 'value' rotated left by the low 5 bits of 'shift' */
+static uint32_t rotate_left(const uint32_t value, const uint32_t shift) {
+    const uint32_t n = shift % REGISTER_SIZE_BITS;
+    return (value << n) |
+           (value >> ((REGISTER_SIZE_BITS - n) % REGISTER_SIZE_BITS));
+}
+
+/* Reads memory for the load at the program counter, skipping the checks
+   its memory proof makes unnecessary (see mem_proofs.h)
+*/
+static void proven_mem_read(void* const dst_ptr, const int32_t src_addr,
+                            const int data_size) {
+    switch (mem_proofs[pc]) {
+        case MEM_PROOF_IN_MEMORY:
+            memcpy(dst_ptr, &memory[src_addr], data_size);
+            break;
+        case MEM_PROOF_NOT_VIRTUAL:
+            mem_read_memory(dst_ptr, src_addr, data_size);
+            break;
+        default:
+            mem_read(dst_ptr, src_addr, data_size);
+            break;
+    }
+}
+
+/* Writes memory for the store at the program counter, skipping the checks
+   its memory proof makes unnecessary (see mem_proofs.h)
+*/
+static void proven_mem_write(const void* const src_ptr, const int32_t dst_addr,
+                             const int data_size) {
+    switch (mem_proofs[pc]) {
+        case MEM_PROOF_IN_MEMORY:
+            memcpy(&memory[dst_addr], src_ptr, data_size);
+            break;
+        case MEM_PROOF_NOT_VIRTUAL:
+            mem_write_memory(src_ptr, dst_addr, data_size);
+            break;
+        default:
+            mem_write(src_ptr, dst_addr, data_size);
+            break;
+    }
+}
+
+// Ways a csr instruction can update its csr
+typedef enum {
+    CSR_OP_WRITE, // csrrw, csrrwi
+    CSR_OP_SET,   // csrrs, csrrsi
+    CSR_OP_CLEAR  // csrrc, csrrci
+} csr_op_t;
+
+/* Reads the csr with the given number into 'value'
+
+    Returns false if the csr isn't implemented - The counters need
+    --ext-zicntr and the floating point csrs need --ext-f
+*/
+static bool csr_read(const int32_t csr, uint32_t* const value) {
+
+    // Floating point csrs - fflags and frm are fields of fcsr
+    if (options.ext_f) {
+        switch (csr) {
+            case CSR_FFLAGS:
+                *value = fcsr & FCSR_FFLAGS_MASK;
+                return true;
+            case CSR_FRM:
+                *value = (fcsr >> FCSR_FRM_SHIFT) & FCSR_FRM_MASK;
+                return true;
+            case CSR_FCSR:
+                *value = fcsr;
+                return true;
+        }
+    }
+
+    // Counters - All are derived from the per block budget counts
+    if (options.ext_zicntr) {
+        uint64_t count;
+        switch (csr & ~CSR_HIGH_WORD) {
+            case CSR_CYCLE:
+                count = budget_cycle_count();
+                break;
+            case CSR_TIME:
+                count = budget_time_us();
+                break;
+            case CSR_INSTRET:
+                count = budget_instr_count();
+                break;
+            default:
+                return false;
+        }
+        *value = (uint32_t)((csr & CSR_HIGH_WORD) ? (count >> 32) : count);
+        return true;
+    }
+
+    return false;
+}
+
+/* Writes 'value' to the implemented csr with the given number
+
+    Returns false if the csr is read only (the counters)
+*/
+static bool csr_write(const int32_t csr, const uint32_t value) {
+    switch (csr) {
+        case CSR_FFLAGS:
+            fcsr = (fcsr & ~FCSR_FFLAGS_MASK) | (value & FCSR_FFLAGS_MASK);
+            return true;
+        case CSR_FRM:
+            fcsr = (fcsr & FCSR_FFLAGS_MASK) |
+                   ((value & FCSR_FRM_MASK) << FCSR_FRM_SHIFT);
+            return true;
+        case CSR_FCSR:
+            fcsr = value & FCSR_MASK;
+            return true;
+        default:
+            return false;
+    }
+}
+
+/* Executes a csr instruction - Saves the csr in R[rd] and updates it with
+   'src' as given by 'op'
+
+    * An unimplemented csr is a not implemented error
+    * Writing a read only csr is an illegal operation - csrrs and csrrc
+      (and their imm forms) with rs1 = zero don't write
+*/
+static void exec_csr_op(instruction_t* const instr, const csr_op_t op,
+                        const uint32_t src) {
+
+    // Read the csr
+    const int32_t csr = instr->type_I.imm & CSR_NUM_MASK;
+    uint32_t value;
+    if (!csr_read(csr, &value)) {
+        throw_not_implemented_err();
+        return;
+    }
+
+    // Update the csr
+    if (op == CSR_OP_WRITE || instr->type_I.rs1 != ZERO_REGISTER_ADDR) {
+        const uint32_t new_value = (op == CSR_OP_WRITE) ? src :
+                                   (op == CSR_OP_SET)   ? (value | src) :
+                                                          (value & ~src);
+        if (!csr_write(csr, new_value)) {
+            throw_illegal_operation_err();
+            return;
+        }
+    }
+    registers[instr->type_I.rd] = (int32_t)value;
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+// Host rounding mode for each guest rounding mode (indexed by FRM_*) - The
+//  host has no ties to max magnitude mode, so RMM runs as RNE and the
+//  instructions that can round a tie fix their result up (see
+//  fp_round_ties_away())
+static const int host_round_modes[FRM_RMM + 1] = {
+    FE_TONEAREST, FE_TOWARDZERO, FE_DOWNWARD, FE_UPWARD, FE_TONEAREST
+};
+
+// The host rounding mode last set by fp_begin() - Set lazily, as guests
+//  rarely change rounding mode
+static int host_round_mode = FE_TONEAREST;
+
+/* Returns the raw bits of the given float */
+static uint32_t float_to_bits(const float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+/* Returns the float with the given raw bits */
+static float bits_to_float(const uint32_t bits) {
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/* Returns whether the given raw float bits are a NaN */
+static bool is_nan_bits(const uint32_t bits) {
+    return (bits & ~FP_SIGN_BIT) > FP_EXP_MASK;
+}
+
+/* Returns whether the given raw float bits are a signaling NaN */
+static bool is_snan_bits(const uint32_t bits) {
+    return is_nan_bits(bits) && (bits & FP_QUIET_BIT) == 0;
+}
+
+/* Prepares the host fpu to run a floating point instruction
+
+    * Resolves 'rm' (the func3 field) to a rounding mode - FRM_DYN is the
+      rounding mode in fcsr
+    * Sets the host rounding mode and clears the host exception flags
+    * Returns the rounding mode, or throws an illegal operation error and
+      returns -1 if it is reserved
+*/
+static int32_t fp_begin(int32_t rm) {
+
+    // Resolve the rounding mode
+    if (rm == FRM_DYN) {
+        rm = (fcsr >> FCSR_FRM_SHIFT) & FCSR_FRM_MASK;
+    }
+    if (rm > FRM_RMM) {
+        throw_illegal_operation_err();
+        return -1;
+    }
+
+    // Prepare the host fpu
+    if (host_round_modes[rm] != host_round_mode) {
+        host_round_mode = host_round_modes[rm];
+        fesetround(host_round_mode);
+    }
+    feclearexcept(FE_ALL_EXCEPT);
+    return rm;
+}
+
+/* Adds the host exception flags raised since fp_begin() to fflags */
+static void fp_accrue_flags() {
+    const int raised = fetestexcept(FE_ALL_EXCEPT);
+    fcsr |= ((raised & FE_INEXACT)   ? FFLAG_NX : 0) |
+            ((raised & FE_UNDERFLOW) ? FFLAG_UF : 0) |
+            ((raised & FE_OVERFLOW)  ? FFLAG_OF : 0) |
+            ((raised & FE_DIVBYZERO) ? FFLAG_DZ : 0) |
+            ((raised & FE_INVALID)   ? FFLAG_NV : 0);
+}
+
+/* Saves an arithmetic result in f[rd] and accrues its exception flags -
+   NaN results are replaced with the canonical NaN
+*/
+static void fp_write_result(const int32_t rd, const float result) {
+    const uint32_t bits = float_to_bits(result);
+    fregisters[rd] = is_nan_bits(bits) ? FP_CANONICAL_NAN : bits;
+    fp_accrue_flags();
+}
+
+/* Returns the round to nearest, ties to even 'result' of an instruction
+   rounded to nearest, ties to max magnitude (RMM) instead
+
+    * 'result' must be finite, and 'error' is the exact result minus it -
+      Sums and products of floats are exact as doubles, so the callers
+      find it with double arithmetic, which raises no new host flags
+    * Only a tie rounded towards zero changes - It moves one float away
+*/
+static float fp_round_ties_away(const float result, const double error) {
+
+    // Not a tie rounded towards zero
+    const bool negative = error < 0.0;
+    if (error == 0.0 || (result != 0.0f && negative != (result < 0.0f))) {
+        return result;
+    }
+
+    // The next float away from zero - Exactly twice the error away on a tie
+    const uint32_t away_bits = ((float_to_bits(result) & ~FP_SIGN_BIT) + 1) |
+                               (negative ? FP_SIGN_BIT : 0);
+    const float away = bits_to_float(away_bits);
+    return (fabs(error) * 2.0 == (double)fabsf(away) - fabsf(result)) ?
+        away : result;
+}
+
+/* Returns a * b + c rounded once - Also sets the invalid operation flag for
+   infinity times zero with a quiet NaN addend, which the host doesn't
+*/
+static float fp_fma(const float a, const float b, const float c) {
+    if ((isinf(a) && b == 0.0f) || (a == 0.0f && isinf(b))) {
+        fcsr |= FFLAG_NV;
+    }
+    return fmaf(a, b, c);
+}
+
+/* Returns the exact error of the round to nearest 'result' of a * b + c for
+   fp_round_ties_away(), or 0 if it can't be a tie
+
+    The product is exact as a double, and TwoSum finds the double sum and
+    its rounding error - A sum that isn't exact as a double has bits far
+    below those of the result, so isn't a tie
+*/
+static double fp_fma_error(const float a, const float b, const float c,
+                           const float result) {
+    const double product = (double)a * b;
+    const double sum = product + c;
+    const double c_part = sum - product;
+    const double sum_error = (product - (sum - c_part)) + (c - c_part);
+    return (sum_error == 0.0) ? sum - result : 0.0;
+}
+
+/* Returns the given float rounded to an integer with rounding mode 'rm' -
+   Must follow fp_begin()
+*/
+static float fp_round_to_integer(const float value, const int32_t rm) {
+    return (rm == FRM_RMM) ? roundf(value) : nearbyintf(value);
+}
+
+/* Returns the smaller (or larger if 'max') of the given raw float bits
+
+    * -0 is smaller than +0
+    * If only one is a NaN the other is returned, if both are the canonical
+      NaN is returned
+    * Signaling NaNs set the invalid operation flag
+*/
+static uint32_t fp_min_max(const uint32_t a, const uint32_t b, const bool max) {
+
+    // NaNs
+    if (is_snan_bits(a) || is_snan_bits(b)) {
+        fcsr |= FFLAG_NV;
+    }
+    if (is_nan_bits(a)) {
+        return is_nan_bits(b) ? FP_CANONICAL_NAN : b;
+    }
+    if (is_nan_bits(b)) {
+        return a;
+    }
+
+    // Numbers - Equal numbers only differ in bits for -0 and +0
+    const float fa = bits_to_float(a);
+    const float fb = bits_to_float(b);
+    if (fa == fb) {
+        return max ? (a & b) : (a | b);
+    }
+    return ((fa < fb) != max) ? a : b;
+}
+
+/* Returns whether either of the given raw float bits is a NaN, setting the
+   invalid operation flag if either is a signaling NaN (or any NaN if
+   'signaling')
+*/
+static bool fp_unordered(const uint32_t a, const uint32_t b,
+                         const bool signaling) {
+    if (!is_nan_bits(a) && !is_nan_bits(b)) {
+        return false;
+    }
+    if (signaling || is_snan_bits(a) || is_snan_bits(b)) {
+        fcsr |= FFLAG_NV;
+    }
+    return true;
+}
+
 // FUNCTIONS TO EXECUTE INDIVIDUAL INSTRUCTION CALLS ...
 
 // ARITHMETIC AND LOGIC OPERATIONS
@@ -227,7 +565,7 @@ void exec_add(instruction_t* const instr) {
         registers[instr->type_R.rs1] + registers[instr->type_R.rs2]);
 
     // Increment program counter
-    pc += DFLT_PC_INCREMENT;
+    pc += instr_size;
 }
 
 /* Executes the 'addi' instruction
@@ -253,7 +591,7 @@ void exec_addi(instruction_t* const instr) {
         registers[instr->type_I.rs1] + instr->type_I.imm);
 
     // Increment program counter
-    pc += DFLT_PC_INCREMENT;
+    pc += instr_size;
 }
 
 /* Executes the 'sub' instruction
@@ -273,7 +611,7 @@ void exec_sub(instruction_t* const instr) {
         registers[instr->type_R.rs1] - registers[instr->type_R.rs2]);
 
     // Increment program counter
-    pc += DFLT_PC_INCREMENT;
+    pc += instr_size;
 }
 
 /* Executes the 'lui' instruction
@@ -296,7 +634,7 @@ void exec_lui(instruction_t* const instr) {
     registers[instr->type_U.rd] = instr->type_U.imm;
 
     // Increment program counter
-    pc += DFLT_PC_INCREMENT;
+    pc += instr_size;
 }
 
 /* Executes the 'xor' instruction
@@ -316,7 +654,7 @@ void exec_xor(instruction_t* const instr) {
         registers[instr->type_R.rs1] ^ registers[instr->type_R.rs2]);
 
     // Increment program counter
-    pc += DFLT_PC_INCREMENT;
+    pc += instr_size;
 }
 
 /* Executes the 'xori' instruction
@@ -336,7 +674,7 @@ void exec_xori(instruction_t* const instr) {
         registers[instr->type_I.rs1] ^ instr->type_I.imm);
 
     // Increment program counter
-    pc += DFLT_PC_INCREMENT;
+    pc += instr_size;
 }
 
 /* Executes the 'or' instruction
@@ -356,7 +694,7 @@ void exec_or(instruction_t* const instr) {
         registers[instr->type_R.rs1] | registers[instr->type_R.rs2]); 
 
     // Increment program counter
-    pc += DFLT_PC_INCREMENT;
+    pc += instr_size;
 }
 
 /* Executes the 'ori' instruction
@@ -376,7 +714,7 @@ void exec_ori(instruction_t* const instr) {
         registers[instr->type_I.rs1] | instr->type_I.imm); 
 
     // Increment program counter
-    pc += DFLT_PC_INCREMENT;
+    pc += instr_size;
 }
 
 /* Executes the 'and' instruction
@@ -396,7 +734,7 @@ void exec_and(instruction_t* const instr) {
         registers[instr->type_R.rs1] & registers[instr->type_R.rs2]); 
 
     // Increment program counter
-    pc += DFLT_PC_INCREMENT;
+    pc += instr_size;
 }
 
 /* Executes the 'andi' instruction
@@ -416,7 +754,7 @@ void exec_andi(instruction_t* const instr) {
         registers[instr->type_I.rs1] & instr->type_I.imm);    
 
     // Increment program counter
-    pc += DFLT_PC_INCREMENT;
+    pc += instr_size;
 }
 
 /* Executes the 'sll' instruction
@@ -446,7 +784,7 @@ void exec_sll(instruction_t* const instr) {
     }
 
     // Increment program counter
-    pc += DFLT_PC_INCREMENT;
+    pc += instr_size;
 }
 
 /* Executes the 'srl' instruction
@@ -478,7 +816,7 @@ void exec_srl(instruction_t* const instr) {
     }
 
     // Increment program counter
-    pc += DFLT_PC_INCREMENT;
+    pc += instr_size;
 }
 
 /* Executes the 'sra' instruction
@@ -519,7 +857,7 @@ void exec_sra(instruction_t* const instr) {
     }
 
     // Increment program counter
-    pc += DFLT_PC_INCREMENT;
+    pc += instr_size;
 }
 
 // MEMORY ACCESS OPERATIONS
@@ -539,7 +877,7 @@ void exec_lb(instruction_t* const instr) {
     // Get byte from memory
     signed char raw_byte;
     const int32_t src_addr = registers[instr->type_I.rs1] + instr->type_I.imm;
-    mem_read(&raw_byte, src_addr, 1);
+    proven_mem_read(&raw_byte, src_addr, 1);
 
     // Convert to size of WORD_SIZE_BITS by sign extension
     const int32_t extended_byte = raw_byte;
@@ -548,7 +886,7 @@ void exec_lb(instruction_t* const instr) {
     *(int32_t*)&registers[instr->type_I.rd] = extended_byte;
 
     // Increment program counter
-    pc += DFLT_PC_INCREMENT;
+    pc += instr_size;
 }
 
 /* Executes the 'lh' instruction
@@ -566,7 +904,7 @@ void exec_lh(instruction_t* const instr) {
     // Get half from memory
     int16_t raw_half;
     const int32_t src_addr = registers[instr->type_I.rs1] + instr->type_I.imm;
-    mem_read(&raw_half, src_addr, WORD_SIZE / 2);
+    proven_mem_read(&raw_half, src_addr, WORD_SIZE / 2);
 
     // Convert to size of WORD_SIZE_BITS by sign extension
     const int32_t extended_half = raw_half;
@@ -575,7 +913,7 @@ void exec_lh(instruction_t* const instr) {
     *(int32_t*)&registers[instr->type_I.rd] = extended_half;
 
     // Increment program counter
-    pc += DFLT_PC_INCREMENT;
+    pc += instr_size;
 }
 
 /* Executes the 'lw' instruction
@@ -587,21 +925,23 @@ void exec_lw(instruction_t* const instr) {
 
     // Debugging output
     #ifdef DEBUG_PRINT_INSTRUCTION
+        const byte* const debug_ptr = translate_addr(
+            registers[instr->type_I.rs1] + instr->type_I.imm);
         printf("LW    | R[0x%x] = M[R[0x%x](0x%x) + imm(0x%x)] = 0x%x\n",
         instr->type_I.rd,
         instr->type_I.rs1,
         registers[instr->type_I.rs1],
         instr->type_I.imm,
-        memory[registers[instr->type_I.rs1] + instr->type_I.imm]);
+        (debug_ptr != NULL) ? *debug_ptr : 0);
     #endif
 
     // Execute instruction
     int32_t* const dst_ptr = &registers[instr->type_I.rd];
     const int32_t src_addr = registers[instr->type_I.rs1] + instr->type_I.imm;
-    mem_read(dst_ptr, src_addr, WORD_SIZE);
+    proven_mem_read(dst_ptr, src_addr, WORD_SIZE);
 
     // Increment program counter
-    pc += DFLT_PC_INCREMENT;
+    pc += instr_size;
 }
 
 /* Executes the 'lbu' instruction
@@ -619,7 +959,7 @@ void exec_lbu(instruction_t* const instr) {
     // Get byte from memory
     unsigned char raw_byte;
     const int32_t src_addr = registers[instr->type_I.rs1] + instr->type_I.imm;
-    mem_read(&raw_byte, src_addr, 1);
+    proven_mem_read(&raw_byte, src_addr, 1);
 
     // Convert to size of WORD_SIZE_BITS by zero extension
     const uint32_t extended_byte = raw_byte;
@@ -638,7 +978,7 @@ void exec_lbu(instruction_t* const instr) {
     #endif
 
     // Increment program counter
-    pc += DFLT_PC_INCREMENT;
+    pc += instr_size;
 }
 
 /* Executes the 'lhu' instruction
@@ -656,7 +996,7 @@ void exec_lhu(instruction_t* const instr) {
     // Get half from memory
     uint16_t raw_half;
     const int32_t src_addr = registers[instr->type_I.rs1] + instr->type_I.imm;
-    mem_read(&raw_half, src_addr, WORD_SIZE / 2);
+    proven_mem_read(&raw_half, src_addr, WORD_SIZE / 2);
 
     // Convert to size of WORD_SIZE_BITS by zero extension
     const uint32_t extended_half = raw_half;
@@ -665,7 +1005,7 @@ void exec_lhu(instruction_t* const instr) {
     *(uint32_t*)&registers[instr->type_I.rd] = extended_half;
 
     // Increment program counter
-    pc += DFLT_PC_INCREMENT;
+    pc += instr_size;
 }
 
 /* Executes the 'sb' instruction
@@ -683,10 +1023,10 @@ void exec_sb(instruction_t* const instr) {
     // Execute instruction
     const byte* const src_ptr = (byte*)&registers[instr->type_S.rs2];
     const int32_t dst_addr = registers[instr->type_S.rs1] + instr->type_S.imm;
-    mem_write(src_ptr, dst_addr, 1);
+    proven_mem_write(src_ptr, dst_addr, 1);
 
     // Increment program counter
-    pc += DFLT_PC_INCREMENT;
+    pc += instr_size;
 }
 
 /* Executes the 'sh' instruction
@@ -704,10 +1044,10 @@ void exec_sh(instruction_t* const instr) {
     // Execute instruction
     const int16_t* const src_ptr = (int16_t*)&registers[instr->type_S.rs2];
     const int32_t dst_addr = registers[instr->type_S.rs1] + instr->type_S.imm;
-    mem_write(src_ptr, dst_addr, WORD_SIZE / 2);
+    proven_mem_write(src_ptr, dst_addr, WORD_SIZE / 2);
 
     // Increment program counter
-    pc += DFLT_PC_INCREMENT;
+    pc += instr_size;
 }
 
 /* Executes the 'sw' instruction
@@ -730,10 +1070,10 @@ void exec_sw(instruction_t* const instr) {
     // Execute instruction
     const int32_t* const src_ptr = (int32_t*)&registers[instr->type_S.rs2];
     const int32_t dst_addr = registers[instr->type_S.rs1] + instr->type_S.imm;
-    mem_write(src_ptr, dst_addr, WORD_SIZE);
+    proven_mem_write(src_ptr, dst_addr, WORD_SIZE);
 
     // Increment program counter
-    pc += DFLT_PC_INCREMENT;
+    pc += instr_size;
 }
 
 // PROGRAM FLOW OPERATIONS
@@ -755,7 +1095,7 @@ void exec_slt(instruction_t* const instr) {
         (registers[instr->type_R.rs1] < registers[instr->type_R.rs2]) ? 1 : 0);
 
     // Increment program counter
-    pc += DFLT_PC_INCREMENT;
+    pc += instr_size;
 }
 
 /* Executes the 'slti' instruction
@@ -775,7 +1115,7 @@ void exec_slti(instruction_t* const instr) {
         (registers[instr->type_I.rs1] < instr->type_I.imm) ? 1 : 0);
 
     // Increment program counter
-    pc += DFLT_PC_INCREMENT;
+    pc += instr_size;
 }
 
 /* Executes the 'sltu' instruction
@@ -798,7 +1138,7 @@ void exec_sltu(instruction_t* const instr) {
     registers[instr->type_R.rd] = (rs1 < rs2) ? 1 : 0;
 
     // Increment program counter
-    pc += DFLT_PC_INCREMENT;
+    pc += instr_size;
 }
 
 /* Executes the 'sltiu' instruction
@@ -821,7 +1161,7 @@ void exec_sltiu(instruction_t* const instr) {
     registers[instr->type_I.rd] = (rs1 < rs2) ? 1 : 0;
 
     // Increment program counter
-    pc += DFLT_PC_INCREMENT;
+    pc += instr_size;
 }
 
 /* Executes the 'beq' instruction
@@ -840,6 +1180,9 @@ void exec_beq(instruction_t* const instr) {
         printf("BEQ   |\n");
     #endif
 
+    // Save address of the branch for basic block accounting
+    const int32_t branch_pc = pc;
+
     // Execute instruction
     if (registers[instr->type_SB.rs1] == registers[instr->type_SB.rs2]) {
         pc = pc + instr->type_SB.imm;
@@ -847,8 +1190,11 @@ void exec_beq(instruction_t* const instr) {
 
     // Increment program counter if not branched
     else {
-        pc += DFLT_PC_INCREMENT;
+        pc += instr_size;
     }
+
+    // End of basic block
+    end_basic_block(branch_pc);
 }
 
 /* Executes the 'bne' instruction
@@ -867,6 +1213,9 @@ void exec_bne(instruction_t* const instr) {
         printf("BNE\n");
     #endif
 
+    // Save address of the branch for basic block accounting
+    const int32_t branch_pc = pc;
+
     // Execute instruction
     if (registers[instr->type_SB.rs1] != registers[instr->type_SB.rs2]) {
         pc = pc + instr->type_SB.imm;
@@ -874,8 +1223,11 @@ void exec_bne(instruction_t* const instr) {
 
     // Increment program counter if not branched
     else {
-        pc += DFLT_PC_INCREMENT;
+        pc += instr_size;
     }
+
+    // End of basic block
+    end_basic_block(branch_pc);
 }
 
 /* Executes the 'blt' instruction
@@ -894,6 +1246,9 @@ void exec_blt(instruction_t* const instr) {
         printf("BLT\n");
     #endif
 
+    // Save address of the branch for basic block accounting
+    const int32_t branch_pc = pc;
+
     // Execute instruction
     if (registers[instr->type_SB.rs1] < registers[instr->type_SB.rs2]) {
         pc = pc + instr->type_SB.imm;
@@ -901,8 +1256,11 @@ void exec_blt(instruction_t* const instr) {
     
     // Increment program counter if not branched
     else {
-        pc += DFLT_PC_INCREMENT;
+        pc += instr_size;
     }
+
+    // End of basic block
+    end_basic_block(branch_pc);
 }
 
 /* Executes the 'bltu' instruction
@@ -921,6 +1279,9 @@ void exec_bltu(instruction_t* const instr) {
         printf("BLTU\n");
     #endif
 
+    // Save address of the branch for basic block accounting
+    const int32_t branch_pc = pc;
+
     // Cast to uint32 to treat as unsigned
     const uint32_t rs1 = *(uint32_t*)&registers[instr->type_SB.rs1];
     const uint32_t rs2 = *(uint32_t*)&registers[instr->type_SB.rs2];
@@ -932,8 +1293,11 @@ void exec_bltu(instruction_t* const instr) {
 
     // Increment program counter if not branched
     else {
-        pc += DFLT_PC_INCREMENT;
+        pc += instr_size;
     }
+
+    // End of basic block
+    end_basic_block(branch_pc);
 }
 
 /* Executes the 'bge' instruction
@@ -952,6 +1316,9 @@ void exec_bge(instruction_t* const instr) {
         printf("BGE\n");
     #endif
 
+    // Save address of the branch for basic block accounting
+    const int32_t branch_pc = pc;
+
     // Execute instruction
     if (registers[instr->type_SB.rs1] >= registers[instr->type_SB.rs2]) {
         pc = pc + instr->type_SB.imm;
@@ -959,8 +1326,11 @@ void exec_bge(instruction_t* const instr) {
 
     // Increment program counter if not branched
     else {
-        pc += DFLT_PC_INCREMENT;
+        pc += instr_size;
     }
+
+    // End of basic block
+    end_basic_block(branch_pc);
 }
 
 /* Executes the 'bgeu' instruction
@@ -979,6 +1349,9 @@ void exec_bgeu(instruction_t* const instr) {
         printf("BGEU\n");
     #endif
 
+    // Save address of the branch for basic block accounting
+    const int32_t branch_pc = pc;
+
     // Cast to uint32 to treat as unsigned
     const uint32_t r1 = *(uint32_t*)&registers[instr->type_SB.rs1];
     const uint32_t r2 = *(uint32_t*)&registers[instr->type_SB.rs2];
@@ -990,8 +1363,11 @@ void exec_bgeu(instruction_t* const instr) {
     
     // Increment program counter if not branched
     else {
-        pc += DFLT_PC_INCREMENT;
+        pc += instr_size;
     }
+
+    // End of basic block
+    end_basic_block(branch_pc);
 }
 
 /* Executes the 'jal' instruction
@@ -1009,21 +1385,28 @@ void exec_jal(instruction_t* const instr) {
 
     // Debugging output
     #ifdef DEBUG_PRINT_INSTRUCTION
-        printf("JAL   | R[0x%x] = pc(0x%x) + 0x4 = 0x%x\n",
+        printf("JAL   | R[0x%x] = pc(0x%x) + 0x%x = 0x%x\n",
             instr->type_UJ.rd,
             pc,
-            pc + DFLT_PC_INCREMENT);
+            instr_size,
+            pc + instr_size);
         printf("      | pc = pc(0x%x) + imm(0x%x) = 0x%x\n",
             pc,
             instr->type_UJ.imm,
             pc + instr->type_UJ.imm);
     #endif
 
+    // Save address of the jump for basic block accounting
+    const int32_t branch_pc = pc;
+
     // Save next pc into rd
-    registers[instr->type_UJ.rd] = pc + DFLT_PC_INCREMENT;
+    registers[instr->type_UJ.rd] = pc + instr_size;
 
     // Jump
     pc = pc + instr->type_UJ.imm;
+
+    // End of basic block
+    end_basic_block(branch_pc);
 }
 
 /* Executes the 'jalr' instruction
@@ -1042,147 +1425,1580 @@ void exec_jalr(instruction_t* const instr) {
         printf("JALR  |\n");
     #endif
 
+    // Save address of the jump for basic block accounting
+    const int32_t branch_pc = pc;
+
     // Save next pc into rd
-    registers[instr->type_I.rd] = pc + DFLT_PC_INCREMENT;
+    registers[instr->type_I.rd] = pc + instr_size;
 
     // Jump
     pc = registers[instr->type_I.rs1] + instr->type_I.imm;
+
+    // Landing where the memory access analysis didn't follow the jump
+    // voids its proofs
+    if ((uint32_t)pc < INST_MEM_SIZE && mem_proof_voiding_targets[pc]) {
+        mem_proofs_void();
+    }
+
+    // End of basic block
+    end_basic_block(branch_pc);
 }
 
 
-// INSTRUCTION PARSER AND EXECUTOR ...
+// MULTIPLY AND DIVIDE OPERATIONS (RV32M - only decoded with --ext-m)
 
-/* Determines which instruction was given and executes accordingly
+/* Executes the 'mul' instruction
+    Uses the given 'instr' data to execute the 'mul' instruction.
+    Format    | R
+    Operation | R[rd] = (R[rs1] * R[rs2])[31:0]
+*/
+void exec_mul(instruction_t* const instr) {
 
-    Prints appropriate error message on error
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("MUL\n");
+    #endif
 
-    RETURNS 
-    0  | On success
-    -1 | On error
+    // Execute instruction - Low 32 bits are the same signed or unsigned
+    registers[instr->type_R.rd] = (int32_t)(
+        (uint32_t)registers[instr->type_R.rs1] *
+        (uint32_t)registers[instr->type_R.rs2]);
 
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'mulh' instruction
+    Uses the given 'instr' data to execute the 'mulh' instruction.
+    Format    | R
+    Operation | R[rd] = (sext(R[rs1]) * sext(R[rs2]))[63:32]
 */
-void exec_instruction(const int32_t instr) {
-    
-    // Declare struct to store unpacked instruction data
-    instruction_t parsed_instr;
+void exec_mulh(instruction_t* const instr) {
 
-    // add
-    if (INSTR_MATCH(instr, ID_EXTRACT_MASK_3, ADD_ID_BITS)) {
-        extract_R(&parsed_instr, instr);
-        exec_add(&parsed_instr);
-    } 
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("MULH\n");
+    #endif
 
-    // addi
-    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_2, ADDI_ID_BITS)) {
-        extract_I(&parsed_instr, instr);
-        exec_addi(&parsed_instr);
-    } 
-    
-    // sub
-    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_3, SUB_ID_BITS)) {
-        extract_R(&parsed_instr, instr);
-        exec_sub(&parsed_instr);
-    }
+    // Execute instruction - Full 64 bit product, keep the upper word
+    const int64_t product = (
+        (int64_t)registers[instr->type_R.rs1] *
+        (int64_t)registers[instr->type_R.rs2]);
+    registers[instr->type_R.rd] = (int32_t)((uint64_t)product >> 32);
 
-    // lui
-    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_1, LUI_ID_BITS)) {
-        extract_U(&parsed_instr, instr);
-        exec_lui(&parsed_instr);
-    }
+    // Increment program counter
+    pc += instr_size;
+}
 
-    // xor
-    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_3, XOR_ID_BITS)) {
-        extract_R(&parsed_instr, instr);
-        exec_xor(&parsed_instr);
-    }
+/* Executes the 'mulhsu' instruction
+    Uses the given 'instr' data to execute the 'mulhsu' instruction.
+    Format    | R
+    Operation | R[rd] = (sext(R[rs1]) * zext(R[rs2]))[63:32]
+*/
+void exec_mulhsu(instruction_t* const instr) {
 
-    // xori
-    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_2, XORI_ID_BITS)) {
-        extract_I(&parsed_instr, instr);
-        exec_xori(&parsed_instr);
-    }
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("MULHSU\n");
+    #endif
 
-    // or
-    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_3, OR_ID_BITS)) {
-        extract_R(&parsed_instr, instr);
-        exec_or(&parsed_instr);
-    }
+    // Execute instruction - Signed x unsigned always fits in 64 bits
+    const int64_t product = (
+        (int64_t)registers[instr->type_R.rs1] *
+        (int64_t)(uint32_t)registers[instr->type_R.rs2]);
+    registers[instr->type_R.rd] = (int32_t)((uint64_t)product >> 32);
 
-    // ori
-    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_2, ORI_ID_BITS)) {
-        extract_I(&parsed_instr, instr);
-        exec_ori(&parsed_instr);
-    }
+    // Increment program counter
+    pc += instr_size;
+}
 
-    // and
-    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_3, AND_ID_BITS)) {
-        extract_R(&parsed_instr, instr);
-        exec_and(&parsed_instr);
-    }
+/* Executes the 'mulhu' instruction
+    Uses the given 'instr' data to execute the 'mulhu' instruction.
+    Format    | R
+    Operation | R[rd] = (zext(R[rs1]) * zext(R[rs2]))[63:32]
+*/
+void exec_mulhu(instruction_t* const instr) {
 
-    // andi
-    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_2, ANDI_ID_BITS)) {
-        extract_I(&parsed_instr, instr);
-        exec_andi(&parsed_instr);
-    }
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("MULHU\n");
+    #endif
 
-    // sll
-    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_3, SLL_ID_BITS)) {
-        extract_R(&parsed_instr, instr);
-        exec_sll(&parsed_instr);
-    }
+    // Execute instruction - Full 64 bit product, keep the upper word
+    const uint64_t product = (
+        (uint64_t)(uint32_t)registers[instr->type_R.rs1] *
+        (uint64_t)(uint32_t)registers[instr->type_R.rs2]);
+    registers[instr->type_R.rd] = (int32_t)(product >> 32);
 
-    // srl
-    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_3, SRL_ID_BITS)) {
-        extract_R(&parsed_instr, instr);
-        exec_srl(&parsed_instr);
-    }
+    // Increment program counter
+    pc += instr_size;
+}
 
-    // sra
-    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_3, SRA_ID_BITS)) {
-        extract_R(&parsed_instr, instr);
-        exec_sra(&parsed_instr);
-    }
+/* Executes the 'div' instruction
+    Uses the given 'instr' data to execute the 'div' instruction.
+    Format    | R
+    Operation | R[rd] = R[rs1] / R[rs2] (rounded towards zero)
+*/
+void exec_div(instruction_t* const instr) {
 
-    // lb
-    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_2, LB_ID_BITS)) {
-        extract_I(&parsed_instr, instr);
-        exec_lb(&parsed_instr);
-    }
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("DIV\n");
+    #endif
 
-    // lh
-    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_2, LH_ID_BITS)) {
-        extract_I(&parsed_instr, instr);
-        exec_lh(&parsed_instr);
-    }
+    const int32_t rs1 = registers[instr->type_R.rs1];
+    const int32_t rs2 = registers[instr->type_R.rs2];
 
-    // lw
-    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_2, LW_ID_BITS)) {
-        extract_I(&parsed_instr, instr);
-        exec_lw(&parsed_instr);
+    // Divide by zero gives all bits set, overflow gives the dividend
+    if (rs2 == 0) {
+        registers[instr->type_R.rd] = -1;
     }
-
-    // lbu
-    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_2, LBU_ID_BITS)) {
-        extract_I(&parsed_instr, instr);
-        exec_lbu(&parsed_instr);
+    else if (rs1 == INT32_MIN && rs2 == -1) {
+        registers[instr->type_R.rd] = INT32_MIN;
     }
 
-    // lhu
-    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_2, LHU_ID_BITS)) {
-        extract_I(&parsed_instr, instr);
-        exec_lhu(&parsed_instr);
+    // Execute instruction if no special case - C also rounds towards zero
+    else {
+        registers[instr->type_R.rd] = rs1 / rs2;
     }
 
-    // sb
-    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_2, SB_ID_BITS)) {
-        extract_S(&parsed_instr, instr);
-        exec_sb(&parsed_instr);
-    }
+    // Increment program counter
+    pc += instr_size;
+}
 
-    // sh
-    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_2, SH_ID_BITS)) {
-        extract_S(&parsed_instr, instr);
+/* Executes the 'divu' instruction
+    Uses the given 'instr' data to execute the 'divu' instruction.
+    Format    | R
+    Operation | R[rd] = R[rs1] / R[rs2] (unsigned)
+*/
+void exec_divu(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("DIVU\n");
+    #endif
+
+    const uint32_t rs1 = (uint32_t)registers[instr->type_R.rs1];
+    const uint32_t rs2 = (uint32_t)registers[instr->type_R.rs2];
+
+    // Divide by zero gives all bits set
+    registers[instr->type_R.rd] = (int32_t)((rs2 == 0) ? UINT32_MAX : rs1 / rs2);
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'rem' instruction
+    Uses the given 'instr' data to execute the 'rem' instruction.
+    Format    | R
+    Operation | R[rd] = R[rs1] % R[rs2] (sign of R[rs1])
+*/
+void exec_rem(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("REM\n");
+    #endif
+
+    const int32_t rs1 = registers[instr->type_R.rs1];
+    const int32_t rs2 = registers[instr->type_R.rs2];
+
+    // Divide by zero gives the dividend, overflow gives zero
+    if (rs2 == 0) {
+        registers[instr->type_R.rd] = rs1;
+    }
+    else if (rs1 == INT32_MIN && rs2 == -1) {
+        registers[instr->type_R.rd] = 0;
+    }
+
+    // Execute instruction if no special case
+    else {
+        registers[instr->type_R.rd] = rs1 % rs2;
+    }
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'remu' instruction
+    Uses the given 'instr' data to execute the 'remu' instruction.
+    Format    | R
+    Operation | R[rd] = R[rs1] % R[rs2] (unsigned)
+*/
+void exec_remu(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("REMU\n");
+    #endif
+
+    const uint32_t rs1 = (uint32_t)registers[instr->type_R.rs1];
+    const uint32_t rs2 = (uint32_t)registers[instr->type_R.rs2];
+
+    // Divide by zero gives the dividend
+    registers[instr->type_R.rd] = (int32_t)((rs2 == 0) ? rs1 : rs1 % rs2);
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+// ADDRESS GENERATION OPERATIONS (ZBA - only decoded with --ext-zba)
+
+/* Executes the 'sh1add' instruction
+    Uses the given 'instr' data to execute the 'sh1add' instruction.
+    Format    | R
+    Operation | R[rd] = R[rs2] + (R[rs1] « 1)
+*/
+void exec_sh1add(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("SH1ADD\n");
+    #endif
+
+    // Execute instruction
+    registers[instr->type_R.rd] = (int32_t)(
+        (uint32_t)registers[instr->type_R.rs2] +
+        ((uint32_t)registers[instr->type_R.rs1] << 1));
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'sh2add' instruction
+    Uses the given 'instr' data to execute the 'sh2add' instruction.
+    Format    | R
+    Operation | R[rd] = R[rs2] + (R[rs1] « 2)
+*/
+void exec_sh2add(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("SH2ADD\n");
+    #endif
+
+    // Execute instruction
+    registers[instr->type_R.rd] = (int32_t)(
+        (uint32_t)registers[instr->type_R.rs2] +
+        ((uint32_t)registers[instr->type_R.rs1] << 2));
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'sh3add' instruction
+    Uses the given 'instr' data to execute the 'sh3add' instruction.
+    Format    | R
+    Operation | R[rd] = R[rs2] + (R[rs1] « 3)
+*/
+void exec_sh3add(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("SH3ADD\n");
+    #endif
+
+    // Execute instruction
+    registers[instr->type_R.rd] = (int32_t)(
+        (uint32_t)registers[instr->type_R.rs2] +
+        ((uint32_t)registers[instr->type_R.rs1] << 3));
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+// BIT MANIPULATION OPERATIONS (ZBB - only decoded with --ext-zbb)
+
+/* Executes the 'andn' instruction
+    Uses the given 'instr' data to execute the 'andn' instruction.
+    Format    | R
+    Operation | R[rd] = R[rs1] & ~R[rs2]
+*/
+void exec_andn(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("ANDN\n");
+    #endif
+
+    // Execute instruction
+    registers[instr->type_R.rd] = (
+        registers[instr->type_R.rs1] & ~registers[instr->type_R.rs2]);
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'orn' instruction
+    Uses the given 'instr' data to execute the 'orn' instruction.
+    Format    | R
+    Operation | R[rd] = R[rs1] | ~R[rs2]
+*/
+void exec_orn(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("ORN\n");
+    #endif
+
+    // Execute instruction
+    registers[instr->type_R.rd] = (
+        registers[instr->type_R.rs1] | ~registers[instr->type_R.rs2]);
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'xnor' instruction
+    Uses the given 'instr' data to execute the 'xnor' instruction.
+    Format    | R
+    Operation | R[rd] = ~(R[rs1] ˆ R[rs2])
+*/
+void exec_xnor(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("XNOR\n");
+    #endif
+
+    // Execute instruction
+    registers[instr->type_R.rd] = ~(
+        registers[instr->type_R.rs1] ^ registers[instr->type_R.rs2]);
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'clz' instruction
+    Uses the given 'instr' data to execute the 'clz' instruction.
+    Format    | I
+    Operation | R[rd] = number of leading zero bits in R[rs1]
+*/
+void exec_clz(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("CLZ\n");
+    #endif
+
+    // Execute instruction - The builtin is undefined for zero
+    const uint32_t rs1 = (uint32_t)registers[instr->type_I.rs1];
+    registers[instr->type_I.rd] = (
+        (rs1 == 0) ? REGISTER_SIZE_BITS : __builtin_clz(rs1));
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'ctz' instruction
+    Uses the given 'instr' data to execute the 'ctz' instruction.
+    Format    | I
+    Operation | R[rd] = number of trailing zero bits in R[rs1]
+*/
+void exec_ctz(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("CTZ\n");
+    #endif
+
+    // Execute instruction - The builtin is undefined for zero
+    const uint32_t rs1 = (uint32_t)registers[instr->type_I.rs1];
+    registers[instr->type_I.rd] = (
+        (rs1 == 0) ? REGISTER_SIZE_BITS : __builtin_ctz(rs1));
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'cpop' instruction
+    Uses the given 'instr' data to execute the 'cpop' instruction.
+    Format    | I
+    Operation | R[rd] = number of set bits in R[rs1]
+*/
+void exec_cpop(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("CPOP\n");
+    #endif
+
+    // Execute instruction
+    registers[instr->type_I.rd] = __builtin_popcount(
+        (uint32_t)registers[instr->type_I.rs1]);
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'sext.b' instruction
+    Uses the given 'instr' data to execute the 'sext.b' instruction.
+    Format    | I
+    Operation | R[rd] = sext(R[rs1][7:0])
+*/
+void exec_sext_b(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("SEXT.B\n");
+    #endif
+
+    // Execute instruction
+    registers[instr->type_I.rd] = (int8_t)registers[instr->type_I.rs1];
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'sext.h' instruction
+    Uses the given 'instr' data to execute the 'sext.h' instruction.
+    Format    | I
+    Operation | R[rd] = sext(R[rs1][15:0])
+*/
+void exec_sext_h(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("SEXT.H\n");
+    #endif
+
+    // Execute instruction
+    registers[instr->type_I.rd] = (int16_t)registers[instr->type_I.rs1];
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'zext.h' instruction
+    Uses the given 'instr' data to execute the 'zext.h' instruction.
+    Format    | R
+    Operation | R[rd] = zext(R[rs1][15:0])
+*/
+void exec_zext_h(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("ZEXT.H\n");
+    #endif
+
+    // Execute instruction
+    registers[instr->type_R.rd] = (uint16_t)registers[instr->type_R.rs1];
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'min' instruction
+    Uses the given 'instr' data to execute the 'min' instruction.
+    Format    | R
+    Operation | R[rd] = (R[rs1] < R[rs2]) ? R[rs1] : R[rs2]
+*/
+void exec_min(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("MIN\n");
+    #endif
+
+    // Execute instruction
+    const int32_t rs1 = registers[instr->type_R.rs1];
+    const int32_t rs2 = registers[instr->type_R.rs2];
+    registers[instr->type_R.rd] = (rs1 < rs2) ? rs1 : rs2;
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'minu' instruction
+    Uses the given 'instr' data to execute the 'minu' instruction.
+    Format    | R
+    Operation | R[rd] = (R[rs1] < R[rs2]) ? R[rs1] : R[rs2] (unsigned)
+*/
+void exec_minu(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("MINU\n");
+    #endif
+
+    // Execute instruction
+    const uint32_t rs1 = (uint32_t)registers[instr->type_R.rs1];
+    const uint32_t rs2 = (uint32_t)registers[instr->type_R.rs2];
+    registers[instr->type_R.rd] = (int32_t)((rs1 < rs2) ? rs1 : rs2);
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'max' instruction
+    Uses the given 'instr' data to execute the 'max' instruction.
+    Format    | R
+    Operation | R[rd] = (R[rs1] > R[rs2]) ? R[rs1] : R[rs2]
+*/
+void exec_max(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("MAX\n");
+    #endif
+
+    // Execute instruction
+    const int32_t rs1 = registers[instr->type_R.rs1];
+    const int32_t rs2 = registers[instr->type_R.rs2];
+    registers[instr->type_R.rd] = (rs1 > rs2) ? rs1 : rs2;
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'maxu' instruction
+    Uses the given 'instr' data to execute the 'maxu' instruction.
+    Format    | R
+    Operation | R[rd] = (R[rs1] > R[rs2]) ? R[rs1] : R[rs2] (unsigned)
+*/
+void exec_maxu(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("MAXU\n");
+    #endif
+
+    // Execute instruction
+    const uint32_t rs1 = (uint32_t)registers[instr->type_R.rs1];
+    const uint32_t rs2 = (uint32_t)registers[instr->type_R.rs2];
+    registers[instr->type_R.rd] = (int32_t)((rs1 > rs2) ? rs1 : rs2);
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'rol' instruction
+    Uses the given 'instr' data to execute the 'rol' instruction.
+    Format    | R
+    Operation | R[rd] = R[rs1] rotated left by R[rs2][4:0]
+*/
+void exec_rol(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("ROL\n");
+    #endif
+
+    // Execute instruction
+    registers[instr->type_R.rd] = (int32_t)rotate_left(
+        (uint32_t)registers[instr->type_R.rs1],
+        (uint32_t)registers[instr->type_R.rs2]);
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'ror' instruction
+    Uses the given 'instr' data to execute the 'ror' instruction.
+    Format    | R
+    Operation | R[rd] = R[rs1] rotated right by R[rs2][4:0]
+*/
+void exec_ror(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("ROR\n");
+    #endif
+
+    // Execute instruction
+    registers[instr->type_R.rd] = (int32_t)rotate_left(
+        (uint32_t)registers[instr->type_R.rs1],
+        -(uint32_t)registers[instr->type_R.rs2]);
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'rori' instruction
+    Uses the given 'instr' data to execute the 'rori' instruction.
+    Format    | I
+    Operation | R[rd] = R[rs1] rotated right by imm[4:0]
+*/
+void exec_rori(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("RORI\n");
+    #endif
+
+    // Execute instruction - The shift amount is the low bits of imm
+    registers[instr->type_I.rd] = (int32_t)rotate_left(
+        (uint32_t)registers[instr->type_I.rs1],
+        -(uint32_t)instr->type_I.imm);
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'orc.b' instruction
+    Uses the given 'instr' data to execute the 'orc.b' instruction.
+    Format    | I
+    Operation | R[rd][8i+7:8i] = (R[rs1][8i+7:8i] != 0) ? 0xFF : 0x00
+*/
+void exec_orc_b(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("ORC.B\n");
+    #endif
+
+    // Execute instruction - Adding 0x7F to the low 7 bits of each byte
+    // carries into its top bit exactly when one of those bits is set
+    const uint32_t rs1 = (uint32_t)registers[instr->type_I.rs1];
+    const uint32_t top_bits = (
+        ((rs1 & 0x7F7F7F7F) + 0x7F7F7F7F) | rs1) & 0x80808080;
+    registers[instr->type_I.rd] = (int32_t)((top_bits >> 7) * 0xFF);
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'rev8' instruction
+    Uses the given 'instr' data to execute the 'rev8' instruction.
+    Format    | I
+    Operation | R[rd] = R[rs1] with its byte order reversed
+*/
+void exec_rev8(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("REV8\n");
+    #endif
+
+    // Execute instruction
+    registers[instr->type_I.rd] = (int32_t)__builtin_bswap32(
+        (uint32_t)registers[instr->type_I.rs1]);
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+// CONTROL AND STATUS REGISTER OPERATIONS (ZICSR - only decoded with
+//  --ext-zicntr or --ext-f)
+
+/* Executes the 'csrrw' instruction
+    Uses the given 'instr' data to execute the 'csrrw' instruction.
+    Format    | I
+    Operation | R[rd] = CSR[imm], CSR[imm] = R[rs1]
+*/
+void exec_csrrw(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("CSRRW\n");
+    #endif
+
+    // Execute instruction
+    exec_csr_op(instr, CSR_OP_WRITE, (uint32_t)registers[instr->type_I.rs1]);
+}
+
+/* Executes the 'csrrs' instruction
+    Uses the given 'instr' data to execute the 'csrrs' instruction.
+    Format    | I
+    Operation | R[rd] = CSR[imm], CSR[imm] = CSR[imm] | R[rs1]
+*/
+void exec_csrrs(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("CSRRS\n");
+    #endif
+
+    // Execute instruction
+    exec_csr_op(instr, CSR_OP_SET, (uint32_t)registers[instr->type_I.rs1]);
+}
+
+/* Executes the 'csrrc' instruction
+    Uses the given 'instr' data to execute the 'csrrc' instruction.
+    Format    | I
+    Operation | R[rd] = CSR[imm], CSR[imm] = CSR[imm] & ~R[rs1]
+*/
+void exec_csrrc(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("CSRRC\n");
+    #endif
+
+    // Execute instruction
+    exec_csr_op(instr, CSR_OP_CLEAR, (uint32_t)registers[instr->type_I.rs1]);
+}
+
+/* Executes the 'csrrwi' instruction
+    Uses the given 'instr' data to execute the 'csrrwi' instruction.
+    Format    | I
+    Operation | R[rd] = CSR[imm], CSR[imm] = uimm (the rs1 field)
+*/
+void exec_csrrwi(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("CSRRWI\n");
+    #endif
+
+    // Execute instruction
+    exec_csr_op(instr, CSR_OP_WRITE, (uint32_t)instr->type_I.rs1);
+}
+
+/* Executes the 'csrrsi' instruction
+    Uses the given 'instr' data to execute the 'csrrsi' instruction.
+    Format    | I
+    Operation | R[rd] = CSR[imm], CSR[imm] = CSR[imm] | uimm (the rs1 field)
+*/
+void exec_csrrsi(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("CSRRSI\n");
+    #endif
+
+    // Execute instruction
+    exec_csr_op(instr, CSR_OP_SET, (uint32_t)instr->type_I.rs1);
+}
+
+/* Executes the 'csrrci' instruction
+    Uses the given 'instr' data to execute the 'csrrci' instruction.
+    Format    | I
+    Operation | R[rd] = CSR[imm], CSR[imm] = CSR[imm] & ~uimm (the rs1 field)
+*/
+void exec_csrrci(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("CSRRCI\n");
+    #endif
+
+    // Execute instruction
+    exec_csr_op(instr, CSR_OP_CLEAR, (uint32_t)instr->type_I.rs1);
+}
+
+// SINGLE PRECISION FLOATING POINT OPERATIONS (RV32F - only decoded with
+//  --ext-f)
+
+/* Executes the 'flw' instruction
+    Uses the given 'instr' data to execute the 'flw' instruction.
+    Format    | I
+    Operation | F[rd] = M[R[rs1] + imm]
+*/
+void exec_flw(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("FLW\n");
+    #endif
+
+    // Execute instruction
+    uint32_t* const dst_ptr = &fregisters[instr->type_I.rd];
+    const int32_t src_addr = registers[instr->type_I.rs1] + instr->type_I.imm;
+    mem_read(dst_ptr, src_addr, WORD_SIZE);
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'fsw' instruction
+    Uses the given 'instr' data to execute the 'fsw' instruction.
+    Format    | S
+    Operation | M[R[rs1] + imm] = F[rs2]
+*/
+void exec_fsw(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("FSW\n");
+    #endif
+
+    // Execute instruction
+    const uint32_t* const src_ptr = &fregisters[instr->type_S.rs2];
+    const int32_t dst_addr = registers[instr->type_S.rs1] + instr->type_S.imm;
+    mem_write(src_ptr, dst_addr, WORD_SIZE);
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'fmadd.s' instruction
+    Uses the given 'instr' data to execute the 'fmadd.s' instruction.
+    Format    | R4
+    Operation | F[rd] = F[rs1] * F[rs2] + F[rs3] (rounded once)
+*/
+void exec_fmadd_s(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("FMADD.S\n");
+    #endif
+
+    // Execute instruction - Operands are read after the host fpu is set up
+    const int32_t rm = fp_begin(instr->type_R.func3);
+    if (rm < 0) {
+        return;
+    }
+    const int32_t rs3 = instr->type_R.func7 >> R4_RS3_SHIFT;
+    const float a = bits_to_float(fregisters[instr->type_R.rs1]);
+    const float b = bits_to_float(fregisters[instr->type_R.rs2]);
+    const float c = bits_to_float(fregisters[rs3]);
+    const float result = fp_fma(a, b, c);
+    fp_write_result(instr->type_R.rd, (rm == FRM_RMM && isfinite(result)) ?
+        fp_round_ties_away(result, fp_fma_error(a, b, c, result)) : result);
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'fmsub.s' instruction
+    Uses the given 'instr' data to execute the 'fmsub.s' instruction.
+    Format    | R4
+    Operation | F[rd] = F[rs1] * F[rs2] - F[rs3] (rounded once)
+*/
+void exec_fmsub_s(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("FMSUB.S\n");
+    #endif
+
+    // Execute instruction - Operands are read after the host fpu is set up
+    const int32_t rm = fp_begin(instr->type_R.func3);
+    if (rm < 0) {
+        return;
+    }
+    const int32_t rs3 = instr->type_R.func7 >> R4_RS3_SHIFT;
+    const float a = bits_to_float(fregisters[instr->type_R.rs1]);
+    const float b = bits_to_float(fregisters[instr->type_R.rs2]);
+    const float c = -bits_to_float(fregisters[rs3]);
+    const float result = fp_fma(a, b, c);
+    fp_write_result(instr->type_R.rd, (rm == FRM_RMM && isfinite(result)) ?
+        fp_round_ties_away(result, fp_fma_error(a, b, c, result)) : result);
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'fnmsub.s' instruction
+    Uses the given 'instr' data to execute the 'fnmsub.s' instruction.
+    Format    | R4
+    Operation | F[rd] = -(F[rs1] * F[rs2]) + F[rs3] (rounded once)
+*/
+void exec_fnmsub_s(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("FNMSUB.S\n");
+    #endif
+
+    // Execute instruction - Operands are read after the host fpu is set up
+    const int32_t rm = fp_begin(instr->type_R.func3);
+    if (rm < 0) {
+        return;
+    }
+    const int32_t rs3 = instr->type_R.func7 >> R4_RS3_SHIFT;
+    const float a = -bits_to_float(fregisters[instr->type_R.rs1]);
+    const float b = bits_to_float(fregisters[instr->type_R.rs2]);
+    const float c = bits_to_float(fregisters[rs3]);
+    const float result = fp_fma(a, b, c);
+    fp_write_result(instr->type_R.rd, (rm == FRM_RMM && isfinite(result)) ?
+        fp_round_ties_away(result, fp_fma_error(a, b, c, result)) : result);
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'fnmadd.s' instruction
+    Uses the given 'instr' data to execute the 'fnmadd.s' instruction.
+    Format    | R4
+    Operation | F[rd] = -(F[rs1] * F[rs2]) - F[rs3] (rounded once)
+*/
+void exec_fnmadd_s(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("FNMADD.S\n");
+    #endif
+
+    // Execute instruction - Operands are read after the host fpu is set up
+    const int32_t rm = fp_begin(instr->type_R.func3);
+    if (rm < 0) {
+        return;
+    }
+    const int32_t rs3 = instr->type_R.func7 >> R4_RS3_SHIFT;
+    const float a = -bits_to_float(fregisters[instr->type_R.rs1]);
+    const float b = bits_to_float(fregisters[instr->type_R.rs2]);
+    const float c = -bits_to_float(fregisters[rs3]);
+    const float result = fp_fma(a, b, c);
+    fp_write_result(instr->type_R.rd, (rm == FRM_RMM && isfinite(result)) ?
+        fp_round_ties_away(result, fp_fma_error(a, b, c, result)) : result);
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'fadd.s' instruction
+    Uses the given 'instr' data to execute the 'fadd.s' instruction.
+    Format    | R
+    Operation | F[rd] = F[rs1] + F[rs2]
+*/
+void exec_fadd_s(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("FADD.S\n");
+    #endif
+
+    // Execute instruction - Operands are read after the host fpu is set up
+    const int32_t rm = fp_begin(instr->type_R.func3);
+    if (rm < 0) {
+        return;
+    }
+    const float a = bits_to_float(fregisters[instr->type_R.rs1]);
+    const float b = bits_to_float(fregisters[instr->type_R.rs2]);
+    const float result = a + b;
+    fp_write_result(instr->type_R.rd, (rm == FRM_RMM && isfinite(result)) ?
+        fp_round_ties_away(result, ((double)a + b) - result) : result);
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'fsub.s' instruction
+    Uses the given 'instr' data to execute the 'fsub.s' instruction.
+    Format    | R
+    Operation | F[rd] = F[rs1] - F[rs2]
+*/
+void exec_fsub_s(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("FSUB.S\n");
+    #endif
+
+    // Execute instruction - Operands are read after the host fpu is set up
+    const int32_t rm = fp_begin(instr->type_R.func3);
+    if (rm < 0) {
+        return;
+    }
+    const float a = bits_to_float(fregisters[instr->type_R.rs1]);
+    const float b = bits_to_float(fregisters[instr->type_R.rs2]);
+    const float result = a - b;
+    fp_write_result(instr->type_R.rd, (rm == FRM_RMM && isfinite(result)) ?
+        fp_round_ties_away(result, ((double)a - b) - result) : result);
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'fmul.s' instruction
+    Uses the given 'instr' data to execute the 'fmul.s' instruction.
+    Format    | R
+    Operation | F[rd] = F[rs1] * F[rs2]
+*/
+void exec_fmul_s(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("FMUL.S\n");
+    #endif
+
+    // Execute instruction - Operands are read after the host fpu is set up
+    const int32_t rm = fp_begin(instr->type_R.func3);
+    if (rm < 0) {
+        return;
+    }
+    const float a = bits_to_float(fregisters[instr->type_R.rs1]);
+    const float b = bits_to_float(fregisters[instr->type_R.rs2]);
+    const float result = a * b;
+    fp_write_result(instr->type_R.rd, (rm == FRM_RMM && isfinite(result)) ?
+        fp_round_ties_away(result, ((double)a * b) - result) : result);
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'fdiv.s' instruction
+    Uses the given 'instr' data to execute the 'fdiv.s' instruction.
+    Format    | R
+    Operation | F[rd] = F[rs1] / F[rs2]
+*/
+void exec_fdiv_s(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("FDIV.S\n");
+    #endif
+
+    // Execute instruction - Operands are read after the host fpu is set up
+    if (fp_begin(instr->type_R.func3) < 0) {
+        return;
+    }
+    fp_write_result(instr->type_R.rd,
+        bits_to_float(fregisters[instr->type_R.rs1]) /
+        bits_to_float(fregisters[instr->type_R.rs2]));
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'fsqrt.s' instruction
+    Uses the given 'instr' data to execute the 'fsqrt.s' instruction.
+    Format    | R
+    Operation | F[rd] = sqrt(F[rs1])
+*/
+void exec_fsqrt_s(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("FSQRT.S\n");
+    #endif
+
+    // Execute instruction - Operands are read after the host fpu is set up
+    if (fp_begin(instr->type_R.func3) < 0) {
+        return;
+    }
+    fp_write_result(instr->type_R.rd,
+        sqrtf(bits_to_float(fregisters[instr->type_R.rs1])));
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'fcvt.w.s' instruction
+    Uses the given 'instr' data to execute the 'fcvt.w.s' instruction.
+    Format    | R
+    Operation | R[rd] = int32(F[rs1])
+                Out of range values and NaNs saturate (NaN to INT32_MAX)
+*/
+void exec_fcvt_w_s(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("FCVT.W.S\n");
+    #endif
+
+    // Round to an integer - Host flags aren't used, as the only ones
+    // raised are from the range checks
+    const int32_t rm = fp_begin(instr->type_R.func3);
+    if (rm < 0) {
+        return;
+    }
+    const float value = bits_to_float(fregisters[instr->type_R.rs1]);
+    int32_t result;
+    if (isnan(value)) {
+        result = INT32_MAX;
+        fcsr |= FFLAG_NV;
+    }
+    else {
+        const float rounded = fp_round_to_integer(value, rm);
+        if (rounded >= FP_INT32_LIMIT) {
+            result = INT32_MAX;
+            fcsr |= FFLAG_NV;
+        }
+        else if (rounded < -FP_INT32_LIMIT) {
+            result = INT32_MIN;
+            fcsr |= FFLAG_NV;
+        }
+        else {
+            result = (int32_t)rounded;
+            fcsr |= (rounded != value) ? FFLAG_NX : 0;
+        }
+    }
+
+    // Execute instruction
+    registers[instr->type_R.rd] = result;
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'fcvt.wu.s' instruction
+    Uses the given 'instr' data to execute the 'fcvt.wu.s' instruction.
+    Format    | R
+    Operation | R[rd] = uint32(F[rs1])
+                Out of range values and NaNs saturate (NaN to UINT32_MAX)
+*/
+void exec_fcvt_wu_s(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("FCVT.WU.S\n");
+    #endif
+
+    // Round to an integer - Host flags aren't used, as the only ones
+    // raised are from the range checks
+    const int32_t rm = fp_begin(instr->type_R.func3);
+    if (rm < 0) {
+        return;
+    }
+    const float value = bits_to_float(fregisters[instr->type_R.rs1]);
+    uint32_t result;
+    if (isnan(value)) {
+        result = UINT32_MAX;
+        fcsr |= FFLAG_NV;
+    }
+    else {
+        const float rounded = fp_round_to_integer(value, rm);
+        if (rounded >= FP_UINT32_LIMIT) {
+            result = UINT32_MAX;
+            fcsr |= FFLAG_NV;
+        }
+        else if (rounded < 0.0f) {
+            result = 0;
+            fcsr |= FFLAG_NV;
+        }
+        else {
+            result = (uint32_t)rounded;
+            fcsr |= (rounded != value) ? FFLAG_NX : 0;
+        }
+    }
+
+    // Execute instruction
+    registers[instr->type_R.rd] = (int32_t)result;
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'fcvt.s.w' instruction
+    Uses the given 'instr' data to execute the 'fcvt.s.w' instruction.
+    Format    | R
+    Operation | F[rd] = float(R[rs1])
+*/
+void exec_fcvt_s_w(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("FCVT.S.W\n");
+    #endif
+
+    // Execute instruction - Operands are read after the host fpu is set up
+    const int32_t rm = fp_begin(instr->type_R.func3);
+    if (rm < 0) {
+        return;
+    }
+    const int32_t value = registers[instr->type_R.rs1];
+    const float result = (float)value;
+    fp_write_result(instr->type_R.rd, (rm == FRM_RMM) ?
+        fp_round_ties_away(result, (double)(value - (int64_t)result)) : result);
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'fcvt.s.wu' instruction
+    Uses the given 'instr' data to execute the 'fcvt.s.wu' instruction.
+    Format    | R
+    Operation | F[rd] = float((unsigned)R[rs1])
+*/
+void exec_fcvt_s_wu(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("FCVT.S.WU\n");
+    #endif
+
+    // Execute instruction - Operands are read after the host fpu is set up
+    const int32_t rm = fp_begin(instr->type_R.func3);
+    if (rm < 0) {
+        return;
+    }
+    const uint32_t value = (uint32_t)registers[instr->type_R.rs1];
+    const float result = (float)value;
+    fp_write_result(instr->type_R.rd, (rm == FRM_RMM) ?
+        fp_round_ties_away(result, (double)(value - (int64_t)result)) : result);
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'fsgnj.s' instruction
+    Uses the given 'instr' data to execute the 'fsgnj.s' instruction.
+    Format    | R
+    Operation | F[rd] = |F[rs1]| with the sign of F[rs2]
+*/
+void exec_fsgnj_s(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("FSGNJ.S\n");
+    #endif
+
+    // Execute instruction - Only the sign bit changes, NaNs included
+    const uint32_t magnitude = fregisters[instr->type_R.rs1] & ~FP_SIGN_BIT;
+    fregisters[instr->type_R.rd] = magnitude | (
+        fregisters[instr->type_R.rs2] & FP_SIGN_BIT);
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'fsgnjn.s' instruction
+    Uses the given 'instr' data to execute the 'fsgnjn.s' instruction.
+    Format    | R
+    Operation | F[rd] = |F[rs1]| with the opposite sign of F[rs2]
+*/
+void exec_fsgnjn_s(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("FSGNJN.S\n");
+    #endif
+
+    // Execute instruction - Only the sign bit changes, NaNs included
+    const uint32_t magnitude = fregisters[instr->type_R.rs1] & ~FP_SIGN_BIT;
+    fregisters[instr->type_R.rd] = magnitude | (
+        ~fregisters[instr->type_R.rs2] & FP_SIGN_BIT);
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'fsgnjx.s' instruction
+    Uses the given 'instr' data to execute the 'fsgnjx.s' instruction.
+    Format    | R
+    Operation | F[rd] = F[rs1] with its sign xored with the sign of F[rs2]
+*/
+void exec_fsgnjx_s(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("FSGNJX.S\n");
+    #endif
+
+    // Execute instruction - Only the sign bit changes, NaNs included
+    const uint32_t magnitude = fregisters[instr->type_R.rs1] & ~FP_SIGN_BIT;
+    fregisters[instr->type_R.rd] = magnitude | (
+        (fregisters[instr->type_R.rs1] ^ fregisters[instr->type_R.rs2]) &
+        FP_SIGN_BIT);
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'fmin.s' instruction
+    Uses the given 'instr' data to execute the 'fmin.s' instruction.
+    Format    | R
+    Operation | F[rd] = min(F[rs1], F[rs2])
+*/
+void exec_fmin_s(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("FMIN.S\n");
+    #endif
+
+    // Execute instruction
+    fregisters[instr->type_R.rd] = fp_min_max(
+        fregisters[instr->type_R.rs1], fregisters[instr->type_R.rs2], false);
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'fmax.s' instruction
+    Uses the given 'instr' data to execute the 'fmax.s' instruction.
+    Format    | R
+    Operation | F[rd] = max(F[rs1], F[rs2])
+*/
+void exec_fmax_s(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("FMAX.S\n");
+    #endif
+
+    // Execute instruction
+    fregisters[instr->type_R.rd] = fp_min_max(
+        fregisters[instr->type_R.rs1], fregisters[instr->type_R.rs2], true);
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'feq.s' instruction
+    Uses the given 'instr' data to execute the 'feq.s' instruction.
+    Format    | R
+    Operation | R[rd] = (F[rs1] == F[rs2]) ? 1 : 0
+*/
+void exec_feq_s(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("FEQ.S\n");
+    #endif
+
+    // Execute instruction - Comparing a NaN gives 0, and is quiet (only
+    // signaling NaNs set the invalid operation flag)
+    const uint32_t a = fregisters[instr->type_R.rs1];
+    const uint32_t b = fregisters[instr->type_R.rs2];
+    registers[instr->type_R.rd] = !fp_unordered(a, b, false) &&
+        (bits_to_float(a) == bits_to_float(b));
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'flt.s' instruction
+    Uses the given 'instr' data to execute the 'flt.s' instruction.
+    Format    | R
+    Operation | R[rd] = (F[rs1] < F[rs2]) ? 1 : 0
+*/
+void exec_flt_s(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("FLT.S\n");
+    #endif
+
+    // Execute instruction - Comparing a NaN gives 0, and is signaling (any
+    // NaN sets the invalid operation flag)
+    const uint32_t a = fregisters[instr->type_R.rs1];
+    const uint32_t b = fregisters[instr->type_R.rs2];
+    registers[instr->type_R.rd] = !fp_unordered(a, b, true) &&
+        (bits_to_float(a) < bits_to_float(b));
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'fle.s' instruction
+    Uses the given 'instr' data to execute the 'fle.s' instruction.
+    Format    | R
+    Operation | R[rd] = (F[rs1] <= F[rs2]) ? 1 : 0
+*/
+void exec_fle_s(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("FLE.S\n");
+    #endif
+
+    // Execute instruction - Comparing a NaN gives 0, and is signaling (any
+    // NaN sets the invalid operation flag)
+    const uint32_t a = fregisters[instr->type_R.rs1];
+    const uint32_t b = fregisters[instr->type_R.rs2];
+    registers[instr->type_R.rd] = !fp_unordered(a, b, true) &&
+        (bits_to_float(a) <= bits_to_float(b));
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'fmv.x.w' instruction
+    Uses the given 'instr' data to execute the 'fmv.x.w' instruction.
+    Format    | R
+    Operation | R[rd] = F[rs1] (raw bits)
+*/
+void exec_fmv_x_w(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("FMV.X.W\n");
+    #endif
+
+    // Execute instruction
+    registers[instr->type_R.rd] = (int32_t)fregisters[instr->type_R.rs1];
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'fclass.s' instruction
+    Uses the given 'instr' data to execute the 'fclass.s' instruction.
+    Format    | R
+    Operation | R[rd] = the FCLASS_* bit of the class of F[rs1]
+*/
+void exec_fclass_s(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("FCLASS.S\n");
+    #endif
+
+    // Classify
+    const uint32_t bits = fregisters[instr->type_R.rs1];
+    const uint32_t exp = bits & FP_EXP_MASK;
+    const uint32_t frac = bits & FP_FRAC_MASK;
+    const bool neg = (bits & FP_SIGN_BIT) != 0;
+    int32_t result;
+    if (exp == FP_EXP_MASK && frac != 0) {
+        result = (bits & FP_QUIET_BIT) ? FCLASS_QNAN : FCLASS_SNAN;
+    }
+    else if (exp == FP_EXP_MASK) {
+        result = neg ? FCLASS_NEG_INF : FCLASS_POS_INF;
+    }
+    else if (exp == 0 && frac == 0) {
+        result = neg ? FCLASS_NEG_ZERO : FCLASS_POS_ZERO;
+    }
+    else if (exp == 0) {
+        result = neg ? FCLASS_NEG_SUBNORM : FCLASS_POS_SUBNORM;
+    }
+    else {
+        result = neg ? FCLASS_NEG_NORMAL : FCLASS_POS_NORMAL;
+    }
+
+    // Execute instruction
+    registers[instr->type_R.rd] = result;
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+/* Executes the 'fmv.w.x' instruction
+    Uses the given 'instr' data to execute the 'fmv.w.x' instruction.
+    Format    | R
+    Operation | F[rd] = R[rs1] (raw bits)
+*/
+void exec_fmv_w_x(instruction_t* const instr) {
+
+    // Debugging output
+    #ifdef DEBUG_PRINT_INSTRUCTION
+        printf("FMV.W.X\n");
+    #endif
+
+    // Execute instruction
+    fregisters[instr->type_R.rd] = (uint32_t)registers[instr->type_R.rs1];
+
+    // Increment program counter
+    pc += instr_size;
+}
+
+// INSTRUCTION PARSER AND EXECUTOR ...
+
+/* Determines which instruction was given and executes accordingly
+
+    Prints appropriate error message on error
+
+    RETURNS 
+    0  | On success
+    -1 | On error
+
+*/
+void exec_instruction(const int32_t instr) {
+    
+    // Declare struct to store unpacked instruction data
+    instruction_t parsed_instr;
+
+    // add
+    if (INSTR_MATCH(instr, ID_EXTRACT_MASK_3, ADD_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_add(&parsed_instr);
+    } 
+
+    // addi
+    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_2, ADDI_ID_BITS)) {
+        extract_I(&parsed_instr, instr);
+        exec_addi(&parsed_instr);
+    } 
+    
+    // sub
+    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_3, SUB_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_sub(&parsed_instr);
+    }
+
+    // lui
+    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_1, LUI_ID_BITS)) {
+        extract_U(&parsed_instr, instr);
+        exec_lui(&parsed_instr);
+    }
+
+    // xor
+    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_3, XOR_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_xor(&parsed_instr);
+    }
+
+    // xori
+    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_2, XORI_ID_BITS)) {
+        extract_I(&parsed_instr, instr);
+        exec_xori(&parsed_instr);
+    }
+
+    // or
+    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_3, OR_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_or(&parsed_instr);
+    }
+
+    // ori
+    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_2, ORI_ID_BITS)) {
+        extract_I(&parsed_instr, instr);
+        exec_ori(&parsed_instr);
+    }
+
+    // and
+    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_3, AND_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_and(&parsed_instr);
+    }
+
+    // andi
+    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_2, ANDI_ID_BITS)) {
+        extract_I(&parsed_instr, instr);
+        exec_andi(&parsed_instr);
+    }
+
+    // sll
+    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_3, SLL_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_sll(&parsed_instr);
+    }
+
+    // srl
+    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_3, SRL_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_srl(&parsed_instr);
+    }
+
+    // sra
+    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_3, SRA_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_sra(&parsed_instr);
+    }
+
+    // lb
+    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_2, LB_ID_BITS)) {
+        extract_I(&parsed_instr, instr);
+        exec_lb(&parsed_instr);
+    }
+
+    // lh
+    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_2, LH_ID_BITS)) {
+        extract_I(&parsed_instr, instr);
+        exec_lh(&parsed_instr);
+    }
+
+    // lw
+    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_2, LW_ID_BITS)) {
+        extract_I(&parsed_instr, instr);
+        exec_lw(&parsed_instr);
+    }
+
+    // lbu
+    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_2, LBU_ID_BITS)) {
+        extract_I(&parsed_instr, instr);
+        exec_lbu(&parsed_instr);
+    }
+
+    // lhu
+    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_2, LHU_ID_BITS)) {
+        extract_I(&parsed_instr, instr);
+        exec_lhu(&parsed_instr);
+    }
+
+    // sb
+    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_2, SB_ID_BITS)) {
+        extract_S(&parsed_instr, instr);
+        exec_sb(&parsed_instr);
+    }
+
+    // sh
+    else if (INSTR_MATCH(instr, ID_EXTRACT_MASK_2, SH_ID_BITS)) {
+        extract_S(&parsed_instr, instr);
         exec_sh(&parsed_instr);
     }
 
@@ -1264,6 +3080,433 @@ void exec_instruction(const int32_t instr) {
         exec_jalr(&parsed_instr);
     }
 
+    // mul
+    else if (options.ext_m &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_3, MUL_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_mul(&parsed_instr);
+    }
+
+    // mulh
+    else if (options.ext_m &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_3, MULH_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_mulh(&parsed_instr);
+    }
+
+    // mulhsu
+    else if (options.ext_m &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_3, MULHSU_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_mulhsu(&parsed_instr);
+    }
+
+    // mulhu
+    else if (options.ext_m &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_3, MULHU_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_mulhu(&parsed_instr);
+    }
+
+    // div
+    else if (options.ext_m &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_3, DIV_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_div(&parsed_instr);
+    }
+
+    // divu
+    else if (options.ext_m &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_3, DIVU_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_divu(&parsed_instr);
+    }
+
+    // rem
+    else if (options.ext_m &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_3, REM_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_rem(&parsed_instr);
+    }
+
+    // remu
+    else if (options.ext_m &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_3, REMU_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_remu(&parsed_instr);
+    }
+
+    // sh1add
+    else if (options.ext_zba &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_3, SH1ADD_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_sh1add(&parsed_instr);
+    }
+
+    // sh2add
+    else if (options.ext_zba &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_3, SH2ADD_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_sh2add(&parsed_instr);
+    }
+
+    // sh3add
+    else if (options.ext_zba &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_3, SH3ADD_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_sh3add(&parsed_instr);
+    }
+
+    // andn
+    else if (options.ext_zbb &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_3, ANDN_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_andn(&parsed_instr);
+    }
+
+    // orn
+    else if (options.ext_zbb &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_3, ORN_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_orn(&parsed_instr);
+    }
+
+    // xnor
+    else if (options.ext_zbb &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_3, XNOR_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_xnor(&parsed_instr);
+    }
+
+    // clz
+    else if (options.ext_zbb &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_4, CLZ_ID_BITS)) {
+        extract_I(&parsed_instr, instr);
+        exec_clz(&parsed_instr);
+    }
+
+    // ctz
+    else if (options.ext_zbb &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_4, CTZ_ID_BITS)) {
+        extract_I(&parsed_instr, instr);
+        exec_ctz(&parsed_instr);
+    }
+
+    // cpop
+    else if (options.ext_zbb &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_4, CPOP_ID_BITS)) {
+        extract_I(&parsed_instr, instr);
+        exec_cpop(&parsed_instr);
+    }
+
+    // sext.b
+    else if (options.ext_zbb &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_4, SEXT_B_ID_BITS)) {
+        extract_I(&parsed_instr, instr);
+        exec_sext_b(&parsed_instr);
+    }
+
+    // sext.h
+    else if (options.ext_zbb &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_4, SEXT_H_ID_BITS)) {
+        extract_I(&parsed_instr, instr);
+        exec_sext_h(&parsed_instr);
+    }
+
+    // zext.h
+    else if (options.ext_zbb &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_4, ZEXT_H_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_zext_h(&parsed_instr);
+    }
+
+    // min
+    else if (options.ext_zbb &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_3, MIN_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_min(&parsed_instr);
+    }
+
+    // minu
+    else if (options.ext_zbb &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_3, MINU_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_minu(&parsed_instr);
+    }
+
+    // max
+    else if (options.ext_zbb &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_3, MAX_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_max(&parsed_instr);
+    }
+
+    // maxu
+    else if (options.ext_zbb &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_3, MAXU_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_maxu(&parsed_instr);
+    }
+
+    // rol
+    else if (options.ext_zbb &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_3, ROL_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_rol(&parsed_instr);
+    }
+
+    // ror
+    else if (options.ext_zbb &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_3, ROR_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_ror(&parsed_instr);
+    }
+
+    // rori
+    else if (options.ext_zbb &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_3, RORI_ID_BITS)) {
+        extract_I(&parsed_instr, instr);
+        exec_rori(&parsed_instr);
+    }
+
+    // orc.b
+    else if (options.ext_zbb &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_4, ORC_B_ID_BITS)) {
+        extract_I(&parsed_instr, instr);
+        exec_orc_b(&parsed_instr);
+    }
+
+    // rev8
+    else if (options.ext_zbb &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_4, REV8_ID_BITS)) {
+        extract_I(&parsed_instr, instr);
+        exec_rev8(&parsed_instr);
+    }
+
+    // csrrw
+    else if ((options.ext_zicntr || options.ext_f) &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_2, CSRRW_ID_BITS)) {
+        extract_I(&parsed_instr, instr);
+        exec_csrrw(&parsed_instr);
+    }
+
+    // csrrs
+    else if ((options.ext_zicntr || options.ext_f) &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_2, CSRRS_ID_BITS)) {
+        extract_I(&parsed_instr, instr);
+        exec_csrrs(&parsed_instr);
+    }
+
+    // csrrc
+    else if ((options.ext_zicntr || options.ext_f) &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_2, CSRRC_ID_BITS)) {
+        extract_I(&parsed_instr, instr);
+        exec_csrrc(&parsed_instr);
+    }
+
+    // csrrwi
+    else if ((options.ext_zicntr || options.ext_f) &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_2, CSRRWI_ID_BITS)) {
+        extract_I(&parsed_instr, instr);
+        exec_csrrwi(&parsed_instr);
+    }
+
+    // csrrsi
+    else if ((options.ext_zicntr || options.ext_f) &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_2, CSRRSI_ID_BITS)) {
+        extract_I(&parsed_instr, instr);
+        exec_csrrsi(&parsed_instr);
+    }
+
+    // csrrci
+    else if ((options.ext_zicntr || options.ext_f) &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_2, CSRRCI_ID_BITS)) {
+        extract_I(&parsed_instr, instr);
+        exec_csrrci(&parsed_instr);
+    }
+
+    // flw
+    else if (options.ext_f &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_2, FLW_ID_BITS)) {
+        extract_I(&parsed_instr, instr);
+        exec_flw(&parsed_instr);
+    }
+
+    // fsw
+    else if (options.ext_f &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_2, FSW_ID_BITS)) {
+        extract_S(&parsed_instr, instr);
+        exec_fsw(&parsed_instr);
+    }
+
+    // fmadd.s
+    else if (options.ext_f &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_R4, FMADD_S_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_fmadd_s(&parsed_instr);
+    }
+
+    // fmsub.s
+    else if (options.ext_f &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_R4, FMSUB_S_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_fmsub_s(&parsed_instr);
+    }
+
+    // fnmsub.s
+    else if (options.ext_f &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_R4, FNMSUB_S_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_fnmsub_s(&parsed_instr);
+    }
+
+    // fnmadd.s
+    else if (options.ext_f &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_R4, FNMADD_S_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_fnmadd_s(&parsed_instr);
+    }
+
+    // fadd.s
+    else if (options.ext_f &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_RM, FADD_S_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_fadd_s(&parsed_instr);
+    }
+
+    // fsub.s
+    else if (options.ext_f &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_RM, FSUB_S_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_fsub_s(&parsed_instr);
+    }
+
+    // fmul.s
+    else if (options.ext_f &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_RM, FMUL_S_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_fmul_s(&parsed_instr);
+    }
+
+    // fdiv.s
+    else if (options.ext_f &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_RM, FDIV_S_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_fdiv_s(&parsed_instr);
+    }
+
+    // fsqrt.s
+    else if (options.ext_f &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_RM2, FSQRT_S_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_fsqrt_s(&parsed_instr);
+    }
+
+    // fcvt.w.s
+    else if (options.ext_f &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_RM2, FCVT_W_S_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_fcvt_w_s(&parsed_instr);
+    }
+
+    // fcvt.wu.s
+    else if (options.ext_f &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_RM2, FCVT_WU_S_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_fcvt_wu_s(&parsed_instr);
+    }
+
+    // fcvt.s.w
+    else if (options.ext_f &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_RM2, FCVT_S_W_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_fcvt_s_w(&parsed_instr);
+    }
+
+    // fcvt.s.wu
+    else if (options.ext_f &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_RM2, FCVT_S_WU_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_fcvt_s_wu(&parsed_instr);
+    }
+
+    // fsgnj.s
+    else if (options.ext_f &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_3, FSGNJ_S_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_fsgnj_s(&parsed_instr);
+    }
+
+    // fsgnjn.s
+    else if (options.ext_f &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_3, FSGNJN_S_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_fsgnjn_s(&parsed_instr);
+    }
+
+    // fsgnjx.s
+    else if (options.ext_f &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_3, FSGNJX_S_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_fsgnjx_s(&parsed_instr);
+    }
+
+    // fmin.s
+    else if (options.ext_f &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_3, FMIN_S_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_fmin_s(&parsed_instr);
+    }
+
+    // fmax.s
+    else if (options.ext_f &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_3, FMAX_S_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_fmax_s(&parsed_instr);
+    }
+
+    // feq.s
+    else if (options.ext_f &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_3, FEQ_S_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_feq_s(&parsed_instr);
+    }
+
+    // flt.s
+    else if (options.ext_f &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_3, FLT_S_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_flt_s(&parsed_instr);
+    }
+
+    // fle.s
+    else if (options.ext_f &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_3, FLE_S_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_fle_s(&parsed_instr);
+    }
+
+    // fmv.x.w
+    else if (options.ext_f &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_4, FMV_X_W_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_fmv_x_w(&parsed_instr);
+    }
+
+    // fclass.s
+    else if (options.ext_f &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_4, FCLASS_S_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_fclass_s(&parsed_instr);
+    }
+
+    // fmv.w.x
+    else if (options.ext_f &&
+             INSTR_MATCH(instr, ID_EXTRACT_MASK_4, FMV_W_X_ID_BITS)) {
+        extract_R(&parsed_instr, instr);
+        exec_fmv_w_x(&parsed_instr);
+    }
+
     // Error - Unknown instruction given
     else {
         throw_not_implemented_err();
@@ -0,0 +1,667 @@
+// Name:   Isaak Choi
+// UniKey: icho6322
+// SID:    520488399
+
+
+/* mem_proofs.c
+
+    Contains the load time memory access analysis (see mem_proofs.h).
+
+*/
+
+
+// INCLUDE HEADER ...
+#include "mem_proofs.h"
+
+#include <string.h>
+#include "instructions.h"
+#include "heap_manager.h"
+#include "rvc.h"
+
+
+// CONSTANTS ...
+
+// Times the ranges on entry to an address may grow before any further
+// growth widens a range out to the bounds of memory - So loops that step a
+// register (e.g. a pointer, or the stack pointer in recursion) end the pass
+#define MAX_RANGE_GROWTH    (8)
+
+// Data memory words tracked - One starting at each byte, as guests align
+// their stack pointer to whatever they like
+#define NUM_DATA_WORDS      (DATA_MEM_SIZE - WORD_SIZE + 1)
+
+
+// DATA STRUCTURES ...
+
+// The values a register / word may hold - Every value is
+//  [INT32_MIN, INT32_MAX]
+typedef struct value_range_t value_range_t;
+struct value_range_t {
+    int32_t lo;
+    int32_t hi;
+};
+
+// The ranges of every register and data memory word on entry to an address
+//  - Words hold what the guest spilled there (saved registers, locals), and
+//  are indexed by their offset in data memory
+typedef struct flow_state_t flow_state_t;
+struct flow_state_t {
+    value_range_t regs[NUM_REGISTERS];
+    value_range_t words[NUM_DATA_WORDS];
+};
+
+// Everything the pass tracks (malloc'd, as it is only needed at load time)
+typedef struct analysis_t analysis_t;
+struct analysis_t {
+    flow_state_t* entry[INST_MEM_SIZE];  // Ranges on entry to each address
+                                         //  (malloc'd once reached)
+    uint8_t growth[INST_MEM_SIZE];       // Times entry[] has grown
+    bool queued[INST_MEM_SIZE];          // Whether the address is queued
+    int32_t queue[INST_MEM_SIZE];        // Addresses to (re)visit
+    int32_t n_queued;
+    bool landing[INST_MEM_SIZE];         // Where a jalr may land
+    bool wild_jalr[INST_MEM_SIZE];       // jalrs without a constant target
+    bool failed;                         // Whether nothing can be proven
+};
+
+
+// GLOBAL MEMORY PROOF VARS ...
+
+// The MEM_PROOF_* of the load / store at each address of instruction memory
+uint8_t mem_proofs[INST_MEM_SIZE];
+
+// Whether a jalr landing at each address voids the proofs
+bool mem_proof_voiding_targets[INST_MEM_SIZE];
+
+
+// VALUE RANGES ...
+
+/* Returns the range holding every value */
+static value_range_t range_all() {
+    return (value_range_t){INT32_MIN, INT32_MAX};
+}
+
+/* Returns the range holding only 'value' */
+static value_range_t range_of(const int32_t value) {
+    return (value_range_t){value, value};
+}
+
+/* Returns the range [lo, hi] - Every value if it runs outside int32_t, as
+   the result of the instruction it came from wraps around
+*/
+static value_range_t range_from(const int64_t lo, const int64_t hi) {
+    if (lo < INT32_MIN || hi > INT32_MAX) {
+        return range_all();
+    }
+    return (value_range_t){(int32_t)lo, (int32_t)hi};
+}
+
+/* Returns whether the range holds a single value */
+static bool range_is_const(const value_range_t range) {
+    return range.lo == range.hi;
+}
+
+/* Returns whether the range holds every value */
+static bool range_is_all(const value_range_t range) {
+    return range.lo == INT32_MIN && range.hi == INT32_MAX;
+}
+
+/* Returns whether any value of the range is in [lo, hi] */
+static bool range_meets(const value_range_t range, const int64_t lo,
+                        const int64_t hi) {
+    return range.lo <= hi && range.hi >= lo;
+}
+
+/* Returns the range 'range' + 'imm' (an address calculation) */
+static value_range_t range_offset(const value_range_t range,
+                                  const int32_t imm) {
+    if (range_is_all(range)) {
+        return range;
+    }
+    return range_from((int64_t)range.lo + imm, (int64_t)range.hi + imm);
+}
+
+/* Returns 'range' widened out to the nearest bounds of instruction / data
+   memory that hold it - So a range that keeps growing still ends up in the
+   memory it addresses (e.g. return addresses, a stack pointer)
+*/
+static value_range_t widen_range(const value_range_t range) {
+    static const int32_t lo_bounds[] = {
+        DATA_MEM_START, INST_MEM_START, INT32_MIN
+    };
+    static const int32_t hi_bounds[] = {
+        INST_MEM_END, DATA_MEM_END, INT32_MAX
+    };
+    value_range_t wide = range;
+    for (int i = sizeof(lo_bounds) / sizeof(lo_bounds[0]) - 1; i >= 0; i--) {
+        if (lo_bounds[i] <= range.lo) {
+            wide.lo = lo_bounds[i];
+        }
+    }
+    for (int i = sizeof(hi_bounds) / sizeof(hi_bounds[0]) - 1; i >= 0; i--) {
+        if (hi_bounds[i] >= range.hi) {
+            wide.hi = hi_bounds[i];
+        }
+    }
+    return wide;
+}
+
+/* Grows each of the 'n' ranges in 'into' to hold the matching range in
+   'from' - Out to the bounds of memory (see widen_range()) if 'widen' is set
+
+    RETURNS
+    Whether any range grew
+*/
+static bool join_ranges(value_range_t* const into,
+                        const value_range_t* const from, const int n,
+                        const bool widen) {
+    bool grew = false;
+    for (int i = 0; i < n; i++) {
+        if (from[i].lo < into[i].lo || from[i].hi > into[i].hi) {
+            into[i] = (value_range_t){
+                (from[i].lo < into[i].lo) ? from[i].lo : into[i].lo,
+                (from[i].hi > into[i].hi) ? from[i].hi : into[i].hi
+            };
+            if (widen) {
+                into[i] = widen_range(into[i]);
+            }
+            grew = true;
+        }
+    }
+    return grew;
+}
+
+
+// CONTROL FLOW ...
+
+/* Joins 'state' into the ranges on entry to 'addr', queueing the address
+   if they grew
+*/
+static void join_entry(analysis_t* const an, const int32_t addr,
+                       const flow_state_t* const state) {
+
+    flow_state_t* entry = an->entry[addr];
+    bool grew = true;
+    if (entry == NULL) {
+        entry = an->entry[addr] = malloc(sizeof(flow_state_t));
+        if (entry == NULL) {
+            an->failed = true;
+            return;
+        }
+        *entry = *state;
+    }
+    else {
+        const bool widen = (an->growth[addr] >= MAX_RANGE_GROWTH);
+        grew = join_ranges(entry->regs, state->regs, NUM_REGISTERS, widen);
+        grew |= join_ranges(entry->words, state->words, NUM_DATA_WORDS, widen);
+        if (grew && !widen) {
+            an->growth[addr]++;
+        }
+    }
+
+    if (grew && !an->queued[addr]) {
+        an->queued[addr] = true;
+        an->queue[an->n_queued++] = addr;
+    }
+}
+
+/* Follows control flow from one instruction to 'target' with 'state'
+
+    * Targets outside instruction memory stop the program (the interpreter
+      checks the program counter after every instruction)
+    * Without --ext-c, a target in the last 3 bytes of instruction memory
+      fetches part of its instruction from data memory, which can change,
+      so the analysis fails
+*/
+static void flow_to(analysis_t* const an, const int32_t target,
+                    const flow_state_t* const state) {
+
+    if ((uint32_t)target >= INST_MEM_SIZE) {
+        return;
+    }
+    if (!options.ext_c && target > INST_MEM_SIZE - INST_SIZE_BYTES) {
+        an->failed = true;
+        return;
+    }
+    join_entry(an, target, state);
+}
+
+/* Adds 'target' to where jalrs may land - Requeues every jalr without a
+   constant target so they flow there too
+*/
+static void add_landing(analysis_t* const an, const int32_t target) {
+
+    if ((uint32_t)target >= INST_MEM_SIZE || an->landing[target]) {
+        return;
+    }
+    an->landing[target] = true;
+    for (int32_t addr = 0; addr < INST_MEM_SIZE; addr++) {
+        if (an->wild_jalr[addr] && !an->queued[addr]) {
+            an->queued[addr] = true;
+            an->queue[an->n_queued++] = addr;
+        }
+    }
+}
+
+
+// MEMORY ACCESSES ...
+
+/* Proves what it can about a load / store of 'size' bytes at an address in
+   'addr'
+*/
+static uint8_t prove_access(const value_range_t addr, const int32_t size,
+                            const bool store) {
+
+    if (range_is_all(addr)) {
+        return MEM_PROOF_UNKNOWN;
+    }
+
+    // Inside the memory the access may use without any further checks
+    const int64_t start = store ? DATA_MEM_START : INST_MEM_START;
+    if (addr.lo >= start && (int64_t)addr.hi + size - 1 <= DATA_MEM_END) {
+        return MEM_PROOF_IN_MEMORY;
+    }
+
+    // Clear of the virtual routines - Only the first byte picks a routine
+    if (!range_meets(addr, VIRT_MEM_START, VIRT_MEM_END)) {
+        return MEM_PROOF_NOT_VIRTUAL;
+    }
+    return MEM_PROOF_UNKNOWN;
+}
+
+/* Returns the data memory word an access of 'size' bytes at an address in
+   'addr' always is (-1 if it may be anything else)
+*/
+static int32_t exact_word(const value_range_t addr, const int32_t size) {
+    if (!range_is_const(addr) || size != WORD_SIZE ||
+        addr.lo < DATA_MEM_START || addr.lo > DATA_MEM_END - WORD_SIZE + 1) {
+        return -1;
+    }
+    return addr.lo - DATA_MEM_START;
+}
+
+/* Returns whether the virtual routine at 'addr' leaves data memory as it
+   was - Those that only print, stop the vm, or use the heap
+*/
+static bool vr_keeps_data_memory(const int32_t addr) {
+    switch (addr) {
+        case VR_WRITE_CHAR_ADDR:
+        case VR_WRITE_INT_ADDR:
+        case VR_WRITE_UINT_ADDR:
+        case VR_HALT_ADDR:
+        case VR_DUMP_PC_ADDR:
+        case VR_DUMP_REG_ADDR:
+        case VR_DUMP_MEM_WORD_ADDR:
+        case VR_HEAP_BANK_MALLOC_ADDR:
+        case VR_HEAP_BANK_FREE_ADDR:
+        case VR_HEAP_BANK_CALLOC_ADDR:
+        case VR_HEAP_BANK_REALLOC_ADDR:
+        case VR_MEMCMP_ADDR:
+        case VR_WRITE_BUF_ADDR:
+        case VR_WRITE_STR_ADDR:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/* Marks the registers virtual routines write as holding any value */
+static void clobber_vr_registers(flow_state_t* const state) {
+    state->regs[VR_RESULT_REGISTER] = range_all();
+    state->regs[HEAP_PTR_OUT_REGISTER] = range_all();
+}
+
+/* Updates 'state' for a store of 'size' bytes of 'value' at an address in
+   'addr'
+*/
+static void store_to(flow_state_t* const state, const value_range_t addr,
+                     const int32_t size, const value_range_t value) {
+
+    // Virtual routines may write the vr registers, and some write memory
+    if (range_meets(addr, VIRT_MEM_START, VIRT_MEM_END)) {
+        clobber_vr_registers(state);
+        if (!range_is_const(addr) || !vr_keeps_data_memory(addr.lo)) {
+            for (int i = 0; i < NUM_DATA_WORDS; i++) {
+                state->words[i] = range_all();
+            }
+        }
+    }
+
+    // Every word the store may overlap could now hold anything
+    const int64_t first = (int64_t)addr.lo - WORD_SIZE + 1 - DATA_MEM_START;
+    const int64_t last = (int64_t)addr.hi + size - 1 - DATA_MEM_START;
+    for (int64_t i = (first < 0) ? 0 : first;
+         i <= last && i < NUM_DATA_WORDS; i++) {
+        state->words[i] = range_all();
+    }
+
+    // Other than the one whole word a store to a known address replaces
+    const int32_t word = exact_word(addr, size);
+    if (word >= 0) {
+        state->words[word] = value;
+    }
+}
+
+/* Returns the range a load of the given width and signedness leaves in its
+   destination register
+*/
+static value_range_t loaded_range(const int32_t raw) {
+    if (INSTR_MATCH(raw, ID_EXTRACT_MASK_2, LB_ID_BITS)) {
+        return range_from(INT8_MIN, INT8_MAX);
+    }
+    if (INSTR_MATCH(raw, ID_EXTRACT_MASK_2, LH_ID_BITS)) {
+        return range_from(INT16_MIN, INT16_MAX);
+    }
+    if (INSTR_MATCH(raw, ID_EXTRACT_MASK_2, LBU_ID_BITS)) {
+        return range_from(0, UINT8_MAX);
+    }
+    if (INSTR_MATCH(raw, ID_EXTRACT_MASK_2, LHU_ID_BITS)) {
+        return range_from(0, UINT16_MAX);
+    }
+    return range_all();
+}
+
+/* Returns the bytes accessed by the load / store 'raw' */
+static int32_t access_size(const int32_t raw) {
+    if (INSTR_MATCH(raw, ID_EXTRACT_MASK_2, LB_ID_BITS) ||
+        INSTR_MATCH(raw, ID_EXTRACT_MASK_2, LBU_ID_BITS) ||
+        INSTR_MATCH(raw, ID_EXTRACT_MASK_2, SB_ID_BITS)) {
+        return 1;
+    }
+    if (INSTR_MATCH(raw, ID_EXTRACT_MASK_2, LH_ID_BITS) ||
+        INSTR_MATCH(raw, ID_EXTRACT_MASK_2, LHU_ID_BITS) ||
+        INSTR_MATCH(raw, ID_EXTRACT_MASK_2, SH_ID_BITS)) {
+        return WORD_SIZE / 2;
+    }
+    return WORD_SIZE;
+}
+
+
+// ANALYSIS ...
+
+/* Returns whether the instruction is a base load */
+static bool is_load(const int32_t raw) {
+    return INSTR_MATCH(raw, ID_EXTRACT_MASK_2, LB_ID_BITS) ||
+           INSTR_MATCH(raw, ID_EXTRACT_MASK_2, LH_ID_BITS) ||
+           INSTR_MATCH(raw, ID_EXTRACT_MASK_2, LW_ID_BITS) ||
+           INSTR_MATCH(raw, ID_EXTRACT_MASK_2, LBU_ID_BITS) ||
+           INSTR_MATCH(raw, ID_EXTRACT_MASK_2, LHU_ID_BITS);
+}
+
+/* Returns whether the instruction is a base store */
+static bool is_store(const int32_t raw) {
+    return INSTR_MATCH(raw, ID_EXTRACT_MASK_2, SB_ID_BITS) ||
+           INSTR_MATCH(raw, ID_EXTRACT_MASK_2, SH_ID_BITS) ||
+           INSTR_MATCH(raw, ID_EXTRACT_MASK_2, SW_ID_BITS);
+}
+
+/* Returns whether the instruction is a branch */
+static bool is_branch(const int32_t raw) {
+    return INSTR_MATCH(raw, ID_EXTRACT_MASK_2, BEQ_ID_BITS) ||
+           INSTR_MATCH(raw, ID_EXTRACT_MASK_2, BNE_ID_BITS) ||
+           INSTR_MATCH(raw, ID_EXTRACT_MASK_2, BLT_ID_BITS) ||
+           INSTR_MATCH(raw, ID_EXTRACT_MASK_2, BLTU_ID_BITS) ||
+           INSTR_MATCH(raw, ID_EXTRACT_MASK_2, BGE_ID_BITS) ||
+           INSTR_MATCH(raw, ID_EXTRACT_MASK_2, BGEU_ID_BITS);
+}
+
+/* Runs the instruction at 'addr' on its entry ranges, recording the proof
+   of a load / store, and follows control flow out of it
+*/
+static void visit(analysis_t* const an, const int32_t addr) {
+
+    // Fetch - Exactly as the interpreter would, stopping at an instruction
+    // that runs past the end of instruction memory (--ext-c only)
+    const int32_t size = (options.ext_c && IS_RVC_INSTR(memory[addr])) ?
+                         RVC_SIZE_BYTES : INST_SIZE_BYTES;
+    if (addr > INST_MEM_SIZE - size) {
+        return;
+    }
+    int32_t raw;
+    if (size == RVC_SIZE_BYTES) {
+        uint16_t half;
+        memcpy(&half, &memory[addr], sizeof(half));
+        raw = (int32_t)rvc_expand(half);
+    }
+    else {
+        memcpy(&raw, &memory[addr], sizeof(raw));
+    }
+
+    flow_state_t state = *an->entry[addr];
+    value_range_t* const x = state.regs;
+    const int32_t next = addr + size;
+    instruction_t f;
+
+    // Arithmetic and logic that address calculations are made of
+    if (INSTR_MATCH(raw, ID_EXTRACT_MASK_3, ADD_ID_BITS)) {
+        extract_R(&f, raw);
+        x[f.type_R.rd] = range_from(
+            (int64_t)x[f.type_R.rs1].lo + x[f.type_R.rs2].lo,
+            (int64_t)x[f.type_R.rs1].hi + x[f.type_R.rs2].hi);
+    }
+    else if (INSTR_MATCH(raw, ID_EXTRACT_MASK_2, ADDI_ID_BITS)) {
+        extract_I(&f, raw);
+        x[f.type_I.rd] = range_offset(x[f.type_I.rs1], f.type_I.imm);
+    }
+    else if (INSTR_MATCH(raw, ID_EXTRACT_MASK_3, SUB_ID_BITS)) {
+        extract_R(&f, raw);
+        x[f.type_R.rd] = range_from(
+            (int64_t)x[f.type_R.rs1].lo - x[f.type_R.rs2].hi,
+            (int64_t)x[f.type_R.rs1].hi - x[f.type_R.rs2].lo);
+    }
+    else if (INSTR_MATCH(raw, ID_EXTRACT_MASK_1, LUI_ID_BITS)) {
+        extract_U(&f, raw);
+        x[f.type_U.rd] = range_of(f.type_U.imm);
+    }
+    else if (INSTR_MATCH(raw, ID_EXTRACT_MASK_2, XORI_ID_BITS) ||
+             INSTR_MATCH(raw, ID_EXTRACT_MASK_2, ORI_ID_BITS)) {
+        extract_I(&f, raw);
+        const value_range_t rs1 = x[f.type_I.rs1];
+        const bool is_xor = INSTR_MATCH(raw, ID_EXTRACT_MASK_2, XORI_ID_BITS);
+        x[f.type_I.rd] = !range_is_const(rs1) ? range_all() : range_of(
+            is_xor ? (rs1.lo ^ f.type_I.imm) : (rs1.lo | f.type_I.imm));
+    }
+    else if (INSTR_MATCH(raw, ID_EXTRACT_MASK_2, ANDI_ID_BITS)) {
+        extract_I(&f, raw);
+        const value_range_t rs1 = x[f.type_I.rs1];
+        x[f.type_I.rd] = range_is_const(rs1) ?
+            range_of(rs1.lo & f.type_I.imm) :
+            (f.type_I.imm >= 0) ? range_from(0, f.type_I.imm) : range_all();
+    }
+    else if (INSTR_MATCH(raw, ID_EXTRACT_MASK_3, SLL_ID_BITS) ||
+             INSTR_MATCH(raw, ID_EXTRACT_MASK_3, SRL_ID_BITS)) {
+
+        // Only shifts by a known amount (there are no immediate shifts, so
+        // scaled indices are made with one) - As in exec_sll() / exec_srl()
+        extract_R(&f, raw);
+        const value_range_t rs1 = x[f.type_R.rs1];
+        const value_range_t rs2 = x[f.type_R.rs2];
+        const int32_t shift = rs2.lo;
+        if (!range_is_const(rs2) || shift == REGISTER_SIZE_BITS ||
+            range_is_all(rs1)) {
+            x[f.type_R.rd] = range_all();
+        }
+        else if (shift < 0 || shift > REGISTER_SIZE_BITS) {
+            x[f.type_R.rd] = range_of(ZERO_REGISTER_VAL);
+        }
+        else if (INSTR_MATCH(raw, ID_EXTRACT_MASK_3, SLL_ID_BITS)) {
+            const int64_t scale = (int64_t)1 << shift;
+            x[f.type_R.rd] = range_from(rs1.lo * scale, rs1.hi * scale);
+        }
+        else {
+            x[f.type_R.rd] = (rs1.lo >= 0 || shift == 0) ?
+                             range_from(rs1.lo >> shift, rs1.hi >> shift) :
+                             range_from(0, UINT32_MAX >> shift);
+        }
+    }
+    else if (INSTR_MATCH(raw, ID_EXTRACT_MASK_3, SLT_ID_BITS) ||
+             INSTR_MATCH(raw, ID_EXTRACT_MASK_3, SLTU_ID_BITS)) {
+        extract_R(&f, raw);
+        x[f.type_R.rd] = range_from(0, 1);
+    }
+    else if (INSTR_MATCH(raw, ID_EXTRACT_MASK_2, SLTI_ID_BITS) ||
+             INSTR_MATCH(raw, ID_EXTRACT_MASK_2, SLTIU_ID_BITS)) {
+        extract_I(&f, raw);
+        x[f.type_I.rd] = range_from(0, 1);
+    }
+
+    // Loads and stores - Loads of virtual routines may write the vr
+    // registers too
+    else if (is_load(raw)) {
+        extract_I(&f, raw);
+        const value_range_t at = range_offset(x[f.type_I.rs1], f.type_I.imm);
+        const int32_t word = exact_word(at, access_size(raw));
+        mem_proofs[addr] = prove_access(at, access_size(raw), false);
+        if (range_meets(at, VIRT_MEM_START, VIRT_MEM_END)) {
+            clobber_vr_registers(&state);
+        }
+        x[f.type_I.rd] = (word >= 0) ? state.words[word] : loaded_range(raw);
+    }
+    else if (is_store(raw)) {
+        extract_S(&f, raw);
+        const value_range_t at = range_offset(x[f.type_S.rs1], f.type_S.imm);
+        mem_proofs[addr] = prove_access(at, access_size(raw), true);
+        store_to(&state, at, access_size(raw), x[f.type_S.rs2]);
+
+        // A halt stops the program
+        if (range_is_const(at) && at.lo == VR_HALT_ADDR) {
+            return;
+        }
+    }
+
+    // Control flow
+    else if (is_branch(raw)) {
+        extract_SB(&f, raw);
+        flow_to(an, addr + f.type_SB.imm, &state);
+    }
+    else if (INSTR_MATCH(raw, ID_EXTRACT_MASK_1, JAL_ID_BITS)) {
+        extract_UJ(&f, raw);
+        x[f.type_UJ.rd] = range_of(next);
+        x[ZERO_REGISTER_ADDR] = range_of(ZERO_REGISTER_VAL);
+        if (f.type_UJ.rd != ZERO_REGISTER_ADDR) {
+            add_landing(an, next);
+        }
+        flow_to(an, addr + f.type_UJ.imm, &state);
+        return;
+    }
+    else if (INSTR_MATCH(raw, ID_EXTRACT_MASK_2, JALR_ID_BITS)) {
+
+        // rd is written before rs1 is read (as in exec_jalr())
+        extract_I(&f, raw);
+        x[f.type_I.rd] = range_of(next);
+        const value_range_t target = range_offset(x[f.type_I.rs1],
+                                                  f.type_I.imm);
+        x[ZERO_REGISTER_ADDR] = range_of(ZERO_REGISTER_VAL);
+        if (f.type_I.rd != ZERO_REGISTER_ADDR) {
+            add_landing(an, next);
+        }
+
+        // A constant target is followed, anything else may land on any
+        // landing in its range (and voids the proofs at run time if it
+        // lands anywhere else)
+        if (range_is_const(target)) {
+            add_landing(an, target.lo);
+            flow_to(an, target.lo, &state);
+        }
+        else {
+            an->wild_jalr[addr] = true;
+            const int32_t lo = (target.lo < 0) ? 0 : target.lo;
+            const int32_t hi = (target.hi >= INST_MEM_SIZE) ?
+                               INST_MEM_SIZE - 1 : target.hi;
+            for (int32_t i = lo; i <= hi; i++) {
+                if (an->landing[i]) {
+                    flow_to(an, i, &state);
+                }
+            }
+        }
+        return;
+    }
+
+    // Anything else may write its rd, or call a virtual routine (flw and
+    // fsw) - fsw may also write memory
+    else {
+        x[get_rd_bits(raw)] = range_all();
+        clobber_vr_registers(&state);
+        if (INSTR_MATCH(raw, ID_EXTRACT_MASK_2, FSW_ID_BITS)) {
+            extract_S(&f, raw);
+            store_to(&state, range_offset(x[f.type_S.rs1], f.type_S.imm),
+                     WORD_SIZE, range_all());
+        }
+    }
+
+    x[ZERO_REGISTER_ADDR] = range_of(ZERO_REGISTER_VAL);
+    flow_to(an, next, &state);
+}
+
+/* Runs the analysis - Every reached load / store gets its proof
+
+    RETURNS
+    true  | On success
+    false | If nothing can be proven
+*/
+static bool analyse(analysis_t* const an) {
+
+    // Registers are all zero at the entry point, and data memory holds
+    // what the memory image put there
+    flow_state_t start;
+    for (int i = 0; i < NUM_REGISTERS; i++) {
+        start.regs[i] = range_of(0);
+    }
+    for (int i = 0; i < NUM_DATA_WORDS; i++) {
+        int32_t word;
+        memcpy(&word, &memory[DATA_MEM_START + i], sizeof(word));
+        start.words[i] = range_of(word);
+    }
+    flow_to(an, INST_MEM_START, &start);
+
+    // Visit until the ranges stop growing
+    while (an->n_queued > 0 && !an->failed) {
+        const int32_t addr = an->queue[--an->n_queued];
+        an->queued[addr] = false;
+        visit(an, addr);
+    }
+    return !an->failed;
+}
+
+
+// INITIALISER ...
+
+/* Runs the analysis for the given options - Must be called after the memory
+   image has been read (and compressed instructions predecoded)
+*/
+void mem_proofs_init(const vm_options_t* const opts) {
+
+    mem_proofs_void();
+    if (opts->guard_pages || opts->aot_path != NULL || opts->no_mem_proofs) {
+        return;
+    }
+
+    // Without memory for the pass nothing is proven
+    analysis_t* const an = calloc(1, sizeof(analysis_t));
+    if (an == NULL) {
+        return;
+    }
+
+    // Proofs were recorded as the ranges grew, so the last visit of each
+    // access (on its final ranges) is the one that holds
+    if (analyse(an)) {
+        for (int32_t addr = 0; addr < INST_MEM_SIZE; addr++) {
+            mem_proof_voiding_targets[addr] = !an->landing[addr];
+        }
+    }
+    else {
+        mem_proofs_void();
+    }
+    for (int32_t addr = 0; addr < INST_MEM_SIZE; addr++) {
+        free(an->entry[addr]);
+    }
+    free(an);
+}
+
+/* Voids every proof - Called when a jalr lands somewhere the analysis didn't
+   follow it to
+*/
+void mem_proofs_void() {
+    memset(mem_proofs, MEM_PROOF_UNKNOWN, sizeof(mem_proofs));
+    memset(mem_proof_voiding_targets, false, sizeof(mem_proof_voiding_targets));
+}
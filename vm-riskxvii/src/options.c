@@ -0,0 +1,194 @@
+// Name:   Isaak Choi
+// UniKey: icho6322
+// SID:    520488399
+
+
+/* options.c
+
+    Contains the command line option parser for the virtual machine.
+
+*/
+
+
+// INCLUDE HEADER ...
+#include "options.h"
+
+#include "system.h"
+#include "heap_manager.h"
+#include "hot_loops.h"
+
+
+// GLOBAL OPTION VARS ...
+
+// The options selected for the current run
+vm_options_t options;
+
+
+// OPTION PARSING HELPERS ...
+
+/* Attempts to parse the given argument as the unsigned numeric option 'name'
+
+    PARAMETERS
+    <char*> arg       | The argument with OPT_PREFIX already removed
+    <char*> name      | The option name including the trailing '='
+    <uint64_t*> dst   | Where the parsed value is saved
+    <bool*> valid     | Set to false if the value was malformed
+
+    RETURNS
+    true  | The argument was the named option (valid or not)
+    false | The argument was a different option
+*/
+static bool parse_uint_option(const char* const arg, const char* const name,
+                              uint64_t* const dst, bool* const valid) {
+
+    // Check for matching option name
+    const size_t name_len = strlen(name);
+    if (strncmp(arg, name, name_len) != 0) {
+        return false;
+    }
+
+    // Parse value - Must be entirely made up of digits
+    const char* const value = arg + name_len;
+    char* end;
+    *dst = strtoull(value, &end, 10);
+    if (*value == '\0' || *end != '\0' || *value == '-') {
+        *valid = false;
+    }
+
+    // Return matched
+    return true;
+}
+
+
+// FUNCTIONS ...
+
+/* Parses the command line arguments into the global 'options' struct
+
+    * Exactly one argument not starting with OPT_PREFIX must be given,
+      which is used as the memory image binary path
+    * Options not given keep their default values
+
+    RETURNS
+    true  | On success
+    false | On unknown option, malformed value, invalid heap geometry,
+            or wrong number of paths
+*/
+bool parse_options(int argc, char** argv) {
+
+    // Set defaults
+    options.bin_path = NULL;
+    options.max_instr = OPT_UNLIMITED;
+    options.max_time_ms = OPT_UNLIMITED;
+    options.max_output_bytes = OPT_UNLIMITED;
+    options.max_input_bytes = OPT_UNLIMITED;
+    options.heap_size = DFLT_HEAP_MEM_SIZE;
+    options.heap_bank_size = DFLT_HEAP_BANK_SIZE;
+    options.heap_policy = HEAP_POLICY_FIRST_FIT;
+    options.guard_pages = false;
+    options.heap_trace_path = NULL;
+    options.aot_path = NULL;
+    options.ext_m = false;
+    options.ext_zba = false;
+    options.ext_zbb = false;
+    options.ext_c = false;
+    options.ext_zicntr = false;
+    options.ext_f = false;
+    options.stats = false;
+    options.hot_loop_threshold = DFLT_HOT_LOOP_THRESHOLD;
+
+    // Parse each argument (skipping the program name)
+    bool valid = true;
+    for (int i = 1; i < argc && valid; i++) {
+        const char* arg = argv[i];
+
+        // Memory image binary path - Only one allowed
+        if (strncmp(arg, OPT_PREFIX, strlen(OPT_PREFIX)) != 0) {
+            valid = (options.bin_path == NULL);
+            options.bin_path = arg;
+            continue;
+        }
+        arg += strlen(OPT_PREFIX);
+
+        // Flags
+        if (strcmp(arg, OPT_GUARD_PAGES) == 0) {
+            options.guard_pages = true;
+            continue;
+        }
+        if (strcmp(arg, OPT_EXT_M) == 0) {
+            options.ext_m = true;
+            continue;
+        }
+        if (strcmp(arg, OPT_EXT_ZBA) == 0) {
+            options.ext_zba = true;
+            continue;
+        }
+        if (strcmp(arg, OPT_EXT_ZBB) == 0) {
+            options.ext_zbb = true;
+            continue;
+        }
+        if (strcmp(arg, OPT_EXT_C) == 0) {
+            options.ext_c = true;
+            continue;
+        }
+        if (strcmp(arg, OPT_EXT_ZICNTR) == 0) {
+            options.ext_zicntr = true;
+            continue;
+        }
+        if (strcmp(arg, OPT_EXT_F) == 0) {
+            options.ext_f = true;
+            continue;
+        }
+        if (strcmp(arg, OPT_STATS) == 0) {
+            options.stats = true;
+            continue;
+        }
+        if (strcmp(arg, OPT_NO_MEM_PROOFS) == 0) {
+            options.no_mem_proofs = true;
+            continue;
+        }
+
+        // Heap allocation policy - Must be a known policy name
+        if (strncmp(arg, OPT_HEAP_POLICY, strlen(OPT_HEAP_POLICY)) == 0) {
+            options.heap_policy = heap_policy_from_name(
+                arg + strlen(OPT_HEAP_POLICY));
+            valid = (options.heap_policy >= 0);
+            continue;
+        }
+
+        // Heap trace file - Path must not be empty
+        if (strncmp(arg, OPT_HEAP_TRACE, strlen(OPT_HEAP_TRACE)) == 0) {
+            options.heap_trace_path = arg + strlen(OPT_HEAP_TRACE);
+            valid = (*options.heap_trace_path != '\0');
+            continue;
+        }
+
+        // Translated image - Path must not be empty
+        if (strncmp(arg, OPT_AOT, strlen(OPT_AOT)) == 0) {
+            options.aot_path = arg + strlen(OPT_AOT);
+            valid = (*options.aot_path != '\0');
+            continue;
+        }
+
+        // Execution limits and heap geometry
+        if (!parse_uint_option(arg, OPT_MAX_INSTR, &options.max_instr, &valid) &&
+            !parse_uint_option(arg, OPT_MAX_TIME_MS, &options.max_time_ms, &valid) &&
+            !parse_uint_option(arg, OPT_MAX_OUTPUT, &options.max_output_bytes, &valid) &&
+            !parse_uint_option(arg, OPT_MAX_INPUT, &options.max_input_bytes, &valid) &&
+            !parse_uint_option(arg, OPT_HEAP_SIZE, &options.heap_size, &valid) &&
+            !parse_uint_option(arg, OPT_HEAP_BANK_SIZE, &options.heap_bank_size, &valid) &&
+            !parse_uint_option(arg, OPT_HOT_LOOP_THRESHOLD, &options.hot_loop_threshold, &valid)) {
+
+            // Unknown option
+            valid = false;
+        }
+    }
+
+    // Heap must be made up of whole banks and fit in guest address space
+    valid = valid && (options.heap_bank_size > 0) &&
+            (options.heap_size > 0) &&
+            (options.heap_size <= MAX_HEAP_MEM_SIZE) &&
+            (options.heap_size % options.heap_bank_size == 0);
+
+    // A memory image path is required
+    return valid && (options.bin_path != NULL);
+}
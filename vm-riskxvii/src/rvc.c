@@ -0,0 +1,413 @@
+// Name:   Isaak Choi
+// UniKey: icho6322
+// SID:    520488399
+
+
+/* rvc.c
+
+    Contains the expansion, predecoding and fetch of RV32C compressed
+    instructions.
+
+*/
+
+
+// INCLUDE HEADER ...
+#include "rvc.h"
+
+#include "instructions.h"
+
+
+// CONSTANTS ...
+
+// Register numbers used implicitly by compressed instructions
+#define RVC_RA              (1)
+#define RVC_SP              (2)
+
+// The 3 bit register fields (rd', rs1', rs2') name registers x8 - x15
+#define RVC_PRIME_REG_BASE  (8)
+
+// 32 bit encodings without a base instruction opcode in instructions.h
+#define RVC_SLLI_ID_BITS    (0x00001013) // slli  - opcode 0x13, func3 1
+#define RVC_SRLI_ID_BITS    (0x00005013) // srli  - opcode 0x13, func3 5
+#define RVC_SRAI_ID_BITS    (0x40005013) // srai  - ^ with func7 0x20
+#define RVC_EBREAK_INSTR    (0x00100073) // ebreak
+
+
+// EXPANDED INSTRUCTIONS ...
+
+// The expansion of the compressed instruction starting at each instruction
+// memory offset - Only read for compressed instructions
+static uint32_t rvc_table[INST_MEM_SIZE];
+
+
+// BIT FIELD HELPERS ...
+
+/* Returns bits [hi:lo] of the given compressed instruction */
+static uint32_t bits(const uint16_t instr, const int hi, const int lo) {
+    return ((uint32_t)instr >> lo) & ((1u << (hi - lo + 1)) - 1);
+}
+
+/* Returns the given 'len' bit two's complement value sign extended */
+static int32_t sext(const uint32_t value, const int len) {
+    return sign_extend_int32((int32_t)value, len, REGISTER_SIZE_BITS);
+}
+
+/* Returns the register named by the 3 bit field at [lo + 2:lo] */
+static uint32_t prime_reg(const uint16_t instr, const int lo) {
+    return RVC_PRIME_REG_BASE + bits(instr, lo + 2, lo);
+}
+
+
+// 32 BIT ENCODERS ...
+
+/* Returns the R type instruction with the given fields */
+static uint32_t encode_R(const uint32_t id_bits, const uint32_t rd,
+                         const uint32_t rs1, const uint32_t rs2) {
+    return id_bits | (rd << RD_OFFSET_BITS) | (rs1 << RS1_OFFSET_BITS) |
+           (rs2 << RS2_OFFSET_BITS);
+}
+
+/* Returns the I type instruction with the given fields */
+static uint32_t encode_I(const uint32_t id_bits, const uint32_t rd,
+                         const uint32_t rs1, const int32_t imm) {
+    return id_bits | (rd << RD_OFFSET_BITS) | (rs1 << RS1_OFFSET_BITS) |
+           ((uint32_t)imm << RS2_OFFSET_BITS);
+}
+
+/* Returns the S type instruction with the given fields */
+static uint32_t encode_S(const uint32_t id_bits, const uint32_t rs1,
+                         const uint32_t rs2, const int32_t imm) {
+    const uint32_t u_imm = (uint32_t)imm;
+    return id_bits | (rs1 << RS1_OFFSET_BITS) | (rs2 << RS2_OFFSET_BITS) |
+           ((u_imm & 0x1F) << RD_OFFSET_BITS) |
+           ((u_imm >> 5 & 0x7F) << FUNC7_OFFSET_BITS);
+}
+
+/* Returns the SB type instruction with the given fields */
+static uint32_t encode_SB(const uint32_t id_bits, const uint32_t rs1,
+                          const uint32_t rs2, const int32_t imm) {
+    const uint32_t u_imm = (uint32_t)imm;
+    return id_bits | (rs1 << RS1_OFFSET_BITS) | (rs2 << RS2_OFFSET_BITS) |
+           ((u_imm >> 11 & 0x1) << 7) | ((u_imm >> 1 & 0xF) << 8) |
+           ((u_imm >> 5 & 0x3F) << 25) | ((u_imm >> 12 & 0x1) << 31);
+}
+
+/* Returns the U type instruction with the given fields
+    'imm' is the final register value - Its low 12 bits must be zero
+*/
+static uint32_t encode_U(const uint32_t id_bits, const uint32_t rd,
+                         const int32_t imm) {
+    return id_bits | (rd << RD_OFFSET_BITS) | (uint32_t)imm;
+}
+
+/* Returns the UJ type instruction with the given fields */
+static uint32_t encode_UJ(const uint32_t id_bits, const uint32_t rd,
+                          const int32_t imm) {
+    const uint32_t u_imm = (uint32_t)imm;
+    return id_bits | (rd << RD_OFFSET_BITS) |
+           ((u_imm >> 12 & 0xFF) << 12) | ((u_imm >> 11 & 0x1) << 20) |
+           ((u_imm >> 1 & 0x3FF) << 21) | ((u_imm >> 20 & 0x1) << 31);
+}
+
+
+// IMMEDIATE DECODERS ...
+
+/* Returns the sign extended 6 bit immediate {[12], [6:2]} */
+static int32_t imm_6(const uint16_t instr) {
+    return sext((bits(instr, 12, 12) << 5) | bits(instr, 6, 2), 6);
+}
+
+/* Returns the offset of c.j and c.jal - [12:2] = [11|4|9:8|10|6|7|3:1|5] */
+static int32_t imm_jump(const uint16_t instr) {
+    return sext((bits(instr, 12, 12) << 11) | (bits(instr, 11, 11) << 4) |
+                (bits(instr, 10, 9) << 8) | (bits(instr, 8, 8) << 10) |
+                (bits(instr, 7, 7) << 6) | (bits(instr, 6, 6) << 7) |
+                (bits(instr, 5, 3) << 1) | (bits(instr, 2, 2) << 5), 12);
+}
+
+/* Returns the offset of c.beqz and c.bnez
+    [12:10] = [8|4:3], [6:2] = [7:6|2:1|5]
+*/
+static int32_t imm_branch(const uint16_t instr) {
+    return sext((bits(instr, 12, 12) << 8) | (bits(instr, 11, 10) << 3) |
+                (bits(instr, 6, 5) << 6) | (bits(instr, 4, 3) << 1) |
+                (bits(instr, 2, 2) << 5), 9);
+}
+
+/* Returns the word offset of c.lw and c.sw - [12:10] = [5:3], [6:5] = [2|6] */
+static int32_t imm_lw(const uint16_t instr) {
+    return (int32_t)((bits(instr, 12, 10) << 3) | (bits(instr, 6, 6) << 2) |
+                     (bits(instr, 5, 5) << 6));
+}
+
+
+// QUADRANT EXPANDERS ...
+
+/* Returns the expansion of a quadrant 0 (0b00) compressed instruction */
+static uint32_t expand_q0(const uint16_t instr) {
+
+    const uint32_t rd_rs2 = prime_reg(instr, 2);
+    const uint32_t rs1 = prime_reg(instr, 7);
+
+    switch (bits(instr, 15, 13)) {
+
+        // c.addi4spn - addi rd', sp, nzuimm [12:5] = [5:4|9:6|2|3]
+        case 0x0: {
+            const int32_t imm = (int32_t)(
+                (bits(instr, 12, 11) << 4) | (bits(instr, 10, 7) << 6) |
+                (bits(instr, 6, 6) << 2) | (bits(instr, 5, 5) << 3));
+            if (imm == 0) {
+                return RVC_ILLEGAL_INSTR;
+            }
+            return encode_I(ADDI_ID_BITS, rd_rs2, RVC_SP, imm);
+        }
+
+        // c.lw - lw rd', offset(rs1')
+        case 0x2:
+            return encode_I(LW_ID_BITS, rd_rs2, rs1, imm_lw(instr));
+
+        // c.flw - flw rd', offset(rs1')
+        case 0x3:
+            return encode_I(FLW_ID_BITS, rd_rs2, rs1, imm_lw(instr));
+
+        // c.sw - sw rs2', offset(rs1')
+        case 0x6:
+            return encode_S(SW_ID_BITS, rs1, rd_rs2, imm_lw(instr));
+
+        // c.fsw - fsw rs2', offset(rs1')
+        case 0x7:
+            return encode_S(FSW_ID_BITS, rs1, rd_rs2, imm_lw(instr));
+
+        // Double precision loads and stores, reserved
+        default:
+            return RVC_ILLEGAL_INSTR;
+    }
+}
+
+/* Returns the expansion of a quadrant 1 (0b01) compressed instruction */
+static uint32_t expand_q1(const uint16_t instr) {
+
+    const uint32_t rd = bits(instr, 11, 7);
+    const uint32_t rd_prime = prime_reg(instr, 7);
+    const uint32_t rs2_prime = prime_reg(instr, 2);
+
+    switch (bits(instr, 15, 13)) {
+
+        // c.addi (c.nop) - addi rd, rd, imm
+        case 0x0:
+            return encode_I(ADDI_ID_BITS, rd, rd, imm_6(instr));
+
+        // c.jal - jal ra, offset
+        case 0x1:
+            return encode_UJ(JAL_ID_BITS, RVC_RA, imm_jump(instr));
+
+        // c.li - addi rd, zero, imm
+        case 0x2:
+            return encode_I(ADDI_ID_BITS, rd, ZERO_REGISTER_ADDR, imm_6(instr));
+
+        // c.addi16sp and c.lui
+        case 0x3: {
+
+            // c.addi16sp - addi sp, sp, nzimm [12|6:2] = [9|4|6|8:7|5]
+            if (rd == RVC_SP) {
+                const int32_t imm = sext(
+                    (bits(instr, 12, 12) << 9) | (bits(instr, 6, 6) << 4) |
+                    (bits(instr, 5, 5) << 6) | (bits(instr, 4, 3) << 7) |
+                    (bits(instr, 2, 2) << 5), 10);
+                if (imm == 0) {
+                    return RVC_ILLEGAL_INSTR;
+                }
+                return encode_I(ADDI_ID_BITS, RVC_SP, RVC_SP, imm);
+            }
+
+            // c.lui - lui rd, nzimm [12|6:2] = [17|16:12]
+            const int32_t imm = imm_6(instr);
+            if (imm == 0) {
+                return RVC_ILLEGAL_INSTR;
+            }
+            return encode_U(LUI_ID_BITS, rd, (int32_t)((uint32_t)imm << 12));
+        }
+
+        // Arithmetic on rd'
+        case 0x4: {
+            const uint32_t shamt = bits(instr, 6, 2);
+            switch (bits(instr, 11, 10)) {
+
+                // c.srli and c.srai - shamt[5] must be 0 on RV32
+                case 0x0:
+                case 0x1:
+                    if (bits(instr, 12, 12) != 0) {
+                        return RVC_ILLEGAL_INSTR;
+                    }
+                    return encode_I(bits(instr, 10, 10) ?
+                        RVC_SRAI_ID_BITS : RVC_SRLI_ID_BITS,
+                        rd_prime, rd_prime, (int32_t)shamt);
+
+                // c.andi - andi rd', rd', imm
+                case 0x2:
+                    return encode_I(ANDI_ID_BITS, rd_prime, rd_prime,
+                                    imm_6(instr));
+
+                // c.sub, c.xor, c.or, c.and - op rd', rd', rs2'
+                default: {
+                    static const uint32_t ops[] = {
+                        SUB_ID_BITS, XOR_ID_BITS, OR_ID_BITS, AND_ID_BITS
+                    };
+                    if (bits(instr, 12, 12) != 0) {
+                        return RVC_ILLEGAL_INSTR;
+                    }
+                    return encode_R(ops[bits(instr, 6, 5)],
+                                    rd_prime, rd_prime, rs2_prime);
+                }
+            }
+        }
+
+        // c.j - jal zero, offset
+        case 0x5:
+            return encode_UJ(JAL_ID_BITS, ZERO_REGISTER_ADDR, imm_jump(instr));
+
+        // c.beqz - beq rs1', zero, offset
+        case 0x6:
+            return encode_SB(BEQ_ID_BITS, rd_prime, ZERO_REGISTER_ADDR,
+                             imm_branch(instr));
+
+        // c.bnez - bne rs1', zero, offset
+        default:
+            return encode_SB(BNE_ID_BITS, rd_prime, ZERO_REGISTER_ADDR,
+                             imm_branch(instr));
+    }
+}
+
+/* Returns the expansion of a quadrant 2 (0b10) compressed instruction */
+static uint32_t expand_q2(const uint16_t instr) {
+
+    const uint32_t rd = bits(instr, 11, 7);
+    const uint32_t rs2 = bits(instr, 6, 2);
+
+    switch (bits(instr, 15, 13)) {
+
+        // c.slli - slli rd, rd, shamt - shamt[5] must be 0 on RV32
+        case 0x0:
+            if (bits(instr, 12, 12) != 0) {
+                return RVC_ILLEGAL_INSTR;
+            }
+            return encode_I(RVC_SLLI_ID_BITS, rd, rd, (int32_t)rs2);
+
+        // c.lwsp - lw rd, offset(sp) [12|6:2] = [5|4:2|7:6]
+        case 0x2: {
+            if (rd == ZERO_REGISTER_ADDR) {
+                return RVC_ILLEGAL_INSTR;
+            }
+            const int32_t imm = (int32_t)(
+                (bits(instr, 12, 12) << 5) | (bits(instr, 6, 4) << 2) |
+                (bits(instr, 3, 2) << 6));
+            return encode_I(LW_ID_BITS, rd, RVC_SP, imm);
+        }
+
+        // c.flwsp - flw rd, offset(sp) - As c.lwsp, but f0 is allowed
+        case 0x3: {
+            const int32_t imm = (int32_t)(
+                (bits(instr, 12, 12) << 5) | (bits(instr, 6, 4) << 2) |
+                (bits(instr, 3, 2) << 6));
+            return encode_I(FLW_ID_BITS, rd, RVC_SP, imm);
+        }
+
+        // c.jr, c.mv, c.ebreak, c.jalr, c.add
+        case 0x4:
+            if (bits(instr, 12, 12) == 0) {
+
+                // c.jr - jalr zero, 0(rs1)
+                if (rs2 == ZERO_REGISTER_ADDR) {
+                    if (rd == ZERO_REGISTER_ADDR) {
+                        return RVC_ILLEGAL_INSTR;
+                    }
+                    return encode_I(JALR_ID_BITS, ZERO_REGISTER_ADDR, rd, 0);
+                }
+
+                // c.mv - add rd, zero, rs2
+                return encode_R(ADD_ID_BITS, rd, ZERO_REGISTER_ADDR, rs2);
+            }
+
+            // c.ebreak
+            if (rd == ZERO_REGISTER_ADDR && rs2 == ZERO_REGISTER_ADDR) {
+                return RVC_EBREAK_INSTR;
+            }
+
+            // c.jalr - jalr ra, 0(rs1)
+            if (rs2 == ZERO_REGISTER_ADDR) {
+                return encode_I(JALR_ID_BITS, RVC_RA, rd, 0);
+            }
+
+            // c.add - add rd, rd, rs2
+            return encode_R(ADD_ID_BITS, rd, rd, rs2);
+
+        // c.swsp - sw rs2, offset(sp) [12:7] = [5:2|7:6]
+        case 0x6: {
+            const int32_t imm = (int32_t)(
+                (bits(instr, 12, 9) << 2) | (bits(instr, 8, 7) << 6));
+            return encode_S(SW_ID_BITS, RVC_SP, rs2, imm);
+        }
+
+        // c.fswsp - fsw rs2, offset(sp)
+        case 0x7: {
+            const int32_t imm = (int32_t)(
+                (bits(instr, 12, 9) << 2) | (bits(instr, 8, 7) << 6));
+            return encode_S(FSW_ID_BITS, RVC_SP, rs2, imm);
+        }
+
+        // Double precision loads and stores
+        default:
+            return RVC_ILLEGAL_INSTR;
+    }
+}
+
+
+// FUNCTIONS ...
+
+/* Returns the 32 bit instruction equivalent to the given compressed
+   instruction, or RVC_ILLEGAL_INSTR if there is none
+*/
+uint32_t rvc_expand(const uint16_t instr) {
+    switch (instr & RVC_QUADRANT_MASK) {
+        case 0x0: return expand_q0(instr);
+        case 0x1: return expand_q1(instr);
+        case 0x2: return expand_q2(instr);
+        default:  return RVC_ILLEGAL_INSTR;
+    }
+}
+
+/* Expands the compressed instruction starting at every byte of instruction
+   memory - Must be called after the memory image has been loaded
+*/
+void rvc_predecode() {
+
+    // The last byte has no room for a compressed instruction, and is
+    // never fetched as one
+    for (int32_t addr = INST_MEM_START;
+         addr <= INST_MEM_END - RVC_SIZE_BYTES + 1; addr++) {
+        rvc_table[addr] = rvc_expand(*(uint16_t*)&memory[addr]);
+    }
+}
+
+/* Fetches the instruction at the program counter
+
+    * Sets 'instr_size' to the size of the fetched instruction
+    * Returns compressed instructions already expanded to 32 bits
+    * Throws a program counter out of bounds error if the instruction runs
+      past the end of instruction memory
+*/
+uint32_t rvc_fetch_instruction() {
+
+    // Set the size first so errors print the whole instruction only
+    instr_size = IS_RVC_INSTR(memory[pc]) ? RVC_SIZE_BYTES : INST_SIZE_BYTES;
+    if (pc > INST_MEM_SIZE - instr_size) {
+        throw_pc_out_of_bounds_err();
+    }
+
+    // Compressed - Already expanded
+    if (instr_size == RVC_SIZE_BYTES) {
+        budget.block_compressed++;
+        return rvc_table[pc];
+    }
+    return get_instruction();
+}
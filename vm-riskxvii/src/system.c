@@ -12,16 +12,19 @@
     * Memory interface functions
 
     NOTE
-    * Uses virtual routine memory space to store system errors
-      and cpu run status information:
-      * 0x0850 - System CPU run status in form of <boolean>
-      * 0x0854 - System error status in form of <int> error code
+    * The CPU run status and system error code are kept host side in
+      'cpu_status', out of reach of the guest.
+    * Halts and errors raise a trap which longjmps straight back to the
+      CPU run loop, so the loop doesn't need to poll for them.
 
 */
 
 
 // INCLUDE HEADER ...
 #include "system.h"
+#include "heap_manager.h"
+#include "guard_pages.h"
+#include "heap_trace.h"
 
 
 // GLOBAL SYSTEM VARS ...
@@ -29,11 +32,36 @@
 // The program counter
 int32_t pc;
 
+// Size in bytes of the instruction at the program counter - Only differs
+//  from DFLT_PC_INCREMENT for compressed instructions (see rvc.h)
+int32_t instr_size;
+
 // Stores register data, with each index being a unique register
 int32_t registers[NUM_REGISTERS];
 
-// The main system memory
-byte memory[MEM_SIZE_BYTES];
+// Stores floating point register data as raw single precision bits, with
+//  each index being a unique register (--ext-f, see instructions.h)
+uint32_t fregisters[NUM_REGISTERS];
+
+// The floating point control and status register - The rounding mode 'frm'
+//  in bits 7:5 and the accrued exception flags 'fflags' in bits 4:0
+uint32_t fcsr;
+
+// The main system memory - MEM_SIZE_BYTES long, allocated by system_init()
+//  Starts with the memory image segment, indexed directly by vm address
+byte* memory = NULL;
+
+// The heap bank segment of memory, indexed by (vm address - HEAP_MEM_START)
+byte* heap_memory = NULL;
+
+// The heap bank geometry of the current run
+heap_geometry_t heap_geometry;
+
+// The run status, error code, and trap handler of the CPU
+cpu_status_t cpu_status;
+
+// Manages allocation of the heap banks - Holds all of its own storage
+heap_manager_t heap_manager;
 
 
 // SYSTEM SUB-OPERATION FUNCTIONS ...
@@ -73,54 +101,73 @@ int32_t sign_extend_int32(int32_t num, int curr_len_bits, int new_len_bits) {
 
 // ERROR CALL ABSTRACTIONS ...
 
+/* Raises a trap, stopping the simulated CPU
+
+    * Saves the given error code (ERR_NO_ERR for a requested halt)
+    * Jumps straight back to the CPU run loop if it has armed the trap 
+      handler, otherwise returns so the caller can report the error
+
+*/
+void raise_trap(const int32_t err) {
+
+    // Stop CPU and save error
+    cpu_status.running = false;
+    cpu_status.err = err;
+
+    // Return to run loop
+    if (cpu_status.trap_armed) {
+        longjmp(cpu_status.trap_env, 1);
+    }
+}
+
 /* Throws the error required when an unknown instruction is encountered
 
-    * Sets appropriate error code
     * Prints error identifier text, the instruction in hex, and a register dump
       to stdout.
+    * Raises a trap with the appropriate error code
 
 */
 void throw_not_implemented_err() {
-    
-    // Set error code
-    set_system_error_code(ERR_UNKNOWN_INSTR);
 
     // Print error info
     printf("Instruction Not Implemented: 0x%08x\n", get_instruction());
     register_dump();
+
+    // Stop CPU
+    raise_trap(ERR_UNKNOWN_INSTR);
 }
 
 /* Throws the error required when an illegal operation is encountered
 
-    * Sets appropriate error code
     * Prints error identifier text, the instruction in hex, and a register dump
       to stdout.
+    * Raises a trap with the appropriate error code
 
 */
 void throw_illegal_operation_err() {
-    
-    // Set error code
-    set_system_error_code(ERR_ILLEGAL_OPERATION);
 
     // Print error info
     printf("Illegal Operation: 0x%08x\n", get_instruction());
     register_dump();
+
+    // Stop CPU
+    raise_trap(ERR_ILLEGAL_OPERATION);
 }
 
 /* Throws the error required when an the program counter exceeds allowed bounds
 
-    * Sets appropriate error code
     * Prints error identifier text and a register dump to stdout
+    * Raises a trap with the appropriate error code
 
 */
 void throw_pc_out_of_bounds_err() {
-    
-    // Set error code
-    set_system_error_code(ERR_PC_OUT_OF_BOUNDS);
 
     // Print error info
     printf("Program counter out of bounds\n");
     register_dump();
+
+    // Stop CPU
+    raise_trap(ERR_PC_OUT_OF_BOUNDS);
 }
 
 /* Throws a malloc failed error
@@ -131,9 +178,41 @@ void throw_pc_out_of_bounds_err() {
 
 */
 void throw_host_malloc_failed_err() {
-    
-    // Set error code
-    set_system_error_code(ERR_HOST_MALLOC_FAILED);
+
+    // Stop CPU
+    raise_trap(ERR_HOST_MALLOC_FAILED);
+}
+
+/* Throws the error required when an execution limit is exceeded
+
+    * Prints the name of the exceeded limit and a register dump to stdout
+    * Raises a trap with the given error code (one of the ERR_*_LIMIT codes)
+
+*/
+void throw_limit_exceeded_err(const int32_t err) {
+
+    // Limits are checked part way through the instruction ending a block,
+    // so discard any write it made to the zero register before dumping
+    registers[ZERO_REGISTER_ADDR] = ZERO_REGISTER_VAL;
+
+    // Print error info
+    switch (err) {
+        case ERR_INSTR_LIMIT:
+            printf("Instruction limit exceeded\n");
+            break;
+        case ERR_TIME_LIMIT:
+            printf("Time limit exceeded\n");
+            break;
+        case ERR_OUTPUT_LIMIT:
+            printf("Output limit exceeded\n");
+            break;
+        default:
+            printf("Input limit exceeded\n");
+    }
+    register_dump();
+
+    // Stop CPU
+    raise_trap(err);
 }
 
 
@@ -141,52 +220,81 @@ void throw_host_malloc_failed_err() {
 
 /* Performs a register dump to stdout
     Prints the value pc followed by the value of registers 0 to NUM_REGISTERS
+    Returns the number of bytes printed
 */
-void register_dump() {
-    printf("PC = 0x%08x;\n", pc);
+int register_dump() {
+    int n_bytes = printf("PC = 0x%08x;\n", pc);
     for (int i = 0; i < NUM_REGISTERS; i++) {
-        printf("R[%d] = 0x%08x;\n", i, registers[i]);
+        n_bytes += printf("R[%d] = 0x%08x;\n", i, registers[i]);
     }
+    return n_bytes;
 }
 
 /* Sets the CPU run status for the system
     Setting to false will cause the simulated CPU to stop running
 */ 
 void set_cpu_run_status(const bool run) {
-    *(bool*)&memory[VR_CPU_RUN_ADDR] = run;
+    cpu_status.running = run;
 }
 
 /* Returns the CPU run status as a boolean
     Returns true if CPU is/should run, else false
 */
 bool get_cpu_run_status() {
-    return *(bool*)&memory[VR_CPU_RUN_ADDR];
+    return cpu_status.running;
 }
 
 /* Sets the system error code
     A non zero code denotes an error
 */
 void set_system_error_code(const int32_t err) {
-    *(int32_t*)&memory[VR_SYS_ERR_ADDR] = err;
+    cpu_status.err = err;
 }
 
 /* Returns the system error code
     A non zero code denotes an error
 */
 int32_t get_system_error_code() {
-    return *(int32_t*)&memory[VR_SYS_ERR_ADDR];
+    return cpu_status.err;
 }
 
 /* Retrieves the current instruction
     Returns the current instruction, pointed to by the program counter, 
-    as a uint32_t.
+    as a uint32_t. Compressed instructions are returned unexpanded.
 */
 uint32_t get_instruction() {
 
+    // Compressed instructions are only the low half word
+    if (instr_size != DFLT_PC_INCREMENT) {
+        return *(uint16_t*)&memory[pc];
+    }
+
     // Return instruction
     return *(uint32_t*)&memory[pc];
 }
 
+/* Translates the given vm address to a host pointer into stored memory
+
+    RETURNS
+    Host pointer | If the address is within the memory image or heap banks
+    NULL         | If the address is not backed by stored memory
+*/
+byte* translate_addr(const int32_t addr) {
+
+    // Memory image segment
+    if (addr >= INST_MEM_START && addr <= DATA_MEM_END) {
+        return &memory[addr];
+    }
+
+    // Heap bank segment
+    if (addr >= HEAP_MEM_START && addr <= HEAP_MEM_END) {
+        return &heap_memory[addr - HEAP_MEM_START];
+    }
+
+    // Not stored
+    return NULL;
+}
+
 
 // VIRTUAL ROUTINES ...
 
@@ -194,38 +302,40 @@ uint32_t get_instruction() {
     Prints the value at the given location as a single ASCII 
     encoded character to stdout
 */
-void vr_write_char(const char* const char_src_ptr) {
-    printf("%c", *char_src_ptr);
+void vr_write_char(const void* const src_ptr) {
+    budget.output_bytes += printf("%c", *(const char*)src_ptr);
 }
 
 /* Console Write Int
     Prints the value at the given location as a single signed integer to stdout
 */
-void vr_write_int(const int32_t* const int_src) {
-    printf("%d", *int_src);
+void vr_write_int(const void* const src_ptr) {
+    budget.output_bytes += printf("%d", *(const int32_t*)src_ptr);
 }
 
 /* Console Write Unsigned Int
     Prints the value at the given location as a single 
     unsigned integer to stdout
 */
-void vr_write_uint(const uint32_t* const uint_src) {
-    printf("%x", *uint_src);
+void vr_write_uint(const void* const src_ptr) {
+    budget.output_bytes += printf("%x", *(const uint32_t*)src_ptr);
 }
 
 /* Halt
-    Prints CPU halt message to stdout and stops the simulated CPU
+    Prints CPU halt message to stdout and stops the simulated CPU by 
+    raising a trap with no error
 */
-void vr_halt() {
+void vr_halt(const void* const src_ptr) {
+    (void)src_ptr;
     printf("CPU Halt Requested\n");
-    set_cpu_run_status(false);
+    raise_trap(ERR_NO_ERR);
 }
 
 /* Console Read Character
     Reads a single char from stdin and stores as a single ASCII encoded char
     at the given location
 */
-void vr_read_char(const void* const dst_ptr) {
+void vr_read_char(void* const dst_ptr) {
 
     // Read char
     char c = fgetc(stdin);
@@ -239,35 +349,40 @@ void vr_read_char(const void* const dst_ptr) {
 
     // Save char
     *(char*)dst_ptr = c;
+    budget.input_bytes += feof(stdin) ? 0 : 1;
 }
 
 /* Console Read Signed Integer
     Reads a single signed int from stdin and stores as an int32 
     at the given location
 */
-void vr_read_int(const void* const dst_ptr) {
+void vr_read_int(void* const dst_ptr) {
 
-    // Read int
+    // Read int - '%n' gives the number of bytes consumed
     int int_in;
-    scanf("%d", &int_in);
+    int n_bytes = 0;
+    scanf("%d%n", &int_in, &n_bytes);
 
     // Save int
     *(int32_t*)dst_ptr = int_in;
+    budget.input_bytes += n_bytes;
 }
 
 /* Dump PC
     Prints the value of the program counter to stdout
 */
-void vr_dump_pc() {
-    printf("%x", pc);
+void vr_dump_pc(const void* const src_ptr) {
+    (void)src_ptr;
+    budget.output_bytes += printf("%x", pc);
 }
 
 /* Dump Register Banks
     Invokes the register_dump() method, printing the values of 
     the PC and all registers to stdout
 */
-void vr_dump_registers() {
-    register_dump();
+void vr_dump_registers(const void* const src_ptr) {
+    (void)src_ptr;
+    budget.output_bytes += register_dump();
 }
 
 /* Dump Memory Word
@@ -277,10 +392,124 @@ void vr_dump_registers() {
 void vr_dump_word(const void* src_ptr) {
 
     // Get vm address
-    const uint32_t addr = *(uint32_t*)src_ptr;
+    const int32_t addr = *(int32_t*)src_ptr;
+
+    // Get word (little endian) - Bytes not backed by stored memory read as 0
+    uint32_t word = 0;
+    for (int i = WORD_SIZE - 1; i >= 0; i--) {
+        const byte* const host_ptr = translate_addr(addr + i);
+        word = (word << BYTE_SIZE_BITS) | ((host_ptr != NULL) ? *host_ptr : 0);
+    }
 
-    // Get word and print
-    printf("%x", *(uint32_t*)&memory[addr]);
+    // Print
+    budget.output_bytes += printf("%x", word);
+}
+
+/* Records a heap virtual routine call if a heap trace is open */
+static void trace_heap_call(const uint8_t kind, const int32_t arg,
+                            const int32_t result) {
+    if (heap_trace_is_open()) {
+        const heap_trace_event_t event = {
+            kind, budget_instr_count(), arg, result
+        };
+        heap_trace_record(&event);
+    }
+}
+
+/* Returns the HEAP_TRACE_FREE_* result of freeing the given address */
+static int32_t trace_free_result(const heap_manager_t* const manager,
+                                 const int32_t addr) {
+    return manager->is_freeable(manager, addr) ?
+           HEAP_TRACE_FREE_OK : HEAP_TRACE_FREE_ERR;
+}
+
+/* Reads the given number of int32_t words of a virtual routine descriptor
+    from vm memory at the given address into 'args'
+    Throws illegal operation error if the descriptor is within virtual
+    routine memory, or can't be read
+*/
+void read_vr_descriptor(const int32_t addr, int32_t* const args,
+                        const int num) {
+    for (int i = 0; i < num; i++) {
+        const int32_t word_addr = addr + i * (int32_t)sizeof(int32_t);
+        if (word_addr >= VIRT_MEM_START && word_addr <= VIRT_MEM_END) {
+            throw_illegal_operation_err();
+        }
+        mem_read(&args[i], word_addr, sizeof(int32_t));
+    }
+}
+
+/* Translates a whole field of vm memory to host memory for a bulk memory
+    virtual routine
+    Throws illegal operation error if any byte of the field can't be read
+    (or written if 'write' is set), exactly as a load / store of it would
+
+    RETURNS
+    Host pointer to the start of the field | If every byte is accessible
+*/
+byte* translate_field(const int32_t addr, const int32_t size,
+                      const bool write) {
+
+    const int64_t end_addr = (int64_t)addr + size - 1;
+
+    // Data memory - Always through the write view in guard page mode, so
+    // that overlapping source and destination fields share host addresses
+    if (addr >= DATA_MEM_START && end_addr <= DATA_MEM_END) {
+        return guard_pages.enabled ?
+               guard_pages.write_base + (addr - DATA_MEM_START) :
+               &memory[addr];
+    }
+
+    // Instruction memory - Read only
+    if (!write && addr >= INST_MEM_START && end_addr <= DATA_MEM_END) {
+        return &memory[addr];
+    }
+
+    // Heap banks - One check of every chunk the field crosses
+    if (addr >= HEAP_MEM_START && end_addr <= HEAP_MEM_END) {
+        heap_manager_t* const manager = get_heap_manager();
+        if (manager->is_valid_memory(manager, addr, size)) {
+            return &heap_memory[addr - HEAP_MEM_START];
+        }
+    }
+
+    throw_illegal_operation_err();
+    return NULL;
+}
+
+/* Returns the number of bytes from the given address that can be read
+    (0 if it can't be read at all)
+*/
+static int32_t readable_span(const int32_t addr) {
+
+    // Instruction and data memory
+    if (addr >= INST_MEM_START && addr <= DATA_MEM_END) {
+        return DATA_MEM_END - addr + 1;
+    }
+
+    // Heap banks - Up to the end of the chunks the address runs through
+    if (addr >= HEAP_MEM_START && addr <= HEAP_MEM_END) {
+        const heap_manager_t* const manager = get_heap_manager();
+        return manager->valid_span(manager, addr);
+    }
+    return 0;
+}
+
+/* Reads and validates the { buf, n } descriptor of a console read virtual
+    routine
+
+    RETURNS
+    Host pointer to buf | Every byte of which can be written
+    NULL                | If n is 0
+*/
+static byte* read_buf_descriptor(const void* const src_ptr, int32_t* const n) {
+    int32_t args[2];
+    read_vr_descriptor(*(int32_t*)src_ptr, args, 2);
+    *n = args[1];
+    if (*n < 0) {
+        throw_illegal_operation_err();
+    }
+    return (*n > 0) ? translate_field(args[0], *n, true) : NULL;
 }
 
 /* Malloc
@@ -297,6 +526,7 @@ void vr_malloc(const void* src_ptr) {
     // Send request to heap manager
     heap_manager_t* const manager = get_heap_manager();
     manager->malloc(manager, size);
+    trace_heap_call(HEAP_TRACE_MALLOC, size, registers[HEAP_PTR_OUT_REGISTER]);
 }
 
 /* Free
@@ -312,9 +542,320 @@ void vr_free(const void* src_ptr) {
 
     // Send free request to heap manager
     heap_manager_t* const manager = get_heap_manager();
+
+    // Record the call first, as an invalid free never returns
+    if (heap_trace_is_open()) {
+        trace_heap_call(HEAP_TRACE_FREE, free_addr,
+                        trace_free_result(manager, free_addr));
+    }
+
     manager->free(manager, free_addr);
 }
 
+/* Calloc
+    * Attempts to malloc() the given ammount of bytes in virtual machine memory
+      and zeroes them
+    * Saves the address of allocated memory chunk in R[28]
+    * Saves NULL in R[28] if calloc failed
+*/
+void vr_calloc(const void* src_ptr) {
+
+    // Get the size of the calloc request
+    const int32_t size = *(int32_t*)src_ptr;
+
+    // Send request to heap manager
+    heap_manager_t* const manager = get_heap_manager();
+    manager->calloc(manager, size);
+    trace_heap_call(HEAP_TRACE_CALLOC, size, registers[HEAP_PTR_OUT_REGISTER]);
+}
+
+/* Realloc
+    * Attempts to realloc() malloc'd memory - The value written is the
+      address of a descriptor in vm memory of two int32_t words:
+      { address of the memory to resize (or NULL), new size in bytes }
+    * Saves the address of the resized memory chunk in R[28]
+    * Saves NULL in R[28] if realloc failed, leaving the memory untouched
+    * Throws illegal operation error if the descriptor can't be read, or the
+      memory hasn't been allocated or is out of allowed bounds
+*/
+void vr_realloc(const void* src_ptr) {
+
+    // Get the memory to resize and its new size
+    int32_t args[2];
+    read_vr_descriptor(*(int32_t*)src_ptr, args, 2);
+    const int32_t addr = args[0];
+    const int32_t size = args[1];
+
+    // Record the address first, as an invalid realloc never returns
+    heap_manager_t* const manager = get_heap_manager();
+    if (heap_trace_is_open()) {
+        trace_heap_call(HEAP_TRACE_REALLOC_ADDR, addr,
+                        trace_free_result(manager, addr));
+    }
+
+    // Send request to heap manager
+    manager->realloc(manager, addr, size);
+    trace_heap_call(HEAP_TRACE_REALLOC_SIZE, size,
+                    registers[HEAP_PTR_OUT_REGISTER]);
+}
+
+/* Memory Copy
+    * Copies len bytes from src to dst - The value written is the address of
+      a descriptor in vm memory of three int32_t words: { dst, src, len }
+    * Overlapping fields are copied as if through a temporary buffer
+    * Each field is validated once as a whole, then copied by the host
+    * Throws illegal operation error if len < 0, or any byte of src can't
+      be read or any byte of dst can't be written
+*/
+void vr_memcpy(const void* src_ptr) {
+
+    // Get the fields
+    int32_t args[3];
+    read_vr_descriptor(*(int32_t*)src_ptr, args, 3);
+    const int32_t len = args[2];
+    if (len < 0) {
+        throw_illegal_operation_err();
+    }
+    if (len == 0) {
+        return;
+    }
+
+    // Validate and copy
+    const byte* const src = translate_field(args[1], len, false);
+    byte* const dst = translate_field(args[0], len, true);
+    memmove(dst, src, len);
+}
+
+/* Memory Set
+    * Sets len bytes at dst to the low byte of value - The value written is
+      the address of a descriptor in vm memory of three int32_t words:
+      { dst, value, len }
+    * Throws illegal operation error if len < 0, or any byte of dst can't be
+      written
+*/
+void vr_memset(const void* src_ptr) {
+
+    // Get the field
+    int32_t args[3];
+    read_vr_descriptor(*(int32_t*)src_ptr, args, 3);
+    const int32_t len = args[2];
+    if (len < 0) {
+        throw_illegal_operation_err();
+    }
+    if (len == 0) {
+        return;
+    }
+
+    // Validate and set
+    memset(translate_field(args[0], len, true), (byte)args[1], len);
+}
+
+/* Memory Compare
+    * Compares len bytes at a and b - The value written is the address of a
+      descriptor in vm memory of three int32_t words: { a, b, len }
+    * Saves -1, 0, or 1 in R[28] as the first differing byte (unsigned) of
+      a is less than, (none) equal to, or greater than that of b
+    * Throws illegal operation error if len < 0, or any byte of a or b
+      can't be read
+*/
+void vr_memcmp(const void* src_ptr) {
+
+    // Get the fields
+    int32_t args[3];
+    read_vr_descriptor(*(int32_t*)src_ptr, args, 3);
+    const int32_t len = args[2];
+    if (len < 0) {
+        throw_illegal_operation_err();
+    }
+
+    // Validate and compare
+    int cmp = 0;
+    if (len > 0) {
+        cmp = memcmp(translate_field(args[0], len, false),
+                     translate_field(args[1], len, false), len);
+    }
+    registers[VR_RESULT_REGISTER] = (cmp > 0) - (cmp < 0);
+}
+
+/* Console Write Buffer
+    * Writes len bytes from buf to stdout - The value written is the address
+      of a descriptor in vm memory of two int32_t words: { buf, len }
+    * The field is validated once as a whole, then written by the host
+    * Throws illegal operation error if len < 0, or any byte of buf can't be
+      read
+*/
+void vr_write_buf(const void* src_ptr) {
+
+    // Get the field
+    int32_t args[2];
+    read_vr_descriptor(*(int32_t*)src_ptr, args, 2);
+    const int32_t len = args[1];
+    if (len < 0) {
+        throw_illegal_operation_err();
+    }
+    if (len == 0) {
+        return;
+    }
+
+    // Validate and write
+    fwrite(translate_field(args[0], len, false), 1, len, stdout);
+    budget.output_bytes += len;
+}
+
+/* Console Write String
+    * Writes the NUL terminated string at the given address to stdout
+    * Throws illegal operation error if the string runs (before its NUL)
+      into memory that can't be read
+*/
+void vr_write_str(const void* src_ptr) {
+
+    // Find the NUL within the memory readable from the string's start
+    const int32_t addr = *(int32_t*)src_ptr;
+    const int32_t span = readable_span(addr);
+    const byte* const str = (span > 0) ? translate_field(addr, span, false)
+                                       : NULL;
+    const byte* const nul = (str != NULL) ? memchr(str, '\0', span) : NULL;
+    if (nul == NULL) {
+        throw_illegal_operation_err();
+        return;
+    }
+
+    // Write
+    const size_t len = nul - str;
+    fwrite(str, 1, len, stdout);
+    budget.output_bytes += len;
+}
+
+/* Console Read Buffer
+    * Reads up to n bytes from stdin into buf - The value written is the
+      address of a descriptor in vm memory of two int32_t words: { buf, n }
+    * Saves the number of bytes read in R[28] (less than n only at the end
+      of stdin)
+    * The whole of buf is validated once before anything is read
+    * Throws illegal operation error if n < 0, or any of the n bytes at buf
+      can't be written
+*/
+void vr_read_buf(const void* src_ptr) {
+
+    // Validate, then read
+    int32_t n;
+    byte* const buf = read_buf_descriptor(src_ptr, &n);
+    const size_t n_read = (n > 0) ? fread(buf, 1, n, stdin) : 0;
+
+    registers[VR_RESULT_REGISTER] = (int32_t)n_read;
+    budget.input_bytes += n_read;
+}
+
+/* Console Read Line
+    * As Console Read Buffer, but also stops after the first newline, which
+      is kept in buf (no NUL is added)
+    * Saves the number of bytes read in R[28] (0 only at the end of stdin)
+*/
+void vr_read_line(const void* src_ptr) {
+
+    // Validate
+    int32_t n;
+    byte* const buf = read_buf_descriptor(src_ptr, &n);
+
+    // Read up to and including the newline
+    int32_t n_read = 0;
+    while (n_read < n) {
+        const int c = getc(stdin);
+        if (c == EOF) {
+            break;
+        }
+        buf[n_read++] = (byte)c;
+        if (c == '\n') {
+            break;
+        }
+    }
+
+    registers[VR_RESULT_REGISTER] = n_read;
+    budget.input_bytes += n_read;
+}
+
+
+// VIRTUAL ROUTINE REGISTRY ...
+
+// Virtual routines triggered by stores, indexed by VR_SLOT()
+static vr_write_entry_t vr_write_table[VR_TABLE_SIZE] = {
+    [VR_SLOT(VR_WRITE_CHAR_ADDR)] = {VR_WRITE_CHAR_ADDR, &vr_write_char},
+    [VR_SLOT(VR_WRITE_INT_ADDR)] = {VR_WRITE_INT_ADDR, &vr_write_int},
+    [VR_SLOT(VR_WRITE_UINT_ADDR)] = {VR_WRITE_UINT_ADDR, &vr_write_uint},
+    [VR_SLOT(VR_HALT_ADDR)] = {VR_HALT_ADDR, &vr_halt},
+    [VR_SLOT(VR_DUMP_PC_ADDR)] = {VR_DUMP_PC_ADDR, &vr_dump_pc},
+    [VR_SLOT(VR_DUMP_REG_ADDR)] = {VR_DUMP_REG_ADDR, &vr_dump_registers},
+    [VR_SLOT(VR_DUMP_MEM_WORD_ADDR)] = {VR_DUMP_MEM_WORD_ADDR, &vr_dump_word},
+    [VR_SLOT(VR_HEAP_BANK_MALLOC_ADDR)] = {VR_HEAP_BANK_MALLOC_ADDR, &vr_malloc},
+    [VR_SLOT(VR_HEAP_BANK_FREE_ADDR)] = {VR_HEAP_BANK_FREE_ADDR, &vr_free},
+    [VR_SLOT(VR_HEAP_BANK_CALLOC_ADDR)] = {VR_HEAP_BANK_CALLOC_ADDR, &vr_calloc},
+    [VR_SLOT(VR_HEAP_BANK_REALLOC_ADDR)] = {VR_HEAP_BANK_REALLOC_ADDR, &vr_realloc},
+    [VR_SLOT(VR_MEMCPY_ADDR)] = {VR_MEMCPY_ADDR, &vr_memcpy},
+    [VR_SLOT(VR_MEMSET_ADDR)] = {VR_MEMSET_ADDR, &vr_memset},
+    [VR_SLOT(VR_MEMCMP_ADDR)] = {VR_MEMCMP_ADDR, &vr_memcmp},
+    [VR_SLOT(VR_WRITE_BUF_ADDR)] = {VR_WRITE_BUF_ADDR, &vr_write_buf},
+    [VR_SLOT(VR_WRITE_STR_ADDR)] = {VR_WRITE_STR_ADDR, &vr_write_str},
+    [VR_SLOT(VR_READ_BUF_ADDR)] = {VR_READ_BUF_ADDR, &vr_read_buf},
+    [VR_SLOT(VR_READ_LINE_ADDR)] = {VR_READ_LINE_ADDR, &vr_read_line},
+};
+
+// Virtual routines triggered by loads, indexed by VR_SLOT()
+static vr_read_entry_t vr_read_table[VR_TABLE_SIZE] = {
+    [VR_SLOT(VR_READ_CHAR_ADDR)] = {VR_READ_CHAR_ADDR, &vr_read_char},
+    [VR_SLOT(VR_READ_INT_ADDR)] = {VR_READ_INT_ADDR, &vr_read_int},
+};
+
+/* Returns whether a routine at the given address can take the table slot
+    currently holding a routine at 'slot_addr' (0 if unused)
+*/
+static bool can_take_vr_slot(const int32_t addr, const int32_t slot_addr) {
+    return (slot_addr == 0 || slot_addr == addr);
+}
+
+/* Registers a virtual routine called on stores to the given address
+    * Replaces any routine already registered at the address
+    * A NULL handler removes the routine at the address
+
+    RETURNS
+    true  | On success
+    false | If the address is outside virtual mem, or its table slot holds
+            a routine at another address
+*/
+bool register_vr_write(const int32_t addr, const vr_write_handler_t handler) {
+    if (addr < VIRT_MEM_START || addr > VIRT_MEM_END) {
+        return false;
+    }
+    vr_write_entry_t* const entry = &vr_write_table[VR_SLOT(addr)];
+    if (!can_take_vr_slot(addr, entry->addr)) {
+        return false;
+    }
+    entry->addr = (handler != NULL) ? addr : 0;
+    entry->handler = handler;
+    return true;
+}
+
+/* Registers a virtual routine called on loads from the given address
+    * Replaces any routine already registered at the address
+    * A NULL handler removes the routine at the address
+
+    RETURNS
+    true  | On success
+    false | If the address is outside virtual mem, or its table slot holds
+            a routine at another address
+*/
+bool register_vr_read(const int32_t addr, const vr_read_handler_t handler) {
+    if (addr < VIRT_MEM_START || addr > VIRT_MEM_END) {
+        return false;
+    }
+    vr_read_entry_t* const entry = &vr_read_table[VR_SLOT(addr)];
+    if (!can_take_vr_slot(addr, entry->addr)) {
+        return false;
+    }
+    entry->addr = (handler != NULL) ? addr : 0;
+    entry->handler = handler;
+    return true;
+}
+
 
 // MEMORY INTERFACE FUNCTIONS ...
 
@@ -338,95 +879,83 @@ void mem_write(const void* const src_ptr, const int32_t dst_addr,
         printf("Write request to: 0x%08X\n", dst_addr);
     #endif
 
-    // Bool to hold error state
-    bool err = false;
+    // Virtual routines - One range check, then one table lookup
+    if ((uint32_t)(dst_addr - VIRT_MEM_START) < VIRT_MEM_SIZE) {
+        const vr_write_entry_t* const vr = &vr_write_table[VR_SLOT(dst_addr)];
+        if (vr->addr != dst_addr) {
+            throw_illegal_operation_err();
+            return;
+        }
+        vr->handler(src_ptr);
+        return;
+    }
 
-    // The end address (inclusive) of the mem write field
-    const int end_addr = dst_addr + data_size - 1;
+    mem_write_memory(src_ptr, dst_addr, data_size);
+}
 
-    // Check for virtual routine
-    switch (dst_addr) {
+/* Handle write to memory request known not to be a virtual routine call
 
-        // Console write char
-        case VR_WRITE_CHAR_ADDR:
-            vr_write_char(src_ptr);
-            break;
+    * Verifies memory destination integrity
+    * Performs write if necessary
 
-        // Console write signed int
-        case VR_WRITE_INT_ADDR:
-            vr_write_int(src_ptr); 
-            break;
+    PARAMS
+    src_ptr   | Pointer to the data source to be copied
+    dst_addr  | Destination address in vm memory space
+    data_size | The size of the data to be copied (in bytes)
 
-        // Console write unsigned int
-        case VR_WRITE_UINT_ADDR:
-            vr_write_uint(src_ptr);
-            break;
+*/
+void mem_write_memory(const void* const src_ptr, const int32_t dst_addr,
+                      const int data_size) {
 
-        // Halt virtual routine
-        case VR_HALT_ADDR:
-            vr_halt();
-            break;
-        
-        // Dump PC
-        case VR_DUMP_PC_ADDR:
-            vr_dump_pc();
-            break;
-        
-        // Dump register banks
-        case VR_DUMP_REG_ADDR:
-            vr_dump_registers();
-            break;
-        
-        // Dump memory word
-        case VR_DUMP_MEM_WORD_ADDR:
-            vr_dump_word(src_ptr);
-            break;
-        
-        // Heap bank - malloc
-        case VR_HEAP_BANK_MALLOC_ADDR:
-            vr_malloc(src_ptr);
-            break;
+    // Bool to hold error state
+    bool err = false;
 
-        // Heap bank - free
-        case VR_HEAP_BANK_FREE_ADDR:
-            vr_free(src_ptr);
-            break;
+    // The end address (inclusive) of the mem write field
+    const int end_addr = dst_addr + data_size - 1;
 
-        // If not virtual routine
-        default:
+    // Where the field is stored in host memory
+    byte* host_ptr = NULL;
+
+    // Guard page mode - The MMU bounds checks everything but the heap
+    if (guard_pages.enabled &&
+        (dst_addr < HEAP_MEM_START || dst_addr > HEAP_MEM_END)) {
+        guarded_write(src_ptr, dst_addr, data_size);
+        return;
+    }
+
+    // Validate mem write request and translate to host memory ...
+
+    // If within data memory bounds
+    if ((dst_addr >= DATA_MEM_START && dst_addr <= DATA_MEM_END) &&
+        (end_addr >= DATA_MEM_START && end_addr <= DATA_MEM_END)) {
+        // No further verification needed
+        host_ptr = &memory[dst_addr];
+    } 
+
+    // If within heap memory bounds
+    else if ((dst_addr >= HEAP_MEM_START && dst_addr <= HEAP_MEM_END) &&
+             (end_addr >= HEAP_MEM_START && end_addr <= HEAP_MEM_END)) {
+
+        // Check if accessing non-allocated memory or across allocated chunks
+        heap_manager_t* const manager = get_heap_manager();
+        if (!manager->is_valid_memory(manager, dst_addr, data_size)) {
+            err = true; 
+            throw_illegal_operation_err();
+        }
+        host_ptr = &heap_memory[dst_addr - HEAP_MEM_START];
+    }
 
-            // Validate mem write request ...
-
-            // If within data memory bounds
-            if ((dst_addr >= DATA_MEM_START && dst_addr <= DATA_MEM_END) &&
-                (end_addr >= DATA_MEM_START && end_addr <= DATA_MEM_END)) {
-                // No further verification needed
-            } 
-
-            // If within heap memory bounds
-            else if ((dst_addr >= HEAP_MEM_START && dst_addr <= HEAP_MEM_END) &&
-                     (end_addr >= HEAP_MEM_START && end_addr <= HEAP_MEM_END)) {
-
-                // Check if accessing non-allocated memory or across allocated chunks
-                heap_manager_t* const manager = get_heap_manager();
-                if (!manager->is_valid_memory(manager, dst_addr, data_size)) {
-                    err = true; 
-                    throw_illegal_operation_err();
-                }
-            }
-
-            // If outside valid memory write access
-            else {
-                err = true;
-                throw_illegal_operation_err();
-            }
-            
-            // Perform write if no error - Copy bytes
-            if (!err) {
-                for (int i = 0; i < data_size; i++) {
-                    memory[dst_addr + i] = *((byte*)src_ptr + i);
-                }
-            }
+    // If outside valid memory write access
+    else {
+        err = true;
+        throw_illegal_operation_err();
+    }
+    
+    // Perform write if no error - Copy bytes
+    if (!err) {
+        for (int i = 0; i < data_size; i++) {
+            host_ptr[i] = *((byte*)src_ptr + i);
+        }
     }
 }
 
@@ -450,60 +979,83 @@ void mem_read(void* const dst_ptr, const int32_t src_addr,
         printf("Read request from: 0x%08X\n", src_addr);
     #endif
 
+    // Virtual routines - One range check, then one table lookup
+    if ((uint32_t)(src_addr - VIRT_MEM_START) < VIRT_MEM_SIZE) {
+        const vr_read_entry_t* const vr = &vr_read_table[VR_SLOT(src_addr)];
+        if (vr->addr != src_addr) {
+            throw_illegal_operation_err();
+            return;
+        }
+        vr->handler(dst_ptr);
+        return;
+    }
+
+    mem_read_memory(dst_ptr, src_addr, data_size);
+}
+
+/* Handle read from memory request known not to be a virtual routine call
+
+    * Verifies memory source integrity
+    * Performs read if necessary
+
+    PARAMS
+    dst_ptr   | Pointer to the memory that should be overwritten with read data
+    src_addr  | Source address in vm memory space
+    data_size | The size of the data to be read in bytes
+
+*/
+void mem_read_memory(void* const dst_ptr, const int32_t src_addr,
+                     const int data_size) {
+
     // Bool to hold error state
     bool err = false;
 
     // The end address (inclusive) of the mem read field
     const int end_addr = src_addr + data_size - 1;
 
-    // Check for virtual routine
-    switch (src_addr) {
-
-        // Console read int
-        case VR_READ_INT_ADDR:
-            vr_read_int(dst_ptr);
-            break;
+    // Where the field is stored in host memory
+    const byte* host_ptr = NULL;
 
-        // Console read char
-        case VR_READ_CHAR_ADDR:
-            vr_read_char(dst_ptr);
-            break;
-
-        // Attempt read
-        default:
-
-            // Validate mem read request ...
+    // Guard page mode - The MMU bounds checks everything but the heap
+    if (guard_pages.enabled &&
+        (src_addr < HEAP_MEM_START || src_addr > HEAP_MEM_END)) {
+        guarded_read(dst_ptr, src_addr, data_size);
+        return;
+    }
 
-            // If within instruction or data memory
-            if ((src_addr >= INST_MEM_START && src_addr <= DATA_MEM_END) &&
-                (end_addr >= INST_MEM_START && end_addr <= DATA_MEM_END)) {
-                    // No more validation needed
-            }
+    // Validate mem read request and translate to host memory ...
 
-            // If within heap bank memory
-            else if ((src_addr >= HEAP_MEM_START && src_addr <= HEAP_MEM_END) &&
-                (end_addr >= HEAP_MEM_START && end_addr <= HEAP_MEM_END)) {
+    // If within instruction or data memory
+    if ((src_addr >= INST_MEM_START && src_addr <= DATA_MEM_END) &&
+        (end_addr >= INST_MEM_START && end_addr <= DATA_MEM_END)) {
+            // No more validation needed
+            host_ptr = &memory[src_addr];
+    }
 
-                // Check if accessing non-allocated memory or across allocated chunks
-                heap_manager_t* const manager = get_heap_manager();
-                if (!manager->is_valid_memory(manager, src_addr, data_size)) {
-                    err = true;
-                    throw_illegal_operation_err();
-                }
-            }
+    // If within heap bank memory
+    else if ((src_addr >= HEAP_MEM_START && src_addr <= HEAP_MEM_END) &&
+        (end_addr >= HEAP_MEM_START && end_addr <= HEAP_MEM_END)) {
+
+        // Check if accessing non-allocated memory or across allocated chunks
+        heap_manager_t* const manager = get_heap_manager();
+        if (!manager->is_valid_memory(manager, src_addr, data_size)) {
+            err = true;
+            throw_illegal_operation_err();
+        }
+        host_ptr = &heap_memory[src_addr - HEAP_MEM_START];
+    }
 
-            // Else outside valid memory read access
-            else {
-                err = true;
-                throw_illegal_operation_err();
-            }
+    // Else outside valid memory read access
+    else {
+        err = true;
+        throw_illegal_operation_err();
+    }
 
-            // Read by copying bytes to output dst
-            if (!err) {
-                for (int i = 0; i < data_size; i++) {
-                    *((byte*)dst_ptr + i) = memory[src_addr + i];
-                }
-            }
+    // Read by copying bytes to output dst
+    if (!err) {
+        for (int i = 0; i < data_size; i++) {
+            *((byte*)dst_ptr + i) = host_ptr[i];
+        }
     }
 }
 
@@ -512,30 +1064,64 @@ void mem_read(void* const dst_ptr, const int32_t src_addr,
 
 /* Initialises the system
     Initialises, allocates, and links required system vars and methods
+    * Memory and the heap manager are sized by the heap geometry options
+    * Sets the system error code on host malloc failure
 */
-void system_init() {
+void system_init(const vm_options_t* const opts) {
 
-    // Zero registers, memory, and pc
+    // Zero registers and pc
      // NOTE
      // As per C standard all globals will already be zero initialised but
      // doing it anyway increases future portability with minimal overhead
     pc = 0;
-    for (int i = 0; i < MEM_SIZE_BYTES; i++) {
-        memory[i] = 0;
-    }
+    instr_size = DFLT_PC_INCREMENT;
     for (int i = 0; i < NUM_REGISTERS; i++) {
         registers[i] = 0;
+        fregisters[i] = 0;
     }
+    fcsr = 0;
 
     // Set error status to 'no error'
     set_system_error_code(ERR_NO_ERR);
 
-    // Set CPU to run
+    // Set CPU to run - Trap handler is armed later by the run loop
     set_cpu_run_status(true);
+    cpu_status.trap_armed = false;
+
+    // Set heap geometry - Options have already been validated
+    heap_geometry.bank_size = (int32_t)opts->heap_bank_size;
+    heap_geometry.mem_size = (int32_t)opts->heap_size;
+    heap_geometry.bank_num = heap_geometry.mem_size / heap_geometry.bank_size;
+    heap_geometry.mem_end = HEAP_MEM_START + heap_geometry.mem_size - 0x01;
+
+    // Allocate zeroed memory
+    if (opts->guard_pages) {
+
+        // Image segment lives in the guard page mappings
+        heap_memory = calloc(heap_geometry.mem_size, sizeof(byte));
+        if (heap_memory == NULL || !guard_pages_init()) {
+            throw_host_malloc_failed_err();
+            return;
+        }
+        memory = guard_pages.read_base;
+    }
+    else {
+
+        // The heap bank segment follows the image
+        memory = calloc(MEM_SIZE_BYTES, sizeof(byte));
+        if (memory == NULL) {
+            throw_host_malloc_failed_err();
+            return;
+        }
+        heap_memory = memory + HEAP_SEG_OFFSET;
+    }
 
     // Initialise and link heap bank manager
-    heap_manager_t* const manager = heap_manager_init();
-    link_heap_manager(manager);
+    if (!heap_manager_init(&heap_manager, opts->heap_policy)) {
+        throw_host_malloc_failed_err();
+        return;
+    }
+    link_heap_manager(&heap_manager);
 }
 
 /* Deinitialises the system
@@ -545,6 +1131,16 @@ void system_init() {
 void system_deinit() {
     
     // Free heap bank manager
-    heap_manager_t* const manager = get_heap_manager();
-    manager->deallocate(manager);
-}
\ No newline at end of file
+    heap_manager_deallocate(&heap_manager);
+
+    // Free memory
+    if (guard_pages.enabled) {
+        free(heap_memory);
+        guard_pages_deinit();
+    }
+    else {
+        free(memory);
+    }
+    memory = NULL;
+    heap_memory = NULL;
+}
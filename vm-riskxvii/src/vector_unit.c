@@ -0,0 +1,287 @@
+// Name:   Isaak Choi
+// UniKey: icho6322
+// SID:    520488399
+
+
+// DEPENDENCIES ...
+#include "vector_unit.h"
+#include <string.h>
+
+
+// CONSTANTS ...
+
+// Bytes in each SIMD block - One AVX2 register, or two SSE2 registers
+#define VEC_BLOCK_BYTES     (32)
+
+// Element widths are 1, 2 or 4 bytes - Halving gives the kernel table index
+#define VEC_NUM_WIDTHS      (3)
+#define VEC_WIDTH_INDEX(w)  ((w) >> 1)
+
+
+// TYPES ...
+
+// One SIMD block of elements of each width - Unsigned so that arithmetic
+// wraps, and reinterpreted as signed for comparisons
+typedef uint8_t  vec_u8_t  __attribute__((vector_size(VEC_BLOCK_BYTES)));
+typedef uint16_t vec_u16_t __attribute__((vector_size(VEC_BLOCK_BYTES)));
+typedef uint32_t vec_u32_t __attribute__((vector_size(VEC_BLOCK_BYTES)));
+typedef int8_t   vec_i8_t  __attribute__((vector_size(VEC_BLOCK_BYTES)));
+typedef int16_t  vec_i16_t __attribute__((vector_size(VEC_BLOCK_BYTES)));
+typedef int32_t  vec_i32_t __attribute__((vector_size(VEC_BLOCK_BYTES)));
+
+// The narrow elements a dot product widens to one block of int32_t
+typedef int8_t   vec_i8x8_t  __attribute__((vector_size(8)));
+typedef int16_t  vec_i16x8_t __attribute__((vector_size(16)));
+
+// Kernels run their operation over as many whole blocks of the 'n'
+// elements as fit, and return how many elements that was
+typedef int32_t (*vec_map_kernel_t)(const byte* src1, const byte* src2,
+                                    byte* dst, const int32_t n);
+typedef int32_t (*vec_dot_kernel_t)(const byte* src1, const byte* src2,
+                                    const int32_t n, uint32_t* const sum);
+
+// The kernels built for one host instruction set
+typedef struct vec_kernels_t vec_kernels_t;
+struct vec_kernels_t {
+    vec_map_kernel_t map[VEC_NUM_MAP_OPS][VEC_NUM_WIDTHS];
+    vec_dot_kernel_t dot[VEC_NUM_WIDTHS];
+};
+
+
+// SIMD KERNELS ...
+
+// Elementwise operations on blocks 'a' and 'b' of type 'vec_t', where
+// 'svec_t' is the signed block type of the same width
+#define VEC_ADD(vec_t, svec_t, a, b)    ((a) + (b))
+#define VEC_MUL(vec_t, svec_t, a, b)    ((a) * (b))
+#define VEC_MIN(vec_t, svec_t, a, b)    vec_select(vec_t, \
+            (vec_t)((svec_t)(a) < (svec_t)(b)), a, b)
+#define VEC_MAX(vec_t, svec_t, a, b)    vec_select(vec_t, \
+            (vec_t)((svec_t)(a) > (svec_t)(b)), a, b)
+
+// Picks 'a' where the comparison mask is all ones, otherwise 'b'
+#define vec_select(vec_t, mask, a, b)   (((a) & (mask)) | ((b) & ~(mask)))
+
+// Defines an elementwise kernel - Blocks are copied in and out, as vm
+// arrays need not be aligned
+#define VEC_MAP_KERNEL(name, vec_t, svec_t, OP)                               \
+    static int32_t name(const byte* src1, const byte* src2,                   \
+                        byte* dst, const int32_t n) {                         \
+        const int32_t lanes = sizeof(vec_t) / sizeof(((vec_t){0})[0]);        \
+        const int32_t blocks_end = n - n % lanes;                             \
+        for (int32_t i = 0; i < blocks_end; i += lanes) {                     \
+            vec_t a, b;                                                       \
+            memcpy(&a, src1, sizeof(vec_t));                                  \
+            memcpy(&b, src2, sizeof(vec_t));                                  \
+            const vec_t r = OP(vec_t, svec_t, a, b);                          \
+            memcpy(dst, &r, sizeof(vec_t));                                   \
+            src1 += sizeof(vec_t);                                            \
+            src2 += sizeof(vec_t);                                            \
+            dst += sizeof(vec_t);                                             \
+        }                                                                     \
+        return blocks_end;                                                    \
+    }
+
+// Defines a dot product kernel - 'part_t' elements are widened to a block
+// of int32_t, which are multiplied and summed lane by lane
+#define VEC_DOT_KERNEL(name, part_t)                                          \
+    static int32_t name(const byte* src1, const byte* src2,                   \
+                        const int32_t n, uint32_t* const sum) {               \
+        const int32_t lanes = sizeof(vec_u32_t) / sizeof(uint32_t);           \
+        const int32_t blocks_end = n - n % lanes;                             \
+        vec_u32_t acc = {0};                                                  \
+        for (int32_t i = 0; i < blocks_end; i += lanes) {                     \
+            part_t a, b;                                                      \
+            memcpy(&a, src1, sizeof(part_t));                                 \
+            memcpy(&b, src2, sizeof(part_t));                                 \
+            acc += (vec_u32_t)__builtin_convertvector(a, vec_i32_t) *         \
+                   (vec_u32_t)__builtin_convertvector(b, vec_i32_t);          \
+            src1 += sizeof(part_t);                                           \
+            src2 += sizeof(part_t);                                           \
+        }                                                                     \
+        for (int32_t l = 0; l < lanes; l++) {                                 \
+            *sum += acc[l];                                                   \
+        }                                                                     \
+        return blocks_end;                                                    \
+    }
+
+// Defines every kernel for the instruction set being compiled for, and the
+// table 'vec_kernels_<isa>' of them
+#define VEC_KERNELS(isa)                                                      \
+    VEC_MAP_KERNEL(add_i8_##isa,  vec_u8_t,  vec_i8_t,  VEC_ADD)              \
+    VEC_MAP_KERNEL(add_i16_##isa, vec_u16_t, vec_i16_t, VEC_ADD)              \
+    VEC_MAP_KERNEL(add_i32_##isa, vec_u32_t, vec_i32_t, VEC_ADD)              \
+    VEC_MAP_KERNEL(mul_i8_##isa,  vec_u8_t,  vec_i8_t,  VEC_MUL)              \
+    VEC_MAP_KERNEL(mul_i16_##isa, vec_u16_t, vec_i16_t, VEC_MUL)              \
+    VEC_MAP_KERNEL(mul_i32_##isa, vec_u32_t, vec_i32_t, VEC_MUL)              \
+    VEC_MAP_KERNEL(min_i8_##isa,  vec_u8_t,  vec_i8_t,  VEC_MIN)              \
+    VEC_MAP_KERNEL(min_i16_##isa, vec_u16_t, vec_i16_t, VEC_MIN)              \
+    VEC_MAP_KERNEL(min_i32_##isa, vec_u32_t, vec_i32_t, VEC_MIN)              \
+    VEC_MAP_KERNEL(max_i8_##isa,  vec_u8_t,  vec_i8_t,  VEC_MAX)              \
+    VEC_MAP_KERNEL(max_i16_##isa, vec_u16_t, vec_i16_t, VEC_MAX)              \
+    VEC_MAP_KERNEL(max_i32_##isa, vec_u32_t, vec_i32_t, VEC_MAX)              \
+    VEC_DOT_KERNEL(dot_i8_##isa,  vec_i8x8_t)                                 \
+    VEC_DOT_KERNEL(dot_i16_##isa, vec_i16x8_t)                                \
+    VEC_DOT_KERNEL(dot_i32_##isa, vec_i32_t)                                  \
+    static const vec_kernels_t vec_kernels_##isa = {                          \
+        .map = {                                                              \
+            [VEC_OP_ADD] = { add_i8_##isa, add_i16_##isa, add_i32_##isa },    \
+            [VEC_OP_MUL] = { mul_i8_##isa, mul_i16_##isa, mul_i32_##isa },    \
+            [VEC_OP_MIN] = { min_i8_##isa, min_i16_##isa, min_i32_##isa },    \
+            [VEC_OP_MAX] = { max_i8_##isa, max_i16_##isa, max_i32_##isa },    \
+        },                                                                    \
+        .dot = { dot_i8_##isa, dot_i16_##isa, dot_i32_##isa },                \
+    };
+
+// The host's baseline instruction set - SSE2 on x86-64
+VEC_KERNELS(base)
+
+// AVX2 - Compiled in always, run only when the host supports it
+#if defined(__x86_64__) || defined(__i386__)
+    #define VEC_HAVE_AVX2
+    #pragma GCC push_options
+    #pragma GCC target("avx2")
+    VEC_KERNELS(avx2)
+    #pragma GCC pop_options
+#endif
+
+// The kernels picked by vector_unit_init()
+static const vec_kernels_t* kernels = &vec_kernels_base;
+
+
+// SCALAR HELPERS ...
+
+/* Returns the sign extended element at the given index of an array */
+static int32_t load_element(const byte* const array, const int32_t index,
+                            const int32_t width) {
+    const byte* const src = array + (int64_t)index * width;
+    switch (width) {
+        case 1: { int8_t v;  memcpy(&v, src, 1); return v; }
+        case 2: { int16_t v; memcpy(&v, src, 2); return v; }
+        default: { int32_t v; memcpy(&v, src, 4); return v; }
+    }
+}
+
+/* Stores the low 'width' bytes of the value at the given index of an array */
+static void store_element(byte* const array, const int32_t index,
+                          const int32_t width, const uint32_t value) {
+    byte* const dst = array + (int64_t)index * width;
+    switch (width) {
+        case 1: { uint8_t v = (uint8_t)value;   memcpy(dst, &v, 1); break; }
+        case 2: { uint16_t v = (uint16_t)value; memcpy(dst, &v, 2); break; }
+        default: memcpy(dst, &value, 4); break;
+    }
+}
+
+/* Runs an elementwise operation one element at a time, from element 'from'
+   up to element 'n'
+*/
+static void scalar_map(const int32_t op, const int32_t width,
+                       const byte* const src1, const byte* const src2,
+                       byte* const dst, const int32_t from, const int32_t n) {
+    for (int32_t i = from; i < n; i++) {
+        const int32_t a = load_element(src1, i, width);
+        const int32_t b = load_element(src2, i, width);
+        uint32_t r;
+        switch (op) {
+            case VEC_OP_ADD: r = (uint32_t)a + (uint32_t)b; break;
+            case VEC_OP_MUL: r = (uint32_t)a * (uint32_t)b; break;
+            case VEC_OP_MIN: r = (uint32_t)(a < b ? a : b); break;
+            default:         r = (uint32_t)(a > b ? a : b); break;
+        }
+        store_element(dst, i, width, r);
+    }
+}
+
+/* Returns whether the fields of 'len' bytes at 'a' and 'b' overlap without
+   starting at the same address
+*/
+static bool fields_partly_overlap(const byte* const a, const byte* const b,
+                                  const int32_t len) {
+    return a != b && a < b + len && b < a + len;
+}
+
+
+// VIRTUAL ROUTINES ...
+
+/* Vector Unit - Run
+    * Runs the operation of the descriptor at the given address (see the
+      top of vector_unit.h)
+*/
+void vr_vector_run(const void* src_ptr) {
+
+    // Get the fields
+    int32_t args[VEC_DESC_WORDS];
+    read_vr_descriptor(*(int32_t*)src_ptr, args, VEC_DESC_WORDS);
+    const int32_t op = args[VEC_DESC_OP];
+    const int32_t width = args[VEC_DESC_WIDTH];
+    const int32_t len = args[VEC_DESC_LEN];
+    if (op < VEC_OP_ADD || op > VEC_OP_PREFIX_SUM ||
+        (width != 1 && width != 2 && width != 4) ||
+        len < 0 || len > INT32_MAX / width) {
+        throw_illegal_operation_err();
+    }
+    const int32_t bytes = len * width;
+
+    // Dot product - The sum is saved even for empty arrays
+    if (op == VEC_OP_DOT) {
+        uint32_t sum = 0;
+        if (len > 0) {
+            const byte* const src1 = translate_field(args[VEC_DESC_SRC1],
+                                                     bytes, false);
+            const byte* const src2 = translate_field(args[VEC_DESC_SRC2],
+                                                     bytes, false);
+            const int32_t done = kernels->dot[VEC_WIDTH_INDEX(width)](
+                                    src1, src2, len, &sum);
+            for (int32_t i = done; i < len; i++) {
+                sum += (uint32_t)load_element(src1, i, width) *
+                       (uint32_t)load_element(src2, i, width);
+            }
+        }
+        registers[VR_RESULT_REGISTER] = (int32_t)sum;
+        return;
+    }
+    if (len == 0) {
+        return;
+    }
+
+    // Validate every array the operation uses before writing any of dst
+    const byte* const src1 = translate_field(args[VEC_DESC_SRC1], bytes, false);
+    const byte* const src2 = (op == VEC_OP_PREFIX_SUM) ? src1 :
+                             translate_field(args[VEC_DESC_SRC2], bytes, false);
+    byte* const dst = translate_field(args[VEC_DESC_DST], bytes, true);
+    if (fields_partly_overlap(dst, src1, bytes) ||
+        fields_partly_overlap(dst, src2, bytes)) {
+        throw_illegal_operation_err();
+    }
+
+    // Prefix sum - Each element depends on the last, so it runs in order
+    if (op == VEC_OP_PREFIX_SUM) {
+        uint32_t sum = 0;
+        for (int32_t i = 0; i < len; i++) {
+            sum += (uint32_t)load_element(src1, i, width);
+            store_element(dst, i, width, sum);
+        }
+        return;
+    }
+
+    // Elementwise - Whole blocks on the SIMD kernel, then the rest
+    const int32_t done = kernels->map[op][VEC_WIDTH_INDEX(width)](
+                            src1, src2, dst, len);
+    scalar_map(op, width, src1, src2, dst, done, len);
+}
+
+
+// INITIALISER ...
+
+/* Picks the SIMD kernels for the host and registers vr_vector_run() at
+   VR_VECTOR_RUN_ADDR
+*/
+void vector_unit_init() {
+    #ifdef VEC_HAVE_AVX2
+        if (__builtin_cpu_supports("avx2")) {
+            kernels = &vec_kernels_avx2;
+        }
+    #endif
+    register_vr_write(VR_VECTOR_RUN_ADDR, vr_vector_run);
+}
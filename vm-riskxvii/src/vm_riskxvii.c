@@ -18,7 +18,7 @@
 
 // FUNCTIONS ...
 
-/* Reads in the memory image binary file.
+/* Reads in the memory image binary file at the given path.
 
     Data read from the file is saved into the global 'memory' array
 
@@ -27,16 +27,9 @@
     n < 0 | A non-zero error code (n < 0) on failure
     
 */
-int read_bin_file(int argc, char** argv) {
-
-    // Ensure correct ammount of arguments given
-    if (argc != REQUIRED_ARG_NUM) {
-        printf("ERR: Invalid args\n");
-        return ERR_INVALID_ARGS;
-    }
+int read_bin_file(const char* const fpath) {
 
     // Open specified binary file
-    const char* fpath = argv[BIN_SRC_ARG_INDX];
     FILE* fptr;
     fptr = fopen(fpath, "rb"); // rb -> read binary
 
@@ -58,7 +51,7 @@ int read_bin_file(int argc, char** argv) {
     const long n_ins_bytes_read = fread(memory, INST_MEM_SIZE, 1, fptr);
 
     // Read in data
-    byte* const data_start_ptr = (byte* const)&memory + INST_MEM_SIZE;
+    byte* const data_start_ptr = memory + INST_MEM_SIZE;
     const long n_dat_bytes_read = fread(data_start_ptr, DATA_MEM_SIZE, 1, fptr);
 
     // Check error in reading
@@ -82,6 +75,7 @@ int read_bin_file(int argc, char** argv) {
 
 /* Main - Program entrypoint
     
+    * Parses command line options
     * Reads in memory image binary file and sets up vm memory
     * Executes loaded binary
     * Exits with any encountered error codes
@@ -101,58 +95,129 @@ int main(int argc, char** argv) {
         atexit(report_mem_leak);
     #endif
 
+    // Parse command line options
+    if (!parse_options(argc, argv)) {
+        printf("ERR: Invalid args\n");
+        return ERR_INVALID_ARGS;
+    }
+
     // Initialise the vm system
-    system_init();
+    system_init(&options);
     err = get_system_error_code();
     if (err != ERR_NO_ERR) {
+        system_deinit();
         return err;
     }
+    vector_unit_init();
 
     // Read in memory image binary file
-    err = read_bin_file(argc, argv);
+    err = read_bin_file(options.bin_path);
     if (err != ERR_NO_ERR) {
+        system_deinit();
         return err;
     }
 
-    // Run binary on virtual machine
-    do {
-
-        // Get next instruction
-        const uint32_t instr = get_instruction();
-
-        // Stepper for debugging
-        #ifdef DEBUG_STEP_THROUGH
-            fflush(stdout);
-            fgetc(stdin);
-        #endif
-        #ifdef DEBUG_PRINT_PC
-            printf("PC    | 0x%08X\n", pc);
-        #endif
-
-        // Execute
-        exec_instruction(instr);
-
-        // Reset zero register to prevent values being stored there
-        registers[ZERO_REGISTER_ADDR] = ZERO_REGISTER_VAL;
-
-        // Check for error
-        err = get_system_error_code();
-        if (err != ERR_NO_ERR) {
-            set_cpu_run_status(false);
-            break;
+    // Expand compressed instructions once, as instruction memory is final
+    if (options.ext_c) {
+        rvc_predecode();
+    }
+
+    // Instruction memory is read only from here on in guard page mode
+    if (guard_pages.enabled) {
+        guard_pages_seal();
+    }
+
+    // Load the ahead of time translation of the image
+    if (options.aot_path != NULL && !aot_load(options.aot_path)) {
+        printf("ERR: Couldn't load translated image \"%s\"\n",
+               options.aot_path);
+        system_deinit();
+        return ERR_AOT_LOAD;
+    }
+
+    // Prove what can be proven about where each load and store goes, now
+    // that instruction memory is final
+    mem_proofs_init(&options);
+
+    // Start recording heap events
+    if (options.heap_trace_path != NULL) {
+        const heap_trace_header_t header = {
+            heap_geometry.bank_size, heap_geometry.mem_size, options.heap_policy
+        };
+        if (!heap_trace_open(options.heap_trace_path, &header)) {
+            printf("ERR: Couldn't open file \"%s\"\n", options.heap_trace_path);
+            system_deinit();
+            return ERR_COULDNT_OPEN;
         }
+    }
 
-        // Check program counter bounds
-        if (pc >= INST_MEM_SIZE || pc < 0) {
-            throw_pc_out_of_bounds_err();
-            err = get_system_error_code();
-            break;
+    // Start the execution budget and hot loop detection
+    budget_init(&options);
+    hot_loops_init(&options);
+
+    // Run binary on virtual machine
+     // Halts and errors raise a trap which longjmps back here, so the loop
+     // itself never has to check the CPU run status or error code
+    if (setjmp(cpu_status.trap_env) == 0) {
+        cpu_status.trap_armed = true;
+        while (true) {
+
+            // Run the translated block starting here, if there is one
+            const aot_block_t block = aot_blocks[pc];
+            if (block != NULL) {
+                block(&aot_host);
+            }
+
+            // Otherwise interpret the next instruction
+            else {
+
+                // Get next instruction
+                const uint32_t instr = (
+                    options.ext_c ? rvc_fetch_instruction() : get_instruction());
+
+                // Stepper for debugging
+                #ifdef DEBUG_STEP_THROUGH
+                    fflush(stdout);
+                    fgetc(stdin);
+                #endif
+                #ifdef DEBUG_PRINT_PC
+                    printf("PC    | 0x%08X\n", pc);
+                #endif
+
+                // Execute
+                const int32_t instr_pc = pc;
+                exec_instruction(instr);
+
+                // Taken backward branches and jumps may be loops - Unsigned
+                // so a jump below 0 isn't one
+                if ((uint32_t)pc < (uint32_t)instr_pc) {
+                    hot_loop_back_edge(instr_pc);
+                }
+            }
+
+            // Reset zero register to prevent values being stored there
+            registers[ZERO_REGISTER_ADDR] = ZERO_REGISTER_VAL;
+
+            // Check program counter bounds - Unsigned so pc < 0 is caught too
+            if ((uint32_t)pc >= INST_MEM_SIZE) {
+                throw_pc_out_of_bounds_err();
+            }
         }
+    }
+    cpu_status.trap_armed = false;
+    err = get_system_error_code();
 
-    // Stop if CPU run state is false
-    } while (get_cpu_run_status());
+    // Report run statistics - On stderr to keep guest output unchanged
+    if (options.stats) {
+        fflush(stdout);
+        fprintf(stderr, "Instructions executed: %llu\n",
+            (unsigned long long)budget_instr_count());
+    }
 
     // Deinitialise system - free any malloc'd memory
+    heap_trace_close();
+    hot_loops_deinit();
+    aot_unload();
     system_deinit();
 
     // Ensure any buffered output is printed
@@ -0,0 +1,102 @@
+# Isaak Choi
+# 520488399
+# icho6322
+
+# Heap benchmark - Keeps NUM_ALLOCS allocations live while repeatedly
+# reading / writing every chunk and re-allocating half of them, then prints
+# a checksum. Pointers to each chunk are kept in a table in data memory.
+
+    .equ VR_BASE,        0x0800 # Virtual routines are addressed from here
+    .equ VR_WRITE_CHAR,  0x00
+    .equ VR_WRITE_INT,   0x04
+    .equ VR_HALT,        0x0C
+    .equ VR_MALLOC,      0x30
+    .equ VR_FREE,        0x34
+
+    .equ PTR_TABLE,      0x0400 # Table of chunk pointers in data memory
+    .equ NUM_ALLOCS,     120    # Live allocations
+    .equ CHUNK_SIZE,     48     # Bytes per allocation (one heap bank)
+    .equ NUM_PASSES,     400    # Read / write passes over every chunk
+    .equ NUM_ROUNDS,     40     # Free / malloc rounds over half the chunks
+
+    .text
+_start:
+    li   sp, 2047
+    li   s0, PTR_TABLE
+    li   s1, NUM_ALLOCS
+    li   s2, VR_BASE
+    li   s3, 0                  # Checksum
+
+    # Allocate every chunk and store its index in its first word
+    li   t0, 0
+alloc_loop:
+    jal  ra, alloc_chunk
+    addi t0, t0, 1
+    blt  t0, s1, alloc_loop
+
+    # Read and write every chunk NUM_PASSES times
+    li   s4, NUM_PASSES
+pass_loop:
+    li   t0, 0
+access_loop:
+    add  t4, t0, t0
+    add  t4, t4, t4
+    add  t4, s0, t4
+    lw   t2, 0(t4)
+    lw   t5, 0(t2)
+    add  s3, s3, t5
+    sw   s3, 4(t2)
+    addi t0, t0, 1
+    blt  t0, s1, access_loop
+    addi s4, s4, -1
+    bne  s4, zero, pass_loop
+
+    # Free and re-allocate every even chunk NUM_ROUNDS times
+    li   s4, NUM_ROUNDS
+round_loop:
+    li   t0, 0
+churn_loop:
+    add  t4, t0, t0
+    add  t4, t4, t4
+    add  t4, s0, t4
+    lw   t2, 0(t4)
+    sw   t2, VR_FREE(s2)
+    jal  ra, alloc_chunk
+    lw   t2, 0(t4)
+    lw   t5, 0(t2)
+    add  s3, s3, t5
+    addi t0, t0, 2
+    blt  t0, s1, churn_loop
+    addi s4, s4, -1
+    bne  s4, zero, round_loop
+
+    # Free everything
+    li   t0, 0
+free_loop:
+    add  t4, t0, t0
+    add  t4, t4, t4
+    add  t4, s0, t4
+    lw   t2, 0(t4)
+    sw   t2, VR_FREE(s2)
+    addi t0, t0, 1
+    blt  t0, s1, free_loop
+
+    # Print checksum and halt
+    sw   s3, VR_WRITE_INT(s2)
+    li   t1, '\n'
+    sb   t1, VR_WRITE_CHAR(s2)
+    sw   zero, VR_HALT(s2)
+
+    # Allocates chunk t0, saves its pointer in the table and its index in it
+alloc_chunk:
+    li   t1, CHUNK_SIZE
+    sw   t1, VR_MALLOC(s2)
+    add  t4, t0, t0
+    add  t4, t4, t4
+    add  t4, s0, t4
+    sw   t3, 0(t4)
+    sw   t0, 0(t3)
+    jalr zero, 0(ra)
+
+    # Pad to the memory image size (instruction + data memory)
+    .org 0x800
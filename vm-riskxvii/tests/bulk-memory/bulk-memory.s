@@ -0,0 +1,110 @@
+# Isaak Choi
+# 520488399
+# icho6322
+
+# Sets, copies, and compares fields in data memory and the heap banks with
+#  the bulk memory virtual routines, then sets a field running past the
+#  end of a heap allocation, which must be an illegal operation
+
+    .equ VR_WRITE_CHAR_ADDR,  0x0800
+    .equ VR_WRITE_INT_ADDR,   0x0804
+    .equ VR_MALLOC_ADDR,      0x0830
+    .equ VR_MEMCPY_ADDR,      0x0840
+    .equ VR_MEMSET_ADDR,      0x0844
+    .equ VR_MEMCMP_ADDR,      0x0848
+    .equ DESCRIPTOR_ADDR,     0x0400
+    .equ BUF_ADDR,            0x0500
+
+    .text
+_start:
+    li   sp, 2047
+    li   s2, DESCRIPTOR_ADDR
+    li   s3, BUF_ADDR
+
+    # buf[0..7] = 'a'
+    li   t0, 'a'
+    li   t1, 8
+    sw   s3, 0(s2)
+    sw   t0, 4(s2)
+    sw   t1, 8(s2)
+    li   t2, VR_MEMSET_ADDR
+    sw   s2, 0(t2)
+
+    # buf[2..3] = 'b'
+    addi t0, s3, 2
+    li   t1, 'b'
+    li   t2, 2
+    sw   t0, 0(s2)
+    sw   t1, 4(s2)
+    sw   t2, 8(s2)
+    li   t2, VR_MEMSET_ADDR
+    sw   s2, 0(t2)
+
+    # Overlapping copy buf[0..5] -> buf[2..7]
+    addi t0, s3, 2
+    li   t1, 6
+    sw   t0, 0(s2)
+    sw   s3, 4(s2)
+    sw   t1, 8(s2)
+    li   t2, VR_MEMCPY_ADDR
+    sw   s2, 0(t2)
+    jal  ra, print_buf
+
+    # Copy buf into a 64 byte heap allocation
+    li   t0, 64
+    li   t2, VR_MALLOC_ADDR
+    sw   t0, 0(t2)
+    mv   s4, t3
+    li   t1, 8
+    sw   s4, 0(s2)
+    sw   s3, 4(s2)
+    sw   t1, 8(s2)
+    li   t2, VR_MEMCPY_ADDR
+    sw   s2, 0(t2)
+
+    # Compare equal, then heap[7] = 'c' > buf[7] = 'a'
+    jal  ra, compare
+    li   t0, 'c'
+    sb   t0, 7(s4)
+    jal  ra, compare
+
+    # Set heap[60..67] - Runs past the allocation
+    addi t0, s4, 60
+    li   t1, 8
+    sw   t0, 0(s2)
+    sw   zero, 4(s2)
+    sw   t1, 8(s2)
+    li   t2, VR_MEMSET_ADDR
+    sw   s2, 0(t2)
+
+# Prints memcmp(heap, buf, 8) then a newline
+compare:
+    li   t1, 8
+    sw   s4, 0(s2)
+    sw   s3, 4(s2)
+    sw   t1, 8(s2)
+    li   t2, VR_MEMCMP_ADDR
+    sw   s2, 0(t2)
+    li   t0, VR_WRITE_INT_ADDR
+    sw   t3, 0(t0)
+    li   t0, VR_WRITE_CHAR_ADDR
+    li   t1, '\n'
+    sb   t1, 0(t0)
+    jalr zero, ra, 0
+
+# Prints buf[0..7] then a newline
+print_buf:
+    li   t0, VR_WRITE_CHAR_ADDR
+    mv   t1, s3
+    addi t2, s3, 8
+print_loop:
+    lbu  a0, 0(t1)
+    sb   a0, 0(t0)
+    addi t1, t1, 1
+    bne  t1, t2, print_loop
+    li   a0, '\n'
+    sb   a0, 0(t0)
+    jalr zero, ra, 0
+
+    # Pad to the memory image size (instruction + data memory)
+    .org 0x800
@@ -0,0 +1,131 @@
+# Isaak Choi
+# 520488399
+# icho6322
+
+# Runs one RV32F instruction per input vector, printing the result (raw
+#  bits, or the integer result) and the accrued exception flags in hex.
+#  Input is the number of vectors, then per vector:
+#   op  - Index of the instruction slot to run (see slots below)
+#   rm  - Rounding mode written to frm (the instructions use rm = dyn)
+#   a b c - Raw operand bits, loaded into fa0 fa1 fa2 with flw. a is also
+#           the integer operand (s4) of the int to float instructions
+#  The expected output was checked against an exact (rational arithmetic)
+#  model of the RISC-V rules. The last vector sets a reserved rounding mode.
+
+    .equ VR_WRITE_CHAR_ADDR,  0x0800
+    .equ VR_WRITE_UINT_ADDR,  0x0808
+    .equ VR_HALT_ADDR,        0x080C
+    .equ VR_READ_INT_ADDR,    0x0816
+    .equ BUF_ADDR,            0x0400
+    .equ SLOTS_ADDR,          0x0200
+
+    .attribute arch, "rv32if"
+    .text
+_start:
+    li   s0, VR_READ_INT_ADDR
+    li   s1, BUF_ADDR
+    li   s3, SLOTS_ADDR
+    li   s5, 3
+    lw   s2, 0(s0)
+
+vector_loop:
+    lw   s6, 0(s0)
+    lw   t1, 0(s0)
+    fsrm t1
+
+    # Operands go through memory
+    lw   s4, 0(s0)
+    sw   s4, 0(s1)
+    lw   t0, 0(s0)
+    sw   t0, 4(s1)
+    lw   t0, 0(s0)
+    sw   t0, 8(s1)
+    flw  fa0, 0(s1)
+    flw  fa1, 4(s1)
+    flw  fa2, 8(s1)
+
+    # Run the slot (two instructions each) with no flags raised
+    fsflags zero
+    sll  t0, s6, s5
+    add  t0, t0, s3
+    jalr ra, t0, 0
+
+    li   t0, VR_WRITE_UINT_ADDR
+    sw   a0, 0(t0)
+    li   t1, VR_WRITE_CHAR_ADDR
+    li   t2, ' '
+    sb   t2, 0(t1)
+    frflags a0
+    sw   a0, 0(t0)
+    li   t2, '\n'
+    sb   t2, 0(t1)
+
+    addi s2, s2, -1
+    bne  s2, zero, vector_loop
+
+    li   t0, VR_HALT_ADDR
+    sw   zero, 0(t0)
+
+# Returns the raw bits of fa3 in a0, through memory
+float_result:
+    fsw  fa3, 12(s1)
+    lw   a0, 12(s1)
+    jalr zero, ra, 0
+
+    # Instruction slots - Float results are returned by float_result
+    .org SLOTS_ADDR
+    fadd.s    fa3, fa0, fa1         # 0
+    jal  zero, float_result
+    fsub.s    fa3, fa0, fa1         # 1
+    jal  zero, float_result
+    fmul.s    fa3, fa0, fa1         # 2
+    jal  zero, float_result
+    fdiv.s    fa3, fa0, fa1         # 3
+    jal  zero, float_result
+    fsqrt.s   fa3, fa0              # 4
+    jal  zero, float_result
+    fmadd.s   fa3, fa0, fa1, fa2    # 5
+    jal  zero, float_result
+    fmsub.s   fa3, fa0, fa1, fa2    # 6
+    jal  zero, float_result
+    fnmsub.s  fa3, fa0, fa1, fa2    # 7
+    jal  zero, float_result
+    fnmadd.s  fa3, fa0, fa1, fa2    # 8
+    jal  zero, float_result
+    fmin.s    fa3, fa0, fa1         # 9
+    jal  zero, float_result
+    fmax.s    fa3, fa0, fa1         # 10
+    jal  zero, float_result
+    fsgnj.s   fa3, fa0, fa1         # 11
+    jal  zero, float_result
+    fsgnjn.s  fa3, fa0, fa1         # 12
+    jal  zero, float_result
+    fsgnjx.s  fa3, fa0, fa1         # 13
+    jal  zero, float_result
+    feq.s     a0, fa0, fa1          # 14
+    jalr zero, ra, 0
+    flt.s     a0, fa0, fa1          # 15
+    jalr zero, ra, 0
+    fle.s     a0, fa0, fa1          # 16
+    jalr zero, ra, 0
+    fclass.s  a0, fa0               # 17
+    jalr zero, ra, 0
+    fcvt.w.s  a0, fa0, dyn          # 18
+    jalr zero, ra, 0
+    fcvt.wu.s a0, fa0, dyn          # 19
+    jalr zero, ra, 0
+    fcvt.s.w  fa3, s4               # 20
+    jal  zero, float_result
+    fcvt.s.wu fa3, s4               # 21
+    jal  zero, float_result
+    fmv.x.w   a0, fa0               # 22
+    jalr zero, ra, 0
+    fmv.w.x   fa3, s4               # 23
+    jal  zero, float_result
+    fadd.s    fa3, fa0, fa1, rtz    # 24 - Static rounding mode
+    jal  zero, float_result
+    fcvt.w.s  a0, fa0, rmm          # 25 - Static rounding mode
+    jalr zero, ra, 0
+
+    # Pad to the memory image size (instruction + data memory)
+    .org 0x800
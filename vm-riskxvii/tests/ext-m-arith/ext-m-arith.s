@@ -0,0 +1,81 @@
+# Isaak Choi
+# 520488399
+# icho6322
+
+# Runs every RV32M instruction over a table of operand pairs, including
+#  divide by zero and signed overflow, printing one line of hex results
+#  (mul mulh mulhsu mulhu div divu rem remu) per pair
+
+    .equ VR_WRITE_CHAR_ADDR,  0x0800
+    .equ VR_WRITE_UINT_ADDR,  0x0808
+    .equ VR_HALT_ADDR,        0x080C
+    .equ PAIRS_ADDR,          0x0400
+    .equ N_PAIRS,             9
+
+    .attribute arch, "rv32im"
+    .text
+_start:
+    li   sp, 2047
+    li   s2, PAIRS_ADDR
+    li   s3, N_PAIRS
+
+pair_loop:
+    lw   s4, 0(s2)
+    lw   s5, 4(s2)
+
+    mul    a0, s4, s5
+    jal    ra, print_word
+    mulh   a0, s4, s5
+    jal    ra, print_word
+    mulhsu a0, s4, s5
+    jal    ra, print_word
+    mulhu  a0, s4, s5
+    jal    ra, print_word
+    div    a0, s4, s5
+    jal    ra, print_word
+    divu   a0, s4, s5
+    jal    ra, print_word
+    rem    a0, s4, s5
+    jal    ra, print_word
+    remu   a0, s4, s5
+    jal    ra, print_word
+
+    # Writes to the zero register are discarded (mul zero, s4, s5)
+    .insn r 0x33, 0, 1, zero, s4, s5
+    mv   a0, zero
+    jal  ra, print_word
+
+    li   t0, VR_WRITE_CHAR_ADDR
+    li   t1, '\n'
+    sb   t1, 0(t0)
+
+    addi s2, s2, 8
+    addi s3, s3, -1
+    bne  s3, zero, pair_loop
+
+    li   t0, VR_HALT_ADDR
+    sw   zero, 0(t0)
+
+# Prints a0 in hex followed by a space
+print_word:
+    li   t0, VR_WRITE_UINT_ADDR
+    sw   a0, 0(t0)
+    li   t0, VR_WRITE_CHAR_ADDR
+    li   t1, ' '
+    sb   t1, 0(t0)
+    jalr zero, ra, 0
+
+    # Operand pairs { rs1, rs2 }
+    .org PAIRS_ADDR
+    .word 7, 3
+    .word -7, 3
+    .word 7, -3
+    .word -7, -3
+    .word 5, 0
+    .word -5, 0
+    .word 0x80000000, -1
+    .word -1, -1
+    .word 0x12345678, 0x9ABCDEF0
+
+    # Pad to the memory image size (instruction + data memory)
+    .org 0x800
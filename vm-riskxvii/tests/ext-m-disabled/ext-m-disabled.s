@@ -0,0 +1,20 @@
+# Isaak Choi
+# 520488399
+# icho6322
+
+# Executes a mul without --ext-m, which must not be implemented
+
+    .equ VR_HALT_ADDR,        0x080C
+
+    .attribute arch, "rv32im"
+    .text
+_start:
+    li   sp, 2047
+    li   t0, 6
+    li   t1, 7
+    mul  a0, t0, t1
+    li   t0, VR_HALT_ADDR
+    sw   zero, 0(t0)
+
+    # Pad to the memory image size (instruction + data memory)
+    .org 0x800
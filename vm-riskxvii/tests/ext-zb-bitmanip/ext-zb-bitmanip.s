@@ -0,0 +1,101 @@
+# Isaak Choi
+# 520488399
+# icho6322
+
+# Runs every Zba and Zbb instruction over a table of operand pairs,
+#  printing one line of hex results per pair in the order
+#  sh1add sh2add sh3add andn orn xnor clz ctz cpop sext.b sext.h zext.h
+#  min minu max maxu rol ror rori(7) orc.b rev8
+
+    .equ VR_WRITE_CHAR_ADDR,  0x0800
+    .equ VR_WRITE_UINT_ADDR,  0x0808
+    .equ VR_HALT_ADDR,        0x080C
+    .equ PAIRS_ADDR,          0x0400
+    .equ N_PAIRS,             7
+
+    .attribute arch, "rv32i2p0_zba1p0_zbb1p0"
+    .text
+_start:
+    li   sp, 2047
+    li   s2, PAIRS_ADDR
+    li   s3, N_PAIRS
+
+pair_loop:
+    lw   s4, 0(s2)
+    lw   s5, 4(s2)
+
+    sh1add a0, s4, s5
+    jal    ra, print_word
+    sh2add a0, s4, s5
+    jal    ra, print_word
+    sh3add a0, s4, s5
+    jal    ra, print_word
+    andn   a0, s4, s5
+    jal    ra, print_word
+    orn    a0, s4, s5
+    jal    ra, print_word
+    xnor   a0, s4, s5
+    jal    ra, print_word
+    clz    a0, s4
+    jal    ra, print_word
+    ctz    a0, s4
+    jal    ra, print_word
+    cpop   a0, s4
+    jal    ra, print_word
+    sext.b a0, s4
+    jal    ra, print_word
+    sext.h a0, s4
+    jal    ra, print_word
+    zext.h a0, s4
+    jal    ra, print_word
+    min    a0, s4, s5
+    jal    ra, print_word
+    minu   a0, s4, s5
+    jal    ra, print_word
+    max    a0, s4, s5
+    jal    ra, print_word
+    maxu   a0, s4, s5
+    jal    ra, print_word
+    rol    a0, s4, s5
+    jal    ra, print_word
+    ror    a0, s4, s5
+    jal    ra, print_word
+    rori   a0, s4, 7
+    jal    ra, print_word
+    orc.b  a0, s4
+    jal    ra, print_word
+    rev8   a0, s4
+    jal    ra, print_word
+
+    li   t0, VR_WRITE_CHAR_ADDR
+    li   t1, '\n'
+    sb   t1, 0(t0)
+
+    addi s2, s2, 8
+    addi s3, s3, -1
+    bne  s3, zero, pair_loop
+
+    li   t0, VR_HALT_ADDR
+    sw   zero, 0(t0)
+
+# Prints a0 in hex followed by a space
+print_word:
+    li   t0, VR_WRITE_UINT_ADDR
+    sw   a0, 0(t0)
+    li   t0, VR_WRITE_CHAR_ADDR
+    li   t1, ' '
+    sb   t1, 0(t0)
+    jalr zero, ra, 0
+
+    # Operand pairs { rs1, rs2 }
+    .org PAIRS_ADDR
+    .word 0, 0
+    .word 1, 33
+    .word 0x80000000, 1
+    .word 0x12345678, 0x9ABCDEF0
+    .word 0xFF00FF00, 8
+    .word -5, 3
+    .word 0x00800080, -1
+
+    # Pad to the memory image size (instruction + data memory)
+    .org 0x800
@@ -0,0 +1,59 @@
+# Isaak Choi
+# 520488399
+# icho6322
+
+# Reads the Zicntr counters around a loop of known length, printing the
+#  instret and cycle differences, whether time went backwards (1 if not) and
+#  the instret high word, then attempts to write a counter (illegal)
+
+    .equ VR_WRITE_CHAR_ADDR,  0x0800
+    .equ VR_WRITE_SINT_ADDR,  0x0804
+    .equ N_ITERS,             10
+
+    .text
+_start:
+    li   sp, 2047
+    li   s2, N_ITERS
+
+    rdtime    s6
+    rdcycle   s4
+    rdinstret s3
+
+    # Each iteration retires 2 instructions and ends a block
+loop:
+    addi s2, s2, -1
+    bne  s2, zero, loop
+
+    rdinstret s5
+    rdcycle   s7
+    rdtime    s8
+
+    # Instructions retired by the loop and the first rdcycle
+    sub  a0, s5, s3
+    jal  ra, print_line
+    sub  a0, s7, s4
+    jal  ra, print_line
+    sltu a0, s8, s6
+    xori a0, a0, 1
+    jal  ra, print_line
+    rdinstreth a0
+    jal  ra, print_line
+
+    # Clear the time readings so the register dump is deterministic
+    mv   s6, zero
+    mv   s8, zero
+
+    # The counters are read only (csrrs a0, cycle, s2)
+    csrrs a0, cycle, s2
+
+# Prints a0 in decimal followed by a newline
+print_line:
+    li   t0, VR_WRITE_SINT_ADDR
+    sw   a0, 0(t0)
+    li   t0, VR_WRITE_CHAR_ADDR
+    li   t1, '\n'
+    sb   t1, 0(t0)
+    jalr zero, ra, 0
+
+    # Pad to the memory image size (instruction + data memory)
+    .org 0x800
@@ -0,0 +1,42 @@
+# Isaak Choi
+# 520488399
+# icho6322
+
+# Accesses the edges of instruction and data memory - Run with --guard-pages
+#  The final load crosses the end of data memory and must be caught
+
+    .equ VR_WRITE_UINT_ADDR, 0x0808
+    .equ VR_WRITE_CHAR_ADDR, 0x0800
+
+    .text
+_start:
+    li   sp, 2047
+    li   s0, VR_WRITE_UINT_ADDR
+    li   s1, VR_WRITE_CHAR_ADDR
+    li   s2, '\n'
+
+    # First instruction word is readable
+    lw   t0, 0(zero)
+    sw   t0, 0(s0)
+    sb   s2, 0(s1)
+
+    # First and last words of data memory are writable
+    li   t1, 0x0400
+    li   t2, 0x11223344
+    sw   t2, 0(t1)
+    lw   t0, 0(t1)
+    sw   t0, 0(s0)
+    sb   s2, 0(s1)
+    li   t1, 0x07fc
+    li   t2, 0x55667788
+    sw   t2, 0(t1)
+    lw   t0, 0(t1)
+    sw   t0, 0(s0)
+    sb   s2, 0(s1)
+
+    # Word crossing the end of data memory
+    li   t1, 0x07fe
+    lw   t0, 0(t1)
+
+    # Pad to the memory image size (instruction + data memory)
+    .org 0x800
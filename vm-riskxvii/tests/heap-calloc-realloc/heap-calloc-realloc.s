@@ -0,0 +1,83 @@
+# Isaak Choi
+# 520488399
+# icho6322
+
+# Calloc reuses a dirty freed bank and must zero it, then realloc grows in
+#  place, moves when blocked, and acts as malloc when given NULL
+#  Prints each address returned and the word stored at its start
+
+    .equ VR_WRITE_CHAR_ADDR,  0x0800
+    .equ VR_WRITE_UINT_ADDR,  0x0808
+    .equ VR_HALT_ADDR,        0x080C
+    .equ VR_MALLOC_ADDR,      0x0830
+    .equ VR_FREE_ADDR,        0x0834
+    .equ VR_CALLOC_ADDR,      0x0838
+    .equ VR_REALLOC_ADDR,     0x083C
+    .equ DESCRIPTOR_ADDR,     0x0400
+
+    .text
+_start:
+    li   sp, 2047
+    li   s0, VR_MALLOC_ADDR
+    li   s1, VR_FREE_ADDR
+    li   s2, DESCRIPTOR_ADDR
+    li   s3, VR_REALLOC_ADDR
+
+    # Dirty bank 0, then free it
+    li   a0, 64
+    sw   a0, 0(s0)
+    li   t0, 0x1234
+    sw   t0, 0(t3)
+    sw   t3, 0(s1)
+
+    # Calloc bank 0 again - Must read as zero
+    li   t0, VR_CALLOC_ADDR
+    sw   a0, 0(t0)
+    mv   s4, t3
+    jal  ra, print_alloc
+    li   t0, 0xabc
+    sw   t0, 0(s4)
+
+    # Grow to 2 banks - Bank 1 is free so stays in place
+    li   a0, 128
+    sw   s4, 0(s2)
+    sw   a0, 4(s2)
+    sw   s2, 0(s3)
+    mv   s4, t3
+    jal  ra, print_alloc
+
+    # Block bank 2, then grow to 3 banks - Must move
+    li   a0, 64
+    sw   a0, 0(s0)
+    li   a0, 192
+    sw   s4, 0(s2)
+    sw   a0, 4(s2)
+    sw   s2, 0(s3)
+    mv   s4, t3
+    jal  ra, print_alloc
+
+    # Realloc of NULL is malloc - Takes the banks just moved out of
+    li   a0, 64
+    sw   zero, 0(s2)
+    sw   a0, 4(s2)
+    sw   s2, 0(s3)
+    jal  ra, print_alloc
+
+    li   t0, VR_HALT_ADDR
+    sw   zero, 0(t0)
+
+# Prints R[28] and the word it points to
+print_alloc:
+    li   t0, VR_WRITE_UINT_ADDR
+    li   t1, VR_WRITE_CHAR_ADDR
+    li   t2, ' '
+    sw   t3, 0(t0)
+    sb   t2, 0(t1)
+    lw   t2, 0(t3)
+    sw   t2, 0(t0)
+    li   t2, '\n'
+    sb   t2, 0(t1)
+    jalr zero, ra, 0
+
+    # Pad to the memory image size (instruction + data memory)
+    .org 0x800
@@ -0,0 +1,64 @@
+# Isaak Choi
+# 520488399
+# icho6322
+
+# Uses a 1 MiB heap of 256 byte banks - Run with
+#  --heap-size=1048576 --heap-bank-size=256
+
+    .equ VR_WRITE_CHAR_ADDR, 0x0800
+    .equ VR_WRITE_INT_ADDR,  0x0804
+    .equ VR_WRITE_UINT_ADDR, 0x0808
+    .equ VR_HALT_ADDR,       0x080C
+    .equ VR_MALLOC_ADDR,     0x0830
+    .equ VR_FREE_ADDR,       0x0834
+
+    .text
+_start:
+    li   sp, 2047
+    li   s0, VR_WRITE_UINT_ADDR
+    li   s1, VR_WRITE_CHAR_ADDR
+    li   s2, VR_MALLOC_ADDR
+    li   s3, '\n'
+
+    # 768 KiB - Larger than the whole default heap
+    li   a0, 786432
+    sw   a0, 0(s2)
+    mv   s4, t3
+    sw   s4, 0(s0)
+    sb   s3, 0(s1)
+
+    # Write and read back the last word of it
+    li   t0, 786428
+    add  t0, t0, s4
+    li   t1, 123456789
+    sw   t1, 0(t0)
+    lw   t2, 0(t0)
+    li   t4, VR_WRITE_INT_ADDR
+    sw   t2, 0(t4)
+    sb   s3, 0(s1)
+
+    # The remaining 256 KiB fits exactly after it
+    li   a0, 262144
+    sw   a0, 0(s2)
+    sw   t3, 0(s0)
+    sb   s3, 0(s1)
+
+    # Heap is now full
+    li   a0, 1
+    sw   a0, 0(s2)
+    sw   t3, 0(s0)
+    sb   s3, 0(s1)
+
+    # Freeing the first chunk makes its banks available again
+    li   t0, VR_FREE_ADDR
+    sw   s4, 0(t0)
+    li   a0, 1
+    sw   a0, 0(s2)
+    sw   t3, 0(s0)
+    sb   s3, 0(s1)
+
+    li   t0, VR_HALT_ADDR
+    sw   zero, 0(t0)
+
+    # Pad to the memory image size (instruction + data memory)
+    .org 0x800
@@ -0,0 +1,46 @@
+# Isaak Choi
+# 520488399
+# icho6322
+
+# Leaves a 3 bank hole before a 1 bank hole, then asks for 1 bank
+#  Run with --heap-policy=best-fit, which must pick the 1 bank hole
+
+    .equ VR_WRITE_CHAR_ADDR, 0x0800
+    .equ VR_WRITE_UINT_ADDR, 0x0808
+    .equ VR_HALT_ADDR,       0x080C
+    .equ VR_MALLOC_ADDR,     0x0830
+    .equ VR_FREE_ADDR,       0x0834
+
+    .text
+_start:
+    li   sp, 2047
+    li   s0, VR_MALLOC_ADDR
+    li   s1, VR_FREE_ADDR
+
+    # a: banks 0-2, b: bank 3, c: bank 4, d: bank 5
+    li   a0, 192
+    sw   a0, 0(s0)
+    mv   s2, t3
+    li   a0, 64
+    sw   a0, 0(s0)
+    sw   a0, 0(s0)
+    mv   s3, t3
+    sw   a0, 0(s0)
+
+    # Holes at banks 0-2 and bank 4
+    sw   s2, 0(s1)
+    sw   s3, 0(s1)
+
+    # Allocate one bank and print where it went
+    sw   a0, 0(s0)
+    li   t0, VR_WRITE_UINT_ADDR
+    sw   t3, 0(t0)
+    li   t0, VR_WRITE_CHAR_ADDR
+    li   t1, '\n'
+    sb   t1, 0(t0)
+
+    li   t0, VR_HALT_ADDR
+    sw   zero, 0(t0)
+
+    # Pad to the memory image size (instruction + data memory)
+    .org 0x800
@@ -0,0 +1,33 @@
+# Isaak Choi
+# 520488399
+# icho6322
+
+# Makes one of each kind of heap call for the heap trace to record
+#  Run with --heap-trace=<file>, then compare the dumped trace
+
+    .equ VR_HALT_ADDR,       0x080C
+    .equ VR_MALLOC_ADDR,     0x0830
+    .equ VR_FREE_ADDR,       0x0834
+
+    .text
+_start:
+    li   sp, 2047
+    li   s0, VR_MALLOC_ADDR
+    li   s1, VR_FREE_ADDR
+
+    # Malloc 2 banks, then a malloc that is too big to fit
+    li   a0, 100
+    sw   a0, 0(s0)
+    mv   s2, t3
+    li   a0, 0x10000
+    sw   a0, 0(s0)
+
+    # Free NULL, then the 2 banks
+    sw   zero, 0(s1)
+    sw   s2, 0(s1)
+
+    li   t0, VR_HALT_ADDR
+    sw   zero, 0(t0)
+
+    # Pad to the memory image size (instruction + data memory)
+    .org 0x800
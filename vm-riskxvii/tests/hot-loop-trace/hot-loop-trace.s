@@ -0,0 +1,137 @@
+# Isaak Choi
+# 520488399
+# icho6322
+
+# Runs loops long enough to be traced - Loads and stores off a fixed base
+#  and off a moving pointer, a loop printing through a virtual routine and
+#  one storing into the heap (both deoptimise), a nested loop with an early
+#  exit, then a loop whose pointer walks off the bottom of memory, which
+#  must be an illegal operation
+
+    .equ VR_WRITE_CHAR_ADDR,  0x0800
+    .equ VR_WRITE_INT_ADDR,   0x0804
+    .equ VR_MALLOC_ADDR,      0x0830
+    .equ ARRAY_ADDR,          0x0400
+
+    .text
+_start:
+    li   sp, 2047
+    li   s2, VR_WRITE_INT_ADDR
+    li   s3, VR_WRITE_CHAR_ADDR
+
+    # array[i] = i * 3 for i < 200, keeping a running total on the stack
+    li   s1, ARRAY_ADDR
+    mv   t0, s1
+    li   t1, 0
+    li   t2, 200
+    sw   zero, -8(sp)
+fill:
+    add  t3, t1, t1
+    add  t3, t3, t1
+    sw   t3, 0(t0)
+    lw   t4, -8(sp)
+    add  t4, t4, t3
+    sw   t4, -8(sp)
+    addi t0, t0, 4
+    addi t1, t1, 1
+    blt  t1, t2, fill
+    lw   a0, -8(sp)
+    sw   a0, 0(s2)
+    jal  ra, newline
+
+    # Sum the array back with byte and half loads mixed in
+    mv   t0, s1
+    li   t1, 200
+    li   a0, 0
+sum:
+    lw   t3, 0(t0)
+    lbu  t4, 0(t0)
+    lh   t5, 0(t0)
+    add  a0, a0, t3
+    xor  a0, a0, t4
+    sub  a0, a0, t5
+    addi t0, t0, 4
+    addi t1, t1, -1
+    bne  t1, zero, sum
+    sw   a0, 0(s2)
+    jal  ra, newline
+
+    # Print 100 characters cycling through the alphabet
+    li   t1, 0
+    li   t2, 26
+    li   t3, 'a'
+    li   t5, 100
+print:
+    add  t4, t3, t1
+    sw   t4, 0(s3)
+    addi t1, t1, 1
+    bltu t1, t2, no_wrap
+    li   t1, 0
+no_wrap:
+    addi t5, t5, -1
+    bne  t5, zero, print
+    jal  ra, newline
+
+    # Fill a heap allocation, then sum it back
+    li   t0, 400
+    li   t2, VR_MALLOC_ADDR
+    sw   t0, 0(t2)
+    mv   s4, t3
+    mv   t0, s4
+    li   t1, 100
+heap_fill:
+    sw   t1, 0(t0)
+    addi t0, t0, 4
+    addi t1, t1, -1
+    bne  t1, zero, heap_fill
+    mv   t0, s4
+    li   t1, 100
+    li   a0, 0
+heap_sum:
+    lw   t3, 0(t0)
+    add  a0, a0, t3
+    addi t0, t0, 4
+    addi t1, t1, -1
+    bne  t1, zero, heap_sum
+    sw   a0, 0(s2)
+    jal  ra, newline
+
+    # Count the pairs (i, j), j < i < 120, ending each row early once
+    #  (i << 6) >> j reaches zero
+    li   a0, 0
+    li   t0, 0
+    li   t2, 120
+    li   t5, 6
+outer:
+    li   t1, 0
+inner:
+    bge  t1, t0, inner_done
+    sll  t3, t0, t5
+    srl  t4, t3, t1
+    beq  t4, zero, inner_done
+    addi a0, a0, 1
+    addi t1, t1, 1
+    j    inner
+inner_done:
+    addi t0, t0, 1
+    blt  t0, t2, outer
+    sw   a0, 0(s2)
+    jal  ra, newline
+
+    # Sum memory downwards from the array until the pointer runs off the
+    #  bottom of memory
+    mv   t0, s1
+    li   a0, 0
+walk:
+    lw   t3, 0(t0)
+    add  a0, a0, t3
+    addi t0, t0, -4
+    j    walk
+
+newline:
+    li   t6, '\n'
+    sw   t6, 0(s3)
+    jalr zero, ra, 0
+
+    # Pad to the memory image size (instruction + data memory)
+    .org 0x800
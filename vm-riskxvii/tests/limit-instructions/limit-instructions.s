@@ -0,0 +1,17 @@
+# Isaak Choi
+# 520488399
+# icho6322
+
+# Spins forever - Must be stopped by the --max-instr limit
+
+    .text
+_start:
+    li   sp, 2047
+    li   a0, 0
+loop:
+    addi a0, a0, 1
+    addi a1, a1, 2
+    j    loop
+
+    # Pad to the memory image size (instruction + data memory)
+    .org 0x800
@@ -0,0 +1,23 @@
+# Isaak Choi
+# 520488399
+# icho6322
+
+# Prints characters forever - Must be stopped by the --max-output limit
+
+    .equ VR_WRITE_CHAR_ADDR, 0x0800
+
+    .text
+_start:
+    li   sp, 2047
+    li   t0, VR_WRITE_CHAR_ADDR
+    li   a0, 'a'
+    li   a1, 'z'
+loop:
+    sb   a0, 0(t0)
+    addi a0, a0, 1
+    blt  a0, a1, loop
+    li   a0, 'a'
+    j    loop
+
+    # Pad to the memory image size (instruction + data memory)
+    .org 0x800
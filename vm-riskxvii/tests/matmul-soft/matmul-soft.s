@@ -0,0 +1,135 @@
+# Isaak Choi
+# 520488399
+# icho6322
+
+# Multiplies two 8x8 word matrices in data memory REPS times and prints
+#  the checksum and trace of the product
+#  Uses a shift and add multiply routine (see matmul-ext-m for the same
+#  guest using the RV32M mul instruction)
+
+    .equ VR_WRITE_CHAR_ADDR,  0x0800
+    .equ VR_WRITE_INT_ADDR,   0x0804
+    .equ VR_HALT_ADDR,        0x080C
+    .equ A_ADDR,              0x0400
+    .equ B_ADDR,              0x0500
+    .equ C_ADDR,              0x0600
+    .equ N,                   8
+    .equ REPS,                20
+
+    .text
+_start:
+    li   sp, 2047
+    li   s2, A_ADDR
+    li   s3, B_ADDR
+    li   s4, C_ADDR
+    li   s11, N
+    li   a4, 5
+    li   a5, 2
+    li   a6, 1
+
+    # A[i][j] = i + 2j + 1, B[i][j] = 3i - j + 8
+    li   s6, 0
+fill_i:
+    li   s7, 0
+fill_j:
+    sll  t0, s6, a4
+    sll  t1, s7, a5
+    add  t0, t0, t1
+    add  t1, s7, s7
+    add  t1, t1, s6
+    addi t1, t1, 1
+    add  t2, s2, t0
+    sw   t1, 0(t2)
+    add  t1, s6, s6
+    add  t1, t1, s6
+    sub  t1, t1, s7
+    addi t1, t1, 8
+    add  t2, s3, t0
+    sw   t1, 0(t2)
+    addi s7, s7, 1
+    bne  s7, s11, fill_j
+    addi s6, s6, 1
+    bne  s6, s11, fill_i
+
+    # C = A * B, REPS times
+    li   s5, REPS
+rep_loop:
+    li   s6, 0
+i_loop:
+    li   s7, 0
+j_loop:
+    li   s8, 0
+    li   s9, 0
+k_loop:
+    sll  t0, s6, a4
+    sll  t1, s8, a5
+    add  t0, t0, t1
+    add  t0, t0, s2
+    lw   a0, 0(t0)
+    sll  t0, s8, a4
+    sll  t1, s7, a5
+    add  t0, t0, t1
+    add  t0, t0, s3
+    lw   a1, 0(t0)
+    jal  ra, mul_soft
+    add  s9, s9, a0
+    addi s8, s8, 1
+    bne  s8, s11, k_loop
+    sll  t0, s6, a4
+    sll  t1, s7, a5
+    add  t0, t0, t1
+    add  t0, t0, s4
+    sw   s9, 0(t0)
+    addi s7, s7, 1
+    bne  s7, s11, j_loop
+    addi s6, s6, 1
+    bne  s6, s11, i_loop
+    addi s5, s5, -1
+    bne  s5, zero, rep_loop
+
+    # Checksum and trace
+    li   s6, 0
+    li   s9, 0
+    li   s10, 0
+    mv   t0, s4
+    li   t1, 256
+    add  t1, t1, s4
+sum_loop:
+    lw   t2, 0(t0)
+    add  s9, s9, t2
+    addi t0, t0, 4
+    bne  t0, t1, sum_loop
+    mv   t0, s4
+trace_loop:
+    lw   t2, 0(t0)
+    add  s10, s10, t2
+    addi t0, t0, 36
+    addi s6, s6, 1
+    bne  s6, s11, trace_loop
+
+    li   t0, VR_WRITE_INT_ADDR
+    li   t1, VR_WRITE_CHAR_ADDR
+    li   t2, '\n'
+    sw   s9, 0(t0)
+    sb   t2, 0(t1)
+    sw   s10, 0(t0)
+    sb   t2, 0(t1)
+    li   t0, VR_HALT_ADDR
+    sw   zero, 0(t0)
+
+# a0 = a0 * a1 for a1 >= 0 - Clobbers a1, t5 and t6 (a6 must be 1)
+mul_soft:
+    li   t6, 0
+mul_loop:
+    andi t5, a1, 1
+    beq  t5, zero, mul_skip
+    add  t6, t6, a0
+mul_skip:
+    add  a0, a0, a0
+    srl  a1, a1, a6
+    bne  a1, zero, mul_loop
+    mv   a0, t6
+    jalr zero, ra, 0
+
+    # Pad to the memory image size (instruction + data memory)
+    .org 0x800
@@ -0,0 +1,111 @@
+# Isaak Choi
+# 520488399
+# icho6322
+
+# Runs loads and stores the load time analysis proves (off an odd stack
+#  pointer and off constant bases), a memset that turns a pointer spilled
+#  to the stack into the write uint routine (so the store through it must
+#  still print), then a call through a function pointer picked by input
+#  that lands part way into a function, away from every return address,
+#  voiding the proofs for the rest of the run
+
+    .equ VR_WRITE_CHAR_ADDR,  0x0800
+    .equ VR_WRITE_INT_ADDR,   0x0804
+    .equ VR_HALT_ADDR,        0x080C
+    .equ VR_READ_INT_ADDR,    0x0816
+    .equ VR_MEMSET_ADDR,      0x0844
+
+    # Function pointers (see the .orgs below)
+    .equ PRINT_INT_ADDR,      0x0010
+    .equ PRINT_TWICE_BODY,    0x0024
+
+    .text
+_start:
+    j    main
+
+# Prints a0 and a newline
+    .org PRINT_INT_ADDR
+print_int:
+    sw   a0, 0(s2)
+newline:
+    li   t0, '\n'
+    sb   t0, 0(s3)
+    ret
+
+# Prints a0 + 1 twice - Only ever entered part way in, printing a0 twice
+    .org PRINT_TWICE_BODY - 4
+print_twice:
+    addi a0, a0, 1
+print_twice_body:
+    sw   ra, 0(sp)
+    jal  ra, print_int
+    jal  ra, print_int
+    lw   ra, 0(sp)
+    ret
+
+main:
+    li   sp, 2047
+    addi sp, sp, -47
+    li   s2, VR_WRITE_INT_ADDR
+    li   s3, VR_WRITE_CHAR_ADDR
+
+    # table[i] = i + 7 for i < 4, in every access width
+    li   s1, 0x500
+    li   t0, 7
+    sw   t0, 0(s1)
+    addi t0, t0, 1
+    sh   t0, 4(s1)
+    addi t0, t0, 1
+    sb   t0, 8(s1)
+    addi t0, t0, 1
+    sw   t0, 12(s1)
+
+    # Spill the table pointer, reload it and keep the sum on the stack
+    sw   s1, 4(sp)
+    lw   t1, 4(sp)
+    lw   t2, 0(t1)
+    lhu  t3, 4(t1)
+    add  t2, t2, t3
+    lbu  t3, 8(t1)
+    add  t2, t2, t3
+    lw   t3, 12(t1)
+    add  t2, t2, t3
+    sw   t2, 8(sp)
+    lw   a0, 8(sp)
+    jal  ra, print_int
+
+    # memset the low two bytes of the spilled pointer to 0x08 - 0x0500
+    #  becomes 0x0808 (write uint)
+    addi t0, sp, 4
+    sw   t0, 12(sp)
+    li   t0, 8
+    sw   t0, 16(sp)
+    li   t0, 2
+    sw   t0, 20(sp)
+    addi t0, sp, 12
+    li   t1, VR_MEMSET_ADDR
+    sw   t0, 0(t1)
+    lw   t1, 4(sp)
+    lw   t2, 8(sp)
+    sw   t2, 0(t1)
+    jal  ra, newline
+
+    # Call print_twice_body (or print_int) through a function pointer
+    li   t4, PRINT_TWICE_BODY
+    li   t1, VR_READ_INT_ADDR
+    lw   t6, 0(t1)
+    bnez t6, 1f
+    li   t4, PRINT_INT_ADDR
+1:  li   a0, 9
+    jalr ra, 0(t4)
+
+    # Accesses after the proofs are voided are fully checked
+    lw   a0, 8(sp)
+    lw   t1, 0(s1)
+    add  a0, a0, t1
+    jal  ra, print_int
+    li   t0, VR_HALT_ADDR
+    sw   zero, 0(t0)
+
+    # Pad to the memory image size (instruction + data memory)
+    .org 0x800
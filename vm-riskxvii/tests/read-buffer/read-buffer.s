@@ -0,0 +1,71 @@
+# Isaak Choi
+# 520488399
+# icho6322
+
+# Reads stdin with the console read line / buffer virtual routines and
+#  echoes each read as "<count>:<bytes>|", then reads more bytes than a
+#  heap allocation holds, which must be an illegal operation
+
+    .equ VR_WRITE_CHAR_ADDR,  0x0800
+    .equ VR_WRITE_INT_ADDR,   0x0804
+    .equ VR_MALLOC_ADDR,      0x0830
+    .equ VR_WRITE_BUF_ADDR,   0x084C
+    .equ VR_READ_BUF_ADDR,    0x0854
+    .equ VR_READ_LINE_ADDR,   0x0858
+    .equ DESCRIPTOR_ADDR,     0x0400
+    .equ BUF_ADDR,            0x0500
+
+    .text
+_start:
+    li   sp, 2047
+    li   s2, DESCRIPTOR_ADDR
+    li   s3, BUF_ADDR
+
+    # Whole first line, first 3 bytes of the second, then the rest of it
+    li   a0, VR_READ_LINE_ADDR
+    li   a1, 64
+    jal  ra, read_echo
+    li   a0, VR_READ_LINE_ADDR
+    li   a1, 3
+    jal  ra, read_echo
+    li   a0, VR_READ_LINE_ADDR
+    li   a1, 64
+    jal  ra, read_echo
+
+    # Everything left, then nothing at the end of stdin
+    li   a0, VR_READ_BUF_ADDR
+    li   a1, 100
+    jal  ra, read_echo
+    li   a0, VR_READ_LINE_ADDR
+    li   a1, 64
+    jal  ra, read_echo
+
+    # 65 bytes into a 64 byte heap allocation
+    li   t0, 64
+    li   t1, VR_MALLOC_ADDR
+    sw   t0, 0(t1)
+    li   t0, 65
+    sw   t3, 0(s2)
+    sw   t0, 4(s2)
+    li   t1, VR_READ_BUF_ADDR
+    sw   s2, 0(t1)
+
+# Reads up to a1 bytes into buf with the read routine at a0, then echoes
+read_echo:
+    sw   s3, 0(s2)
+    sw   a1, 4(s2)
+    sw   s2, 0(a0)
+    li   t0, VR_WRITE_INT_ADDR
+    sw   t3, 0(t0)
+    li   t0, VR_WRITE_CHAR_ADDR
+    li   t1, ':'
+    sb   t1, 0(t0)
+    sw   t3, 4(s2)
+    li   t1, VR_WRITE_BUF_ADDR
+    sw   s2, 0(t1)
+    li   t1, '|'
+    sb   t1, 0(t0)
+    jalr zero, ra, 0
+
+    # Pad to the memory image size (instruction + data memory)
+    .org 0x800
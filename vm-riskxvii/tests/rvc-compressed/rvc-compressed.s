@@ -0,0 +1,108 @@
+# Isaak Choi
+# 520488399
+# icho6322
+
+# Mixes compressed and full size instructions (full size ones starting on
+#  half word boundaries) covering every supported compressed instruction,
+#  printing intermediate results - Run with --ext-c
+
+    .equ VR_WRITE_CHAR_ADDR,  0x0800
+    .equ VR_WRITE_INT_ADDR,   0x0804
+    .equ VR_HALT_ADDR,        0x080C
+    .equ DATA_ADDR,           0x0400
+    .equ TWICE_ADDR,          0x0302
+
+    .attribute arch, "rv32ic"
+    .text
+_start:
+    li   sp, 2047
+    addi sp, sp, -15        # c.addi - sp = 2032
+    li   s0, DATA_ADDR      # Full size
+
+    # c.li, c.addi, c.bnez - Sum 1..10
+    li   s1, 0
+    li   a0, 10
+sum_loop:
+    add  s1, s1, a0         # c.add
+    addi a0, a0, -1         # c.addi
+    bnez a0, sum_loop       # c.bnez
+    mv   a0, s1             # c.mv
+    jal  ra, print_int      # c.jal
+
+    # c.sw, c.lw, c.swsp, c.lwsp
+    sw   s1, 4(s0)          # c.sw
+    lw   a1, 4(s0)          # c.lw
+    sw   a1, 8(sp)          # c.swsp
+    lw   a0, 8(sp)          # c.lwsp
+    addi a0, a0, 1          # c.addi
+    jal  ra, print_int
+
+    # c.sub, c.xor, c.or, c.and, c.andi
+    li   a0, 100
+    li   a1, 27
+    sub  a0, a0, a1         # c.sub - 73
+    jal  ra, print_int
+    li   a1, 0x1F
+    xor  a0, a0, a1         # c.xor - 73 ^ 31 = 86
+    jal  ra, print_int
+    li   a1, 0x21
+    or   a0, a0, a1         # c.or - 86 | 33 = 119
+    jal  ra, print_int
+    li   a1, 0x0F
+    and  a0, a0, a1         # c.and - 119 & 15 = 7
+    jal  ra, print_int
+    li   a0, -1
+    andi a0, a0, -4         # c.andi - -4
+    jal  ra, print_int
+
+    # c.lui, c.addi16sp, c.addi4spn
+    lui  a0, 0x1F           # c.lui - 126976
+    jal  ra, print_int
+    addi sp, sp, -64        # c.addi16sp
+    addi a0, sp, 16         # c.addi4spn - 2032 - 64 + 16 = 1984
+    jal  ra, print_int
+    addi sp, sp, 64         # c.addi16sp
+
+    # c.jalr, c.jr and c.beqz through a function pointer
+    li   a5, TWICE_ADDR
+    li   a0, 21
+    jalr ra, 0(a5)          # c.jalr
+    jal  ra, print_int
+    li   a0, 0
+    beqz a0, skip           # c.beqz - taken
+    li   a0, 1
+skip:
+    jal  ra, print_int
+    li   a0, 3
+    beqz a0, not_taken      # c.beqz - not taken
+not_taken:
+    jal  ra, print_int
+
+    # c.j over a full size instruction
+    j    over               # c.j
+    addi a0, a0, 1000
+over:
+    jal  ra, print_int
+
+    # c.nop
+    nop
+    li   t0, VR_HALT_ADDR
+    sw   zero, 0(t0)
+
+# Prints a0 and a newline
+print_int:
+    li   t0, VR_WRITE_INT_ADDR
+    sw   a0, 0(t0)
+    li   t0, VR_WRITE_CHAR_ADDR
+    li   t1, '\n'
+    sb   t1, 0(t0)
+    ret                     # c.jr
+
+# a0 = a0 + a0, at a fixed address so its address can be loaded
+    .org TWICE_ADDR
+twice:
+    add  a0, a0, a0         # c.add
+    ret                     # c.jr
+
+    # Pad to the memory image size (instruction + data memory)
+    .org 0x800
@@ -0,0 +1,19 @@
+# Isaak Choi
+# 520488399
+# icho6322
+
+# Executes a compressed slli with --ext-c, which must not be implemented
+#  (slli isn't) and is reported as the 16 bit instruction at a half word pc
+
+    .equ VR_HALT_ADDR,        0x080C
+
+    .attribute arch, "rv32ic"
+    .text
+_start:
+    li   a0, 1              # c.li
+    slli a0, a0, 2          # c.slli
+    li   t0, VR_HALT_ADDR
+    sw   zero, 0(t0)
+
+    # Pad to the memory image size (instruction + data memory)
+    .org 0x800
@@ -0,0 +1,176 @@
+# Isaak Choi
+# 520488399
+# icho6322
+
+# Runs every vector unit operation at every element width over data memory
+#  arrays long enough for both the SIMD blocks and the scalar tail, then in
+#  place on a heap allocation, then with a destination partly overlapping a
+#  source, which must be an illegal operation
+
+    .equ VR_WRITE_CHAR_ADDR,  0x0800
+    .equ VR_WRITE_INT_ADDR,   0x0804
+    .equ VR_MALLOC_ADDR,      0x0830
+    .equ VR_MEMCPY_ADDR,      0x0840
+    .equ VR_VECTOR_RUN_ADDR,  0x085C
+    .equ MEMCPY_DESC_ADDR,    0x0400
+
+    # Descriptors { op, width, src1, src2, dst, len } - 24 bytes each
+    .equ ADD8_DESC,           0x0418
+    .equ MUL16_DESC,          0x0430
+    .equ MIN32_DESC,          0x0448
+    .equ MAX8_DESC,           0x0460
+    .equ DOT8_DESC,           0x0478
+    .equ DOT16_DESC,          0x0490
+    .equ DOT32_DESC,          0x04A8
+    .equ DOT_EMPTY_DESC,      0x04C0
+    .equ PREFIX16_DESC,       0x04D8
+    .equ HEAP_ADD32_DESC,     0x04F0
+    .equ OVERLAP_DESC,        0x0508
+
+    # Arrays - 37 bytes, 20 halves, 11 words
+    .equ A8_ADDR,             0x0520
+    .equ B8_ADDR,             0x0548
+    .equ D8_ADDR,             0x0570
+    .equ A16_ADDR,            0x0598
+    .equ B16_ADDR,            0x05C0
+    .equ D16_ADDR,            0x05E8
+    .equ A32_ADDR,            0x0610
+    .equ B32_ADDR,            0x063C
+    .equ D32_ADDR,            0x0668
+
+    .text
+_start:
+    li   sp, 2047
+
+    # Elementwise operations
+    li   a0, ADD8_DESC
+    jal  ra, run_and_print
+    li   a0, MUL16_DESC
+    jal  ra, run_and_print
+    li   a0, MIN32_DESC
+    jal  ra, run_and_print
+    li   a0, MAX8_DESC
+    jal  ra, run_and_print
+
+    # Dot products
+    li   a0, DOT8_DESC
+    jal  ra, run_dot
+    li   a0, DOT16_DESC
+    jal  ra, run_dot
+    li   a0, DOT32_DESC
+    jal  ra, run_dot
+    li   a0, DOT_EMPTY_DESC
+    jal  ra, run_dot
+
+    # Prefix sum in place
+    li   a0, PREFIX16_DESC
+    jal  ra, run_and_print
+
+    # Copy A32 into a heap allocation, then add B32 to it in place
+    li   t0, 44
+    li   t2, VR_MALLOC_ADDR
+    sw   t0, 0(t2)
+    li   s2, MEMCPY_DESC_ADDR
+    li   t0, A32_ADDR
+    li   t1, 44
+    sw   t3, 0(s2)
+    sw   t0, 4(s2)
+    sw   t1, 8(s2)
+    li   t2, VR_MEMCPY_ADDR
+    sw   s2, 0(t2)
+    li   a0, HEAP_ADD32_DESC
+    sw   t3, 8(a0)
+    sw   t3, 16(a0)
+    jal  ra, run_and_print
+
+    # Destination one byte past the start of src1
+    li   a0, OVERLAP_DESC
+    jal  ra, run_and_print
+
+# Runs the descriptor at a0, then prints its destination array
+run_and_print:
+    li   t0, VR_VECTOR_RUN_ADDR
+    sw   a0, 0(t0)
+    lw   s6, 4(a0)
+    lw   s5, 16(a0)
+    lw   s7, 20(a0)
+    li   t0, VR_WRITE_INT_ADDR
+    li   t1, VR_WRITE_CHAR_ADDR
+    li   t4, ' '
+print_loop:
+    beq  s7, zero, print_done
+    li   t2, 1
+    beq  s6, t2, print_byte
+    li   t2, 2
+    beq  s6, t2, print_half
+    lw   a1, 0(s5)
+    jal  zero, print_element
+print_byte:
+    lb   a1, 0(s5)
+    jal  zero, print_element
+print_half:
+    lh   a1, 0(s5)
+print_element:
+    sw   a1, 0(t0)
+    sb   t4, 0(t1)
+    add  s5, s5, s6
+    addi s7, s7, -1
+    jal  zero, print_loop
+print_done:
+    li   t4, '\n'
+    sb   t4, 0(t1)
+    jalr zero, ra, 0
+
+# Runs the dot product descriptor at a0, then prints R[28]
+run_dot:
+    li   t0, VR_VECTOR_RUN_ADDR
+    sw   a0, 0(t0)
+    li   t0, VR_WRITE_INT_ADDR
+    sw   t3, 0(t0)
+    li   t0, VR_WRITE_CHAR_ADDR
+    li   t1, '\n'
+    sb   t1, 0(t0)
+    jalr zero, ra, 0
+
+    # Data memory
+    .org 0x418
+    .word 0, 1, A8_ADDR, B8_ADDR, D8_ADDR, 37
+    .word 1, 2, A16_ADDR, B16_ADDR, D16_ADDR, 20
+    .word 2, 4, A32_ADDR, B32_ADDR, D32_ADDR, 11
+    .word 3, 1, A8_ADDR, B8_ADDR, D8_ADDR, 37
+    .word 4, 1, A8_ADDR, B8_ADDR, 0, 37
+    .word 4, 2, A16_ADDR, B16_ADDR, 0, 20
+    .word 4, 4, A32_ADDR, B32_ADDR, 0, 11
+    .word 4, 4, A32_ADDR, B32_ADDR, 0, 0
+    .word 5, 2, A16_ADDR, 0, A16_ADDR, 20
+    .word 0, 4, 0, B32_ADDR, 0, 11
+    .word 0, 1, A8_ADDR, B8_ADDR, A8_ADDR + 1, 8
+    .org 0x520
+    .byte 127, -128, -112, 35, 8, -7, 117, 113
+    .byte 107, -2, 99, -74, 5, 3, 54, -1
+    .byte -6, -35, -7, -77, -4, 78, -111, 59
+    .byte 72, 3, 113, 0, -61, -73, 3, 7
+    .byte -99, 3, 28, -9, 72
+    .org 0x548
+    .byte 127, -128, -90, 2, -42, 75, -67, 81
+    .byte -99, -1, -48, -35, 0, 55, 6, 4
+    .byte 7, -36, -7, -7, -106, -32, -108, 2
+    .byte 4, -2, 4, 46, -42, -3, -49, -57
+    .byte 103, -49, -3, -67, 6
+    .org 0x598
+    .half 32767, -32768, -6, 15266, 22525, -22150, 0, 2
+    .half -24442, -1, -8, -1, 7, 6, -8, 1866
+    .half -13159, 0, -8, 24026
+    .org 0x5c0
+    .half 32767, -32768, -4, -11222, 10531, 9580, -12793, 2
+    .half 21612, -359, 6, 8, 0, 9, 13826, 21769
+    .half -2, 9, -2, -9800
+    .org 0x610
+    .word 2147483647, -2147483648, -4, 1, -2, 903128033, -9, 4
+    .word -2035371023, -127096429, 4
+    .org 0x63c
+    .word 2147483647, -2147483648, 8, -5, -2, 3, 7, 845594182
+    .word -1825949105, 659099981, 7
+
+    # Pad to the memory image size (instruction + data memory)
+    .org 0x800
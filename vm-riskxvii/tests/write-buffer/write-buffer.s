@@ -0,0 +1,52 @@
+# Isaak Choi
+# 520488399
+# icho6322
+
+# Prints a buffer and NUL terminated strings from data memory with the
+#  console write buffer / string virtual routines, then a string with no
+#  NUL before the end of data memory, which must be an illegal operation
+
+    .equ VR_WRITE_BUF_ADDR,   0x084C
+    .equ VR_WRITE_STR_ADDR,   0x0850
+    .equ DESCRIPTOR_ADDR,     0x0700
+    .equ GREETING_ADDR,       0x0400
+    .equ WORLD_ADDR,          0x040C
+    .equ EMPTY_ADDR,          0x0414
+    .equ UNTERMINATED_ADDR,   0x07F8
+
+    .text
+_start:
+    li   sp, 2047
+    li   s2, DESCRIPTOR_ADDR
+    li   s3, VR_WRITE_STR_ADDR
+
+    # "Hello, " - First 7 bytes of the greeting
+    li   t0, GREETING_ADDR
+    li   t1, 7
+    sw   t0, 0(s2)
+    sw   t1, 4(s2)
+    li   t2, VR_WRITE_BUF_ADDR
+    sw   s2, 0(t2)
+
+    # "world!\n", then an empty string
+    li   t0, WORLD_ADDR
+    sw   t0, 0(s3)
+    li   t0, EMPTY_ADDR
+    sw   t0, 0(s3)
+
+    # Runs off the end of data memory
+    li   t0, UNTERMINATED_ADDR
+    sw   t0, 0(s3)
+
+    .org GREETING_ADDR
+    .ascii "Hello, there"
+    .org WORLD_ADDR
+    .asciz "world!\n"
+    .org EMPTY_ADDR
+    .asciz ""
+
+    .org UNTERMINATED_ADDR
+    .ascii "no NUL.."
+
+    # Pad to the memory image size (instruction + data memory)
+    .org 0x800
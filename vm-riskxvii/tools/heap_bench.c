@@ -0,0 +1,379 @@
+// Name:   Isaak Choi
+// UniKey: icho6322
+// SID:    520488399
+
+
+/* heap_bench.c
+
+    Host side benchmark of the heap manager allocation policies.
+
+    Replays synthetic malloc / free traces against a heap manager using each
+    policy in turn and reports, per trace and policy:
+
+    * ns/op     | Mean wall time of each malloc / free call
+    * failed    | Number of mallocs that found no run of free banks
+    * peak frag | Peak external fragmentation, i.e., the largest fraction of
+                  free banks that were outside the longest free run (while at
+                  least 1/8 of the heap was free)
+
+    USAGE
+    heap_bench [ops] [seed]
+
+    NOTE
+    * Every policy replays the exact same trace - Frees refer to the n-th
+      malloc of the trace and are skipped if that malloc failed
+    * Uses a 1 MiB heap of 64 byte banks
+
+*/
+
+
+// Required for clock_gettime() under -std=c11
+#define _POSIX_C_SOURCE 199309L
+
+
+// DEPENDENCIES ...
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include "heap_manager.h"
+
+
+// CONSTANTS ...
+
+// Heap geometry used by every trace
+#define BENCH_HEAP_BANK_SIZE (64)
+#define BENCH_HEAP_MEM_SIZE  (1024 * 1024)
+
+// Defaults for the command line arguments
+#define DFLT_BENCH_OPS  (1000000)
+#define DFLT_BENCH_SEED (1)
+
+// Number of short lived objects live at once in the long-lived trace
+#define BENCH_SHORT_LIVED (8)
+
+// Trace operation kinds
+#define TRACE_MALLOC (0)
+#define TRACE_FREE   (1)
+
+
+// DATA STRUCTURES ...
+
+// A single traced heap operation
+typedef struct trace_op_t trace_op_t;
+struct trace_op_t {
+    int kind;     // TRACE_MALLOC or TRACE_FREE
+    int32_t arg;  // Malloc size in bytes, or the id (n) of the malloc to free
+};
+
+// Allocations of a trace that have not been freed yet
+typedef struct live_set_t live_set_t;
+struct live_set_t {
+    int32_t* ids;   // Malloc id (n) of each live allocation
+    int32_t* sizes; // Size in bytes of each live allocation
+    int num;        // The number of live allocations
+    int64_t bytes;  // Total size in bytes of the live allocations
+};
+
+// A synthetic trace
+typedef struct trace_t trace_t;
+struct trace_t {
+    const char* name;
+    trace_op_t* ops;
+    int capacity;
+    int num_ops;
+    int num_mallocs;
+};
+
+
+// TRACE GENERATORS ...
+
+/* Returns a pseudo random size in [min, max] */
+static int32_t rand_size(const int32_t min, const int32_t max) {
+    return min + rand() % (max - min + 1);
+}
+
+/* Appends the given operation to the trace - Dropped if the trace is full */
+static void trace_push(trace_t* const trace, const int kind, const int32_t arg) {
+    if (trace->num_ops == trace->capacity) {
+        return;
+    }
+    trace->ops[trace->num_ops].kind = kind;
+    trace->ops[trace->num_ops].arg = arg;
+    trace->num_ops++;
+    if (kind == TRACE_MALLOC) {
+        trace->num_mallocs++;
+    }
+}
+
+/* Appends a malloc of the given size and adds it to the live set */
+static void trace_malloc(trace_t* const trace, live_set_t* const live,
+                         const int32_t size) {
+    live->ids[live->num] = trace->num_mallocs;
+    live->sizes[live->num] = size;
+    live->num++;
+    live->bytes += size;
+    trace_push(trace, TRACE_MALLOC, size);
+}
+
+/* Appends a free of the i-th live allocation and removes it from the set */
+static void trace_free(trace_t* const trace, live_set_t* const live,
+                       const int i) {
+    trace_push(trace, TRACE_FREE, live->ids[i]);
+    live->bytes -= live->sizes[i];
+    live->num--;
+    live->ids[i] = live->ids[live->num];
+    live->sizes[i] = live->sizes[live->num];
+}
+
+/* Mixed sizes - Mostly small objects, some medium, a few large
+    Random frees keep the live set at up to 85% of the heap
+*/
+static void gen_mixed(trace_t* const trace, const int num_ops,
+                      live_set_t* const live) {
+    while (trace->num_ops < num_ops) {
+        if (live->num > 0 && (live->bytes > BENCH_HEAP_MEM_SIZE * 85 / 100 ||
+                              rand() % 2 == 0)) {
+            trace_free(trace, live, rand() % live->num);
+            continue;
+        }
+        const int r = rand() % 100;
+        trace_malloc(trace, live, (r < 70) ? rand_size(1, 128) :
+                                  (r < 95) ? rand_size(129, 1024) :
+                                             rand_size(1025, 16384));
+    }
+}
+
+/* Phases - Fill 7/8 of the heap with small objects, free a random half of
+    them, then ask for larger objects until the heap is 7/8 full again
+*/
+static void gen_phases(trace_t* const trace, const int num_ops,
+                       live_set_t* const live) {
+    const int64_t target = (int64_t)BENCH_HEAP_MEM_SIZE * 7 / 8;
+    while (trace->num_ops < num_ops) {
+        while (live->bytes < target && trace->num_ops < num_ops) {
+            trace_malloc(trace, live, rand_size(1, 2 * BENCH_HEAP_BANK_SIZE));
+        }
+        const int half = live->num / 2;
+        for (int i = 0; i < half && trace->num_ops < num_ops; i++) {
+            trace_free(trace, live, rand() % live->num);
+        }
+        while (live->bytes < target && trace->num_ops < num_ops) {
+            trace_malloc(trace, live, rand_size(2 * BENCH_HEAP_BANK_SIZE + 1,
+                                                8 * BENCH_HEAP_BANK_SIZE));
+        }
+
+        // Release everything before the next round
+        while (live->num > 0 && trace->num_ops < num_ops) {
+            trace_free(trace, live, rand() % live->num);
+        }
+    }
+}
+
+/* Long lived objects - Short lived objects of random size freed a few
+    allocations later, with 1 in 16 kept as long lived objects which are
+    randomly released to hold them at up to half of the heap
+*/
+static void gen_long_lived(trace_t* const trace, const int num_ops,
+                           live_set_t* const live) {
+
+    // Long lived objects are kept at the front of the live set
+    int num_long = 0;
+    while (trace->num_ops < num_ops) {
+        trace_malloc(trace, live, rand_size(1, 2048));
+
+        // Keep it, or free the oldest short lived object
+        const int num_short = live->num - num_long;
+        if (rand() % 16 == 0 && live->bytes < BENCH_HEAP_MEM_SIZE / 2) {
+
+            // Swap into the long lived part of the set
+            const int last = live->num - 1;
+            const int32_t id = live->ids[last];
+            const int32_t size = live->sizes[last];
+            live->ids[last] = live->ids[num_long];
+            live->sizes[last] = live->sizes[num_long];
+            live->ids[num_long] = id;
+            live->sizes[num_long] = size;
+            num_long++;
+        }
+        else if (num_short > BENCH_SHORT_LIVED) {
+            trace_free(trace, live, num_long);
+        }
+
+        // Release a random long lived object now and then
+        if (num_long > 0 && rand() % 64 == 0) {
+            const int i = rand() % num_long;
+            num_long--;
+            const int32_t id = live->ids[i];
+            const int32_t size = live->sizes[i];
+            live->ids[i] = live->ids[num_long];
+            live->sizes[i] = live->sizes[num_long];
+            live->ids[num_long] = id;
+            live->sizes[num_long] = size;
+            trace_free(trace, live, num_long);
+        }
+    }
+}
+
+
+// REPLAY ...
+
+/* Returns the current monotonic time in nanoseconds */
+static uint64_t monotonic_ns() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000 + (uint64_t)now.tv_nsec;
+}
+
+/* Returns the current external fragmentation of the given manager
+    Only measured while at least 1/8 of the heap is free - A nearly full heap
+    is always fragmented
+*/
+static double fragmentation(const heap_manager_t* const manager) {
+    if (manager->free_banks < heap_geometry.bank_num / 8) {
+        return 0.0;
+    }
+    const int32_t longest = manager->free_map.tree[1].best;
+    return 1.0 - (double)longest / manager->free_banks;
+}
+
+/* Replays the given trace against a fresh heap manager using the given
+    policy
+
+    * Saves the address returned by each malloc in 'addrs' (by op index)
+    * Samples fragmentation after each malloc if 'peak_frag' is not NULL
+
+    RETURNS
+    The wall time taken in nanoseconds
+*/
+static uint64_t replay_pass(const trace_t* const trace, const int policy,
+                            int32_t* const addrs, int* const failed,
+                            double* const peak_frag) {
+
+    // Fresh manager
+    heap_manager_t manager;
+    if (!heap_manager_init(&manager, policy)) {
+        printf("ERR: Couldn't allocate heap manager\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Replay
+    *failed = 0;
+    const uint64_t start_ns = monotonic_ns();
+    for (int i = 0; i < trace->num_ops; i++) {
+        const trace_op_t op = trace->ops[i];
+        if (op.kind == TRACE_MALLOC) {
+            manager.malloc(&manager, op.arg);
+            addrs[i] = registers[HEAP_PTR_OUT_REGISTER];
+            *failed += (addrs[i] == MALLOC_FAIL_RETURN_VAL);
+            if (peak_frag != NULL) {
+                const double frag = fragmentation(&manager);
+                *peak_frag = (frag > *peak_frag) ? frag : *peak_frag;
+            }
+        }
+        else {
+            // Frees of failed mallocs free NULL, which does nothing
+            manager.free(&manager, addrs[op.arg]);
+        }
+    }
+    const uint64_t elapsed_ns = monotonic_ns() - start_ns;
+
+    heap_manager_deallocate(&manager);
+    return elapsed_ns;
+}
+
+/* Replays the given trace with the given policy and prints its results
+    Timed and fragmentation sampling passes are kept separate
+*/
+static void replay(const trace_t* const trace, const int policy,
+                   int32_t* const addrs) {
+
+    static const char* const policy_names[HEAP_POLICY_NUM] = HEAP_POLICY_NAMES;
+
+    int failed;
+    double peak_frag = 0.0;
+    const uint64_t elapsed_ns = replay_pass(trace, policy, addrs, &failed, NULL);
+    replay_pass(trace, policy, addrs, &failed, &peak_frag);
+
+    printf("  %-10s | %8.1f | %8d | %8.1f%%\n", policy_names[policy],
+           (double)elapsed_ns / trace->num_ops, failed, 100.0 * peak_frag);
+}
+
+
+// MAIN ...
+
+/* Main - Generates each trace and replays it with every policy */
+int main(int argc, char** argv) {
+
+    // Arguments
+    const int num_ops = (argc > 1) ? atoi(argv[1]) : DFLT_BENCH_OPS;
+    srand((argc > 2) ? (unsigned)atoi(argv[2]) : DFLT_BENCH_SEED);
+    if (num_ops <= 0) {
+        printf("USAGE: heap_bench [ops] [seed]\n");
+        return EXIT_FAILURE;
+    }
+
+    // Heap geometry
+    heap_geometry.bank_size = BENCH_HEAP_BANK_SIZE;
+    heap_geometry.mem_size = BENCH_HEAP_MEM_SIZE;
+    heap_geometry.bank_num = BENCH_HEAP_MEM_SIZE / BENCH_HEAP_BANK_SIZE;
+    heap_geometry.mem_end = HEAP_MEM_START + BENCH_HEAP_MEM_SIZE - 0x01;
+
+    // Traces
+    void (*const generators[])(trace_t* const, const int, live_set_t* const) = {
+        &gen_mixed, &gen_phases, &gen_long_lived
+    };
+    const char* const names[] = {"mixed", "phases", "long-lived"};
+    const int num_traces = sizeof(names) / sizeof(names[0]);
+
+    // Working storage - Shared by every trace
+    trace_op_t* const ops = malloc(num_ops * sizeof(trace_op_t));
+    live_set_t live = {malloc(num_ops * sizeof(int32_t)),
+                       malloc(num_ops * sizeof(int32_t)), 0, 0};
+    int32_t* const addrs = malloc(num_ops * sizeof(int32_t));
+    int32_t* const malloc_op = malloc(num_ops * sizeof(int32_t));
+    if (ops == NULL || live.ids == NULL || live.sizes == NULL ||
+        addrs == NULL || malloc_op == NULL) {
+        printf("ERR: Couldn't allocate traces\n");
+        return EXIT_FAILURE;
+    }
+
+    for (int t = 0; t < num_traces; t++) {
+
+        // Generate
+        trace_t trace = {names[t], ops, num_ops, 0, 0};
+        live.num = 0;
+        live.bytes = 0;
+        generators[t](&trace, num_ops, &live);
+
+        // Point frees at the op index of the malloc they free
+        int n = 0;
+        for (int i = 0; i < trace.num_ops; i++) {
+            if (ops[i].kind == TRACE_MALLOC) {
+                malloc_op[n++] = i;
+            }
+        }
+        for (int i = 0; i < trace.num_ops; i++) {
+            if (ops[i].kind == TRACE_FREE) {
+                ops[i].arg = malloc_op[ops[i].arg];
+            }
+        }
+
+        // Replay with every policy
+        printf("trace [%s]: %d ops, %d mallocs\n", trace.name,
+               trace.num_ops, trace.num_mallocs);
+        printf("  %-10s | %8s | %8s | %9s\n", "policy", "ns/op", "failed",
+               "peak frag");
+        for (int policy = 0; policy < HEAP_POLICY_NUM; policy++) {
+            replay(&trace, policy, addrs);
+        }
+        printf("\n");
+    }
+
+    free(ops);
+    free(live.ids);
+    free(live.sizes);
+    free(addrs);
+    free(malloc_op);
+    return EXIT_SUCCESS;
+}
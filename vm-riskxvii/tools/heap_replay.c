@@ -0,0 +1,361 @@
+// Name:   Isaak Choi
+// UniKey: icho6322
+// SID:    520488399
+
+
+/* heap_replay.c
+
+    Host side replay of a guest heap trace (see heap_trace.h), as recorded
+    by vm_riskxvii --heap-trace=<file>.
+
+    Replays the traced malloc / free / calloc / realloc calls against a
+    fresh heap manager, without the guest, and reports:
+
+    * ops/s     | Heap manager calls per second of wall time
+    * failed    | Number of allocations that found no run of free banks
+    * diverged  | Number of allocations that returned a different address
+                  than in the traced run (0 when replaying with the traced
+                  policy)
+
+    USAGE
+    heap_replay <trace> [policy] [repeat]
+
+    NOTE
+    * The heap geometry is taken from the trace, the policy defaults to the
+      traced one
+    * Frees and reallocs refer to the allocation they free or resize, so a
+      trace can be replayed with any policy - Those of allocations that
+      failed in the replay pass NULL
+    * A free or realloc that errored in the traced run is not replayed
+
+*/
+
+
+// Required for clock_gettime() under -std=c11
+#define _POSIX_C_SOURCE 199309L
+
+
+// DEPENDENCIES ...
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include "heap_manager.h"
+#include "heap_trace.h"
+
+
+// CONSTANTS ...
+
+// Defaults for the command line arguments
+#define DFLT_REPLAY_REPEAT (1)
+
+// Free of NULL - The op index freed by a traced free(NULL)
+#define REPLAY_FREE_NULL (-1)
+
+// Replayed realloc - Joins a traced realloc addr and realloc size event
+#define REPLAY_REALLOC   (HEAP_TRACE_REALLOC_ADDR)
+
+// Initial capacity of the loaded trace in ops
+#define REPLAY_INIT_OPS (1024)
+
+
+// DATA STRUCTURES ...
+
+// A single replayed heap operation
+typedef struct replay_op_t replay_op_t;
+struct replay_op_t {
+    uint8_t kind;    // HEAP_TRACE_MALLOC / FREE / CALLOC, or REPLAY_REALLOC
+    int32_t arg;     // Allocation size in bytes, or for a free the op index
+                     // of the allocation to free (REPLAY_FREE_NULL for NULL)
+    int32_t from;    // Realloc only - Op index of the allocation to resize
+                     //  (REPLAY_FREE_NULL for NULL)
+    int32_t traced;  // Allocation address returned in the traced run
+};
+
+// A loaded trace
+typedef struct replay_trace_t replay_trace_t;
+struct replay_trace_t {
+    heap_trace_header_t header;
+    replay_op_t* ops;
+    int num_ops;
+    int max_ops;
+};
+
+
+// LOADING ...
+
+/* Appends the given op to the trace, growing it if full
+
+    RETURNS
+    true  | On success
+    false | If the host is out of memory
+*/
+static bool trace_push(replay_trace_t* const trace, const replay_op_t op) {
+    if (trace->num_ops == trace->max_ops) {
+        const int max_ops = (trace->max_ops == 0) ?
+                            REPLAY_INIT_OPS : trace->max_ops * 2;
+        replay_op_t* const ops = realloc(trace->ops,
+                                         max_ops * sizeof(replay_op_t));
+        if (ops == NULL) {
+            return false;
+        }
+        trace->ops = ops;
+        trace->max_ops = max_ops;
+    }
+    trace->ops[trace->num_ops++] = op;
+    return true;
+}
+
+/* Returns whether the traced heap geometry can be used by a heap manager */
+static bool is_valid_geometry(const heap_trace_header_t* const header) {
+    return (header->bank_size > 0 && header->heap_size > 0 &&
+            header->heap_size <= MAX_HEAP_MEM_SIZE &&
+            header->heap_size % header->bank_size == 0 &&
+            header->policy >= 0 && header->policy < HEAP_POLICY_NUM);
+}
+
+/* Loads the trace at the given path, pointing each free at the op index of
+    the malloc it frees
+
+    RETURNS
+    true  | On success
+    false | If the file couldn't be read or is not a valid heap trace
+*/
+static bool load_trace(const char* const path, replay_trace_t* const trace) {
+
+    // Open and check header
+    FILE* const file = fopen(path, "rb");
+    if (file == NULL) {
+        printf("ERR: Couldn't open file \"%s\"\n", path);
+        return false;
+    }
+    if (!heap_trace_read_header(file, &trace->header) ||
+        !is_valid_geometry(&trace->header)) {
+        printf("ERR: Invalid heap trace \"%s\"\n", path);
+        fclose(file);
+        return false;
+    }
+
+    // Op index of the live malloc starting at each heap bank
+    const int32_t bank_size = trace->header.bank_size;
+    const int32_t bank_num = trace->header.heap_size / bank_size;
+    int32_t* const live_op = malloc(bank_num * sizeof(int32_t));
+    if (live_op == NULL) {
+        printf("ERR: Couldn't allocate trace\n");
+        fclose(file);
+        return false;
+    }
+    for (int32_t i = 0; i < bank_num; i++) {
+        live_op[i] = REPLAY_FREE_NULL;
+    }
+
+    // Read events
+    bool valid = true;
+    int32_t realloc_from = REPLAY_FREE_NULL; // Of the pending realloc
+    heap_trace_event_t event;
+    while (valid && heap_trace_read_event(file, &event)) {
+        replay_op_t op = {event.kind, event.arg, REPLAY_FREE_NULL,
+                          event.result};
+
+        // Errored frees and reallocs are not replayed
+        if ((event.kind == HEAP_TRACE_FREE ||
+             event.kind == HEAP_TRACE_REALLOC_ADDR) &&
+            event.result == HEAP_TRACE_FREE_ERR) {
+            continue;
+        }
+
+        // Point frees and reallocs at the allocation they free
+        if (event.kind == HEAP_TRACE_FREE ||
+            event.kind == HEAP_TRACE_REALLOC_ADDR) {
+            int32_t from = REPLAY_FREE_NULL;
+            if (event.arg != 0) {
+                const int32_t bank = (event.arg - HEAP_MEM_START) / bank_size;
+                valid = (event.arg >= HEAP_MEM_START && bank < bank_num);
+                from = valid ? live_op[bank] : REPLAY_FREE_NULL;
+            }
+
+            // Freed now, the realloc waits for its size event
+            if (event.kind == HEAP_TRACE_FREE) {
+                op.arg = from;
+                if (from != REPLAY_FREE_NULL) {
+                    live_op[(event.arg - HEAP_MEM_START) / bank_size] =
+                        REPLAY_FREE_NULL;
+                }
+                valid = valid && trace_push(trace, op);
+            }
+            else {
+                realloc_from = from;
+            }
+            continue;
+        }
+
+        // A successful realloc no longer holds its old allocation
+        if (event.kind == HEAP_TRACE_REALLOC_SIZE) {
+            op.kind = REPLAY_REALLOC;
+            op.from = realloc_from;
+            if (event.result != MALLOC_FAIL_RETURN_VAL &&
+                realloc_from != REPLAY_FREE_NULL) {
+                const int32_t old_addr = trace->ops[realloc_from].traced;
+                live_op[(old_addr - HEAP_MEM_START) / bank_size] =
+                    REPLAY_FREE_NULL;
+            }
+            realloc_from = REPLAY_FREE_NULL;
+        }
+        else if (event.kind != HEAP_TRACE_MALLOC &&
+                 event.kind != HEAP_TRACE_CALLOC) {
+            valid = false;
+        }
+
+        // Remember where each successful allocation was placed
+        if (valid && event.result != MALLOC_FAIL_RETURN_VAL) {
+            const int32_t bank = (event.result - HEAP_MEM_START) / bank_size;
+            valid = (event.result >= HEAP_MEM_START && bank < bank_num);
+            if (valid) {
+                live_op[bank] = trace->num_ops;
+            }
+        }
+
+        valid = valid && trace_push(trace, op);
+    }
+
+    free(live_op);
+    fclose(file);
+    if (!valid) {
+        printf("ERR: Invalid heap trace \"%s\"\n", path);
+    }
+    return valid;
+}
+
+
+// REPLAY ...
+
+/* Returns the current monotonic time in nanoseconds */
+static uint64_t monotonic_ns() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000 + (uint64_t)now.tv_nsec;
+}
+
+/* Replays the given trace against a fresh heap manager using the given
+    policy
+
+    * Saves the address returned by each malloc in 'addrs' (by op index)
+    * Counts the mallocs that failed, or returned a different address than
+      in the traced run
+
+    RETURNS
+    The wall time taken in nanoseconds
+*/
+static uint64_t replay_pass(const replay_trace_t* const trace,
+                            const int policy, int32_t* const addrs,
+                            int* const failed, int* const diverged) {
+
+    // Fresh manager
+    heap_manager_t manager;
+    if (!heap_manager_init(&manager, policy)) {
+        printf("ERR: Couldn't allocate heap manager\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Replay
+    *failed = 0;
+    *diverged = 0;
+    const uint64_t start_ns = monotonic_ns();
+    for (int i = 0; i < trace->num_ops; i++) {
+        const replay_op_t op = trace->ops[i];
+        switch (op.kind) {
+            case HEAP_TRACE_FREE:
+                manager.free(&manager, (op.arg == REPLAY_FREE_NULL) ?
+                                       MALLOC_FAIL_RETURN_VAL : addrs[op.arg]);
+                continue;
+            case HEAP_TRACE_CALLOC:
+                manager.calloc(&manager, op.arg);
+                break;
+            case REPLAY_REALLOC:
+                manager.realloc(&manager, (op.from == REPLAY_FREE_NULL) ?
+                                          MALLOC_FAIL_RETURN_VAL :
+                                          addrs[op.from], op.arg);
+                break;
+            default:
+                manager.malloc(&manager, op.arg);
+        }
+        addrs[i] = registers[HEAP_PTR_OUT_REGISTER];
+        *failed += (addrs[i] == MALLOC_FAIL_RETURN_VAL);
+        *diverged += (addrs[i] != op.traced);
+    }
+    const uint64_t elapsed_ns = monotonic_ns() - start_ns;
+
+    heap_manager_deallocate(&manager);
+    return elapsed_ns;
+}
+
+
+// MAIN ...
+
+/* Main - Loads the given trace and replays it */
+int main(int argc, char** argv) {
+
+    static const char* const policy_names[HEAP_POLICY_NUM] = HEAP_POLICY_NAMES;
+
+    // Arguments
+    if (argc < 2 || argc > 4) {
+        printf("USAGE: heap_replay <trace> [policy] [repeat]\n");
+        return EXIT_FAILURE;
+    }
+    replay_trace_t trace = {{0, 0, 0}, NULL, 0, 0};
+    if (!load_trace(argv[1], &trace)) {
+        free(trace.ops);
+        return EXIT_FAILURE;
+    }
+    const int policy = (argc > 2) ? heap_policy_from_name(argv[2])
+                                  : trace.header.policy;
+    const int repeat = (argc > 3) ? atoi(argv[3]) : DFLT_REPLAY_REPEAT;
+    if (policy < 0 || repeat <= 0) {
+        printf("USAGE: heap_replay <trace> [policy] [repeat]\n");
+        free(trace.ops);
+        return EXIT_FAILURE;
+    }
+
+    // Heap geometry of the traced run
+    heap_geometry.bank_size = trace.header.bank_size;
+    heap_geometry.mem_size = trace.header.heap_size;
+    heap_geometry.bank_num = trace.header.heap_size / trace.header.bank_size;
+    heap_geometry.mem_end = HEAP_MEM_START + trace.header.heap_size - 0x01;
+
+    // Heap bank memory - Zeroed by calloc and copied by realloc
+    heap_memory = calloc(heap_geometry.mem_size, sizeof(byte));
+
+    // Replay - Every pass is identical, so only the last one's counts are kept
+    int32_t* const addrs = malloc((trace.num_ops + 1) * sizeof(int32_t));
+    if (addrs == NULL || heap_memory == NULL) {
+        printf("ERR: Couldn't allocate trace\n");
+        free(addrs);
+        free(heap_memory);
+        free(trace.ops);
+        return EXIT_FAILURE;
+    }
+    int failed = 0;
+    int diverged = 0;
+    uint64_t elapsed_ns = 0;
+    for (int i = 0; i < repeat; i++) {
+        elapsed_ns += replay_pass(&trace, policy, addrs, &failed, &diverged);
+    }
+
+    // Report
+    const double total_ops = (double)trace.num_ops * repeat;
+    printf("trace     | %s\n", argv[1]);
+    printf("heap      | %d banks of %d bytes\n",
+           heap_geometry.bank_num, heap_geometry.bank_size);
+    printf("policy    | %s (traced %s)\n", policy_names[policy],
+           policy_names[trace.header.policy]);
+    printf("ops       | %d x %d\n", trace.num_ops, repeat);
+    printf("ops/s     | %.0f\n",
+           (elapsed_ns > 0) ? total_ops * 1e9 / elapsed_ns : 0.0);
+    printf("failed    | %d\n", failed);
+    printf("diverged  | %d\n", diverged);
+
+    free(addrs);
+    free(heap_memory);
+    free(trace.ops);
+    return EXIT_SUCCESS;
+}
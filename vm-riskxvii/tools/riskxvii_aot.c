@@ -0,0 +1,886 @@
+// Name:   Isaak Choi
+// UniKey: icho6322
+// SID:    520488399
+
+
+/* riskxvii_aot.c
+
+    Ahead of time translator of memory images to C (see aot.h).
+
+    * Finds the basic blocks of the image - Block leaders are the entry
+      point, branch and jal targets, and the instruction after each branch
+      or jump - once for 32 bit decoding and once for --ext-c decoding
+    * Emits each block as a labelled section of one C function per
+      decoding, with the guest registers the block uses held in locals,
+      which is compiled into a shared object for vm_riskxvii --aot=<file.so>
+    * Blocks are chained - Branches, jal and fall through go straight to
+      the block of their successor, and jalr finds its target through the
+      guest return address stack (for returns), then the site's inline
+      cache, then the table of block labels, so control only goes back to
+      the vm for targets no block starts at
+    * Base instructions are translated to C. Every other instruction
+      (extensions, unknown encodings) is handed to exec_instruction, so it
+      is only decoded if the vm runs with its --ext-* option, exactly as
+      when interpreting
+
+    USAGE
+    riskxvii_aot <image.mi> <out.c>
+
+    NOTE
+    * Loads and stores of data memory (and loads of instruction memory)
+      are done in place, everything else goes through mem_read / mem_write
+    * The translation mirrors the interpreter's handlers, including their
+      quirks (see exec_sll, exec_sra, exec_jalr and exec_lw)
+    * Chaining relies on GNU C labels as values (&&label, goto *)
+
+*/
+
+
+// DEPENDENCIES ...
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "system.h"
+#include "instructions.h"
+#include "rvc.h"
+#include "aot.h"
+
+
+// CONSTANTS ...
+
+// Base instructions translated to C - In the order exec_instruction()
+//  matches them, as an encoding may match more than one
+#define OP_ADD      (0)
+#define OP_ADDI     (1)
+#define OP_SUB      (2)
+#define OP_LUI      (3)
+#define OP_XOR      (4)
+#define OP_XORI     (5)
+#define OP_OR       (6)
+#define OP_ORI      (7)
+#define OP_AND      (8)
+#define OP_ANDI     (9)
+#define OP_SLL      (10)
+#define OP_SRL      (11)
+#define OP_SRA      (12)
+#define OP_LB       (13)
+#define OP_LH       (14)
+#define OP_LW       (15)
+#define OP_LBU      (16)
+#define OP_LHU      (17)
+#define OP_SB       (18)
+#define OP_SH       (19)
+#define OP_SW       (20)
+#define OP_SLT      (21)
+#define OP_SLTI     (22)
+#define OP_SLTU     (23)
+#define OP_SLTIU    (24)
+#define OP_BEQ      (25)
+#define OP_BNE      (26)
+#define OP_BLT      (27)
+#define OP_BLTU     (28)
+#define OP_BGE      (29)
+#define OP_BGEU     (30)
+#define OP_JAL      (31)
+#define OP_JALR     (32)
+#define NUM_OPS     (33)
+
+// Any other instruction - Run by exec_instruction()
+#define OP_FALLBACK (-1)
+
+// Link registers (ra, t0) - A jal / jalr writing one is a call, and a jalr
+//  through one that writes the zero register is a return
+#define IS_LINK_REGISTER(reg) ((reg) == 1 || (reg) == 5)
+
+
+// DATA STRUCTURES ...
+
+// How a base instruction is matched and unpacked
+typedef struct aot_op_t aot_op_t;
+struct aot_op_t {
+    const char* name;
+    int32_t extract_mask;
+    int32_t id_bits;
+    void (*extract)(instruction_t* const, int32_t);
+};
+
+// A decoded instruction of the image
+typedef struct aot_instr_t aot_instr_t;
+struct aot_instr_t {
+    int32_t addr;        // Address in instruction memory
+    int32_t size;        // INST_SIZE_BYTES, or RVC_SIZE_BYTES if compressed
+    int32_t raw;         // The instruction - Expanded if compressed
+    uint16_t half;       // The compressed instruction (if compressed)
+    int op;              // One of OP_*
+    instruction_t f;     // Unpacked fields (base instructions only)
+};
+
+// The translation of one decoding of the image
+typedef struct aot_translation_t aot_translation_t;
+struct aot_translation_t {
+    const byte* image;           // Instruction memory
+    bool rvc;                    // Whether decoded with --ext-c
+    const char* prefix;          // Prefix of its block function names
+    bool leader[INST_MEM_SIZE];  // Whether a block starts at each address
+};
+
+// State while emitting one block
+typedef struct aot_emitter_t aot_emitter_t;
+struct aot_emitter_t {
+    FILE* out;
+    const aot_translation_t* t;
+    bool rvc;
+    uint32_t used;       // Registers the block reads or writes (bit per reg)
+    uint32_t dirty;      // Registers written so far
+    int compressed;      // Compressed instrs since budget.block_compressed
+                         //  was last brought up to date
+};
+
+
+// GLOBALS ...
+
+// The base instructions, indexed by OP_*
+static const aot_op_t ops[NUM_OPS] = {
+    [OP_ADD]   = {"add",   ID_EXTRACT_MASK_3, ADD_ID_BITS,   extract_R},
+    [OP_ADDI]  = {"addi",  ID_EXTRACT_MASK_2, ADDI_ID_BITS,  extract_I},
+    [OP_SUB]   = {"sub",   ID_EXTRACT_MASK_3, SUB_ID_BITS,   extract_R},
+    [OP_LUI]   = {"lui",   ID_EXTRACT_MASK_1, LUI_ID_BITS,   extract_U},
+    [OP_XOR]   = {"xor",   ID_EXTRACT_MASK_3, XOR_ID_BITS,   extract_R},
+    [OP_XORI]  = {"xori",  ID_EXTRACT_MASK_2, XORI_ID_BITS,  extract_I},
+    [OP_OR]    = {"or",    ID_EXTRACT_MASK_3, OR_ID_BITS,    extract_R},
+    [OP_ORI]   = {"ori",   ID_EXTRACT_MASK_2, ORI_ID_BITS,   extract_I},
+    [OP_AND]   = {"and",   ID_EXTRACT_MASK_3, AND_ID_BITS,   extract_R},
+    [OP_ANDI]  = {"andi",  ID_EXTRACT_MASK_2, ANDI_ID_BITS,  extract_I},
+    [OP_SLL]   = {"sll",   ID_EXTRACT_MASK_3, SLL_ID_BITS,   extract_R},
+    [OP_SRL]   = {"srl",   ID_EXTRACT_MASK_3, SRL_ID_BITS,   extract_R},
+    [OP_SRA]   = {"sra",   ID_EXTRACT_MASK_3, SRA_ID_BITS,   extract_R},
+    [OP_LB]    = {"lb",    ID_EXTRACT_MASK_2, LB_ID_BITS,    extract_I},
+    [OP_LH]    = {"lh",    ID_EXTRACT_MASK_2, LH_ID_BITS,    extract_I},
+    [OP_LW]    = {"lw",    ID_EXTRACT_MASK_2, LW_ID_BITS,    extract_I},
+    [OP_LBU]   = {"lbu",   ID_EXTRACT_MASK_2, LBU_ID_BITS,   extract_I},
+    [OP_LHU]   = {"lhu",   ID_EXTRACT_MASK_2, LHU_ID_BITS,   extract_I},
+    [OP_SB]    = {"sb",    ID_EXTRACT_MASK_2, SB_ID_BITS,    extract_S},
+    [OP_SH]    = {"sh",    ID_EXTRACT_MASK_2, SH_ID_BITS,    extract_S},
+    [OP_SW]    = {"sw",    ID_EXTRACT_MASK_2, SW_ID_BITS,    extract_S},
+    [OP_SLT]   = {"slt",   ID_EXTRACT_MASK_3, SLT_ID_BITS,   extract_R},
+    [OP_SLTI]  = {"slti",  ID_EXTRACT_MASK_2, SLTI_ID_BITS,  extract_I},
+    [OP_SLTU]  = {"sltu",  ID_EXTRACT_MASK_3, SLTU_ID_BITS,  extract_R},
+    [OP_SLTIU] = {"sltiu", ID_EXTRACT_MASK_2, SLTIU_ID_BITS, extract_I},
+    [OP_BEQ]   = {"beq",   ID_EXTRACT_MASK_2, BEQ_ID_BITS,   extract_SB},
+    [OP_BNE]   = {"bne",   ID_EXTRACT_MASK_2, BNE_ID_BITS,   extract_SB},
+    [OP_BLT]   = {"blt",   ID_EXTRACT_MASK_2, BLT_ID_BITS,   extract_SB},
+    [OP_BLTU]  = {"bltu",  ID_EXTRACT_MASK_2, BLTU_ID_BITS,  extract_SB},
+    [OP_BGE]   = {"bge",   ID_EXTRACT_MASK_2, BGE_ID_BITS,   extract_SB},
+    [OP_BGEU]  = {"bgeu",  ID_EXTRACT_MASK_2, BGEU_ID_BITS,  extract_SB},
+    [OP_JAL]   = {"jal",   ID_EXTRACT_MASK_1, JAL_ID_BITS,   extract_UJ},
+    [OP_JALR]  = {"jalr",  ID_EXTRACT_MASK_2, JALR_ID_BITS,  extract_I},
+};
+
+// Names of the register locals - The zero register is read as 0
+static const char* const reg_names[NUM_REGISTERS] = {
+    "0",   "x1",  "x2",  "x3",  "x4",  "x5",  "x6",  "x7",
+    "x8",  "x9",  "x10", "x11", "x12", "x13", "x14", "x15",
+    "x16", "x17", "x18", "x19", "x20", "x21", "x22", "x23",
+    "x24", "x25", "x26", "x27", "x28", "x29", "x30", "x31",
+};
+
+
+// DECODING ...
+
+/* Decodes the instruction at the given address
+
+    RETURNS
+    true  | On success
+    false | If the instruction runs past the end of instruction memory, in
+            which case the interpreter's fetch must handle it
+*/
+static bool decode(const aot_translation_t* const t, const int32_t addr,
+                   aot_instr_t* const d) {
+
+    // Size - Compressed instructions are expanded first
+    d->addr = addr;
+    d->size = (t->rvc && IS_RVC_INSTR(t->image[addr])) ? RVC_SIZE_BYTES
+                                                       : INST_SIZE_BYTES;
+    if (addr > INST_MEM_SIZE - d->size) {
+        return false;
+    }
+    d->half = *(const uint16_t*)&t->image[addr];
+    d->raw = (d->size == RVC_SIZE_BYTES) ? (int32_t)rvc_expand(d->half)
+                                         : *(const int32_t*)&t->image[addr];
+
+    // First matching base instruction, as in exec_instruction()
+    d->op = OP_FALLBACK;
+    for (int op = 0; op < NUM_OPS; op++) {
+        if (INSTR_MATCH(d->raw, ops[op].extract_mask, ops[op].id_bits)) {
+            d->op = op;
+            ops[op].extract(&d->f, d->raw);
+            break;
+        }
+    }
+    return true;
+}
+
+/* Returns whether the decoded instruction ends a basic block */
+static bool ends_block(const aot_instr_t* const d) {
+    return d->op >= OP_BEQ && d->op <= OP_JALR;
+}
+
+/* Returns the static target of a decoded branch or jal, or -1 if it has
+   none within instruction memory
+*/
+static int32_t static_target(const aot_instr_t* const d) {
+    int32_t target = -1;
+    if (d->op >= OP_BEQ && d->op <= OP_BGEU) {
+        target = d->addr + d->f.type_SB.imm;
+    }
+    else if (d->op == OP_JAL) {
+        target = d->addr + d->f.type_UJ.imm;
+    }
+    return (target >= INST_MEM_START && target <= INST_MEM_END) ? target : -1;
+}
+
+/* Marks the given address as a block leader, queueing it if it is new */
+static void add_leader(aot_translation_t* const t, const int32_t addr,
+                       int32_t* const queue, int* const n_queued) {
+    if (addr >= INST_MEM_START && addr <= INST_MEM_END && !t->leader[addr]) {
+        t->leader[addr] = true;
+        queue[(*n_queued)++] = addr;
+    }
+}
+
+/* Finds every block leader of the translation
+
+    * Seeds are the entry point and the instruction after every branch or
+      jump of a linear sweep of instruction memory (so code only reached
+      by jalr is translated too)
+    * Each leader is then followed up to the end of its block, adding the
+      targets and fall through of the branch or jump ending it
+*/
+static void find_leaders(aot_translation_t* const t) {
+
+    static int32_t queue[INST_MEM_SIZE];
+    int n_queued = 0;
+    aot_instr_t d;
+
+    // Seeds
+    add_leader(t, INST_MEM_START, queue, &n_queued);
+    for (int32_t addr = INST_MEM_START; decode(t, addr, &d); addr += d.size) {
+        if (ends_block(&d)) {
+            add_leader(t, addr + d.size, queue, &n_queued);
+        }
+    }
+
+    // Follow each block
+    for (int i = 0; i < n_queued; i++) {
+        for (int32_t addr = queue[i]; decode(t, addr, &d); addr += d.size) {
+            if (ends_block(&d)) {
+                const int32_t target = static_target(&d);
+                if (target >= 0) {
+                    add_leader(t, target, queue, &n_queued);
+                }
+                add_leader(t, addr + d.size, queue, &n_queued);
+                break;
+            }
+        }
+    }
+}
+
+
+// EMITTING ...
+
+/* Marks the registers the given instruction reads or writes as used */
+static uint32_t registers_used(const aot_instr_t* const d) {
+    if (d->op == OP_FALLBACK) {
+        return 0;
+    }
+    const instruction_t* const f = &d->f;
+    if (ops[d->op].extract == extract_R) {
+        return (1u << f->type_R.rd) | (1u << f->type_R.rs1) |
+               (1u << f->type_R.rs2);
+    }
+    if (ops[d->op].extract == extract_I) {
+        return (1u << f->type_I.rd) | (1u << f->type_I.rs1);
+    }
+    if (ops[d->op].extract == extract_S) {
+        return (1u << f->type_S.rs1) | (1u << f->type_S.rs2);
+    }
+    if (ops[d->op].extract == extract_SB) {
+        return (1u << f->type_SB.rs1) | (1u << f->type_SB.rs2);
+    }
+    if (ops[d->op].extract == extract_U) {
+        return 1u << f->type_U.rd;
+    }
+    return 1u << f->type_UJ.rd;
+}
+
+/* Brings budget.block_compressed up to date with the compressed
+   instructions fetched so far (including the current one)
+*/
+static void emit_compressed_count(aot_emitter_t* const e) {
+    if (e->compressed > 0) {
+        fprintf(e->out, "    *host->block_compressed += %d;\n", e->compressed);
+        e->compressed = 0;
+    }
+}
+
+/* Writes the registers changed so far back to the vm, and sets the
+   program counter (and instruction size) to the given instruction, so
+   the vm sees the state the interpreter would have while running it
+*/
+static void emit_sync(aot_emitter_t* const e, const aot_instr_t* const d,
+                      const char* const indent) {
+    for (int r = 1; r < NUM_REGISTERS; r++) {
+        if (e->dirty & (1u << r)) {
+            fprintf(e->out, "%sR[%d] = x%d;\n", indent, r, r);
+        }
+    }
+    fprintf(e->out, "%s*host->pc = 0x%04x;\n", indent, d->addr);
+    if (e->rvc) {
+        fprintf(e->out, "%s*host->instr_size = %d;\n", indent, d->size);
+    }
+}
+
+/* Reloads the register locals after a call that may have changed the
+   registers (e.g. a virtual routine saving its result in R[28])
+*/
+static void emit_reload(aot_emitter_t* const e, const char* const indent) {
+    for (int r = 1; r < NUM_REGISTERS; r++) {
+        if (e->used & (1u << r)) {
+            fprintf(e->out, "%sx%d = R[%d];\n", indent, r, r);
+        }
+    }
+}
+
+/* Writes the given value expression to register local rd - Writes to
+   the zero register are dropped
+*/
+static void emit_write(aot_emitter_t* const e, const int32_t rd,
+                       const char* const fmt, const char* const a,
+                       const char* const b) {
+    if (rd == ZERO_REGISTER_ADDR) {
+        return;
+    }
+    fprintf(e->out, "    x%d = ", rd);
+    fprintf(e->out, fmt, a, b);
+    fprintf(e->out, ";\n");
+    e->dirty |= 1u << rd;
+}
+
+/* Emits a load - In place from instruction or data memory, otherwise
+   through mem_read (which handles virtual routines and errors)
+*/
+static void emit_load(aot_emitter_t* const e, const aot_instr_t* const d,
+                      const int size, const char* const type) {
+    const instruction_t* const f = &d->f;
+    emit_compressed_count(e);
+    fprintf(e->out, "    {\n");
+    fprintf(e->out, "        const int32_t addr = (int32_t)((uint32_t)%s + "
+                    "0x%08xu);\n", reg_names[f->type_I.rs1],
+                    (uint32_t)f->type_I.imm);
+
+    // lw reads straight into R[rd], so bytes a virtual routine doesn't
+    // write keep their old value
+    fprintf(e->out, "        int32_t value = %s;\n",
+            (d->op == OP_LW) ? reg_names[f->type_I.rd] : "0");
+    fprintf(e->out, "        if (host->memory != NULL && (uint32_t)addr <= "
+                    "0x%04x) {\n", DATA_MEM_END + 1 - size);
+    fprintf(e->out, "            memcpy(&value, host->memory + addr, %d);\n",
+            size);
+    fprintf(e->out, "        }\n");
+    fprintf(e->out, "        else {\n");
+    emit_sync(e, d, "            ");
+    fprintf(e->out, "            host->mem_read(&value, addr, %d);\n", size);
+    emit_reload(e, "            ");
+    fprintf(e->out, "        }\n");
+    if (f->type_I.rd != ZERO_REGISTER_ADDR) {
+        fprintf(e->out, "        x%d = (%s)value;\n", f->type_I.rd, type);
+        e->dirty |= 1u << f->type_I.rd;
+    }
+    fprintf(e->out, "    }\n");
+}
+
+/* Emits a store - In place to data memory, otherwise through mem_write
+   (which handles virtual routines and errors)
+*/
+static void emit_store(aot_emitter_t* const e, const aot_instr_t* const d,
+                       const int size) {
+    const instruction_t* const f = &d->f;
+    emit_compressed_count(e);
+    fprintf(e->out, "    {\n");
+    fprintf(e->out, "        const int32_t addr = (int32_t)((uint32_t)%s + "
+                    "0x%08xu);\n", reg_names[f->type_S.rs1],
+                    (uint32_t)f->type_S.imm);
+    fprintf(e->out, "        const int32_t value = %s;\n",
+            reg_names[f->type_S.rs2]);
+    fprintf(e->out, "        if (host->memory != NULL && "
+                    "(uint32_t)(addr - 0x%04x) <= 0x%04x) {\n",
+            DATA_MEM_START, DATA_MEM_SIZE - size);
+    fprintf(e->out, "            memcpy(host->memory + addr, &value, %d);\n",
+            size);
+    fprintf(e->out, "        }\n");
+    fprintf(e->out, "        else {\n");
+    emit_sync(e, d, "            ");
+    fprintf(e->out, "            host->mem_write(&value, addr, %d);\n", size);
+    emit_reload(e, "            ");
+    fprintf(e->out, "        }\n");
+    fprintf(e->out, "    }\n");
+}
+
+/* Emits the end of a block at the branch or jump 'd' - The program
+   counter is set to the given target expression before the budget's
+   basic block is ended, as in the interpreter's handlers
+*/
+static void emit_block_end(aot_emitter_t* const e, const aot_instr_t* const d,
+                           const char* const target) {
+    emit_compressed_count(e);
+    for (int r = 1; r < NUM_REGISTERS; r++) {
+        if (e->dirty & (1u << r)) {
+            fprintf(e->out, "    R[%d] = x%d;\n", r, r);
+        }
+    }
+    fprintf(e->out, "    *host->pc = %s;\n", target);
+    if (e->rvc) {
+        fprintf(e->out, "    *host->instr_size = %d;\n", d->size);
+    }
+    fprintf(e->out, "    host->end_basic_block(0x%04x);\n", d->addr);
+}
+
+/* Emits a jump to the block of the given static successor, or a return
+   to the vm if no block starts there (the vm then checks the program
+   counter)
+*/
+static void emit_chain(aot_emitter_t* const e, const int32_t target,
+                       const char* const indent) {
+    if (target >= INST_MEM_START && target <= INST_MEM_END &&
+        e->t->leader[target]) {
+        fprintf(e->out, "%sgoto at_%04x;\n", indent, target);
+    }
+    else {
+        fprintf(e->out, "%sreturn;\n", indent);
+    }
+}
+
+/* Emits a push of the return address of the call 'd' to the guest return
+   address stack, if a block starts there
+*/
+static void emit_ras_push(aot_emitter_t* const e, const aot_instr_t* const d) {
+    const int32_t ret = d->addr + d->size;
+    if (ret <= INST_MEM_END && e->t->leader[ret]) {
+        fprintf(e->out, "    ras_pc[ras_top & (AOT_RAS_SIZE - 1)] = 0x%04x;\n",
+                ret);
+        fprintf(e->out, "    ras_label[ras_top & (AOT_RAS_SIZE - 1)] = "
+                        "&&at_%04x;\n", ret);
+        fprintf(e->out, "    ras_top++;\n");
+    }
+}
+
+/* Emits a branch, ending the block */
+static void emit_branch(aot_emitter_t* const e, const aot_instr_t* const d,
+                        const char* const cond_fmt) {
+    const instruction_t* const f = &d->f;
+    const int32_t taken = d->addr + f->type_SB.imm;
+    const int32_t not_taken = d->addr + d->size;
+    char target[64];
+    fprintf(e->out, "    const bool taken_%04x = (", d->addr);
+    fprintf(e->out, cond_fmt,
+            reg_names[f->type_SB.rs1], reg_names[f->type_SB.rs2]);
+    fprintf(e->out, ");\n");
+    snprintf(target, sizeof(target), "taken_%04x ? 0x%04x : 0x%04x",
+             d->addr, taken, not_taken);
+    emit_block_end(e, d, target);
+    fprintf(e->out, "    if (taken_%04x) {\n", d->addr);
+    emit_chain(e, taken, "        ");
+    fprintf(e->out, "    }\n");
+    emit_chain(e, not_taken, "    ");
+}
+
+/* Emits the end of a block at a jalr, with its target computed by the
+   given expression
+
+    * A return first tries the top of the return address stack, and a call
+      pushes its return address
+    * Then the site's inline cache - The last target it went to, whose
+      label starts as the exit so the (impossible) target -1 returns
+    * Then the table of block labels, refilling the cache, otherwise
+      control goes back to the vm
+*/
+static void emit_jalr_end(aot_emitter_t* const e, const aot_instr_t* const d,
+                          const char* const target) {
+    const instruction_t* const f = &d->f;
+    fprintf(e->out, "    const int32_t target_%04x = %s;\n", d->addr, target);
+    char pc[32];
+    snprintf(pc, sizeof(pc), "target_%04x", d->addr);
+    emit_block_end(e, d, pc);
+    if (f->type_I.rd == ZERO_REGISTER_ADDR &&
+        IS_LINK_REGISTER(f->type_I.rs1)) {
+        fprintf(e->out, "    if (ras_top != 0 && ras_pc[(ras_top - 1) & "
+                        "(AOT_RAS_SIZE - 1)] == %s) {\n", pc);
+        fprintf(e->out, "        ras_top--;\n");
+        fprintf(e->out, "        goto *ras_label[ras_top & "
+                        "(AOT_RAS_SIZE - 1)];\n");
+        fprintf(e->out, "    }\n");
+    }
+    if (IS_LINK_REGISTER(f->type_I.rd)) {
+        emit_ras_push(e, d);
+    }
+    fprintf(e->out, "    static int32_t ic_pc_%04x = -1;\n", d->addr);
+    fprintf(e->out, "    static void* ic_label_%04x = &&exit;\n", d->addr);
+    fprintf(e->out, "    if (%s == ic_pc_%04x) {\n", pc, d->addr);
+    fprintf(e->out, "        goto *ic_label_%04x;\n", d->addr);
+    fprintf(e->out, "    }\n");
+    fprintf(e->out, "    if ((uint32_t)%s < INST_MEM_SIZE && labels[%s] != "
+                    "NULL) {\n", pc, pc);
+    fprintf(e->out, "        ic_pc_%04x = %s;\n", d->addr, pc);
+    fprintf(e->out, "        ic_label_%04x = labels[%s];\n", d->addr, pc);
+    fprintf(e->out, "        goto *ic_label_%04x;\n", d->addr);
+    fprintf(e->out, "    }\n");
+    fprintf(e->out, "    return;\n");
+}
+
+/* Emits the translation of one instruction
+
+    RETURNS
+    true  | If it ended the block
+*/
+static bool emit_instruction(aot_emitter_t* const e,
+                             const aot_instr_t* const d) {
+
+    // Operands of R and I type instructions
+    const instruction_t* const f = &d->f;
+    const char* rs1 = NULL;
+    const char* rs2 = NULL;
+    const char* i_rs1 = NULL;
+    char imm[32] = "";
+    char uimm[32] = "";
+    if (d->op != OP_FALLBACK && ops[d->op].extract == extract_R) {
+        rs1 = reg_names[f->type_R.rs1];
+        rs2 = reg_names[f->type_R.rs2];
+    }
+    else if (d->op != OP_FALLBACK && ops[d->op].extract == extract_I) {
+        i_rs1 = reg_names[f->type_I.rs1];
+        snprintf(imm, sizeof(imm), "%d", f->type_I.imm);
+        snprintf(uimm, sizeof(uimm), "0x%08xu", (uint32_t)f->type_I.imm);
+    }
+
+    // Which instruction - Compressed ones with the expansion run
+    if (d->size == RVC_SIZE_BYTES) {
+        e->compressed++;
+        fprintf(e->out, "    // 0x%04x | %s (0x%04x -> 0x%08x)\n", d->addr,
+                (d->op == OP_FALLBACK) ? "-" : ops[d->op].name,
+                d->half, (uint32_t)d->raw);
+    }
+    else {
+        fprintf(e->out, "    // 0x%04x | %s (0x%08x)\n", d->addr,
+                (d->op == OP_FALLBACK) ? "-" : ops[d->op].name,
+                (uint32_t)d->raw);
+    }
+
+    switch (d->op) {
+
+        // Arithmetic and logic - Wrapping as on the host
+        case OP_ADD:
+            emit_write(e, f->type_R.rd,
+                       "(int32_t)((uint32_t)%s + (uint32_t)%s)", rs1, rs2);
+            break;
+        case OP_SUB:
+            emit_write(e, f->type_R.rd,
+                       "(int32_t)((uint32_t)%s - (uint32_t)%s)", rs1, rs2);
+            break;
+        case OP_XOR:
+            emit_write(e, f->type_R.rd, "%s ^ %s", rs1, rs2);
+            break;
+        case OP_OR:
+            emit_write(e, f->type_R.rd, "%s | %s", rs1, rs2);
+            break;
+        case OP_AND:
+            emit_write(e, f->type_R.rd, "%s & %s", rs1, rs2);
+            break;
+        case OP_SLL:
+            emit_write(e, f->type_R.rd, "AOT_SLL(%s, %s)", rs1, rs2);
+            break;
+        case OP_SRL:
+            emit_write(e, f->type_R.rd, "AOT_SRL(%s, %s)", rs1, rs2);
+            break;
+        case OP_SRA:
+            emit_write(e, f->type_R.rd, "AOT_SRA(%s, %s)", rs1, rs2);
+            break;
+        case OP_SLT:
+            emit_write(e, f->type_R.rd, "(%s < %s) ? 1 : 0", rs1, rs2);
+            break;
+        case OP_SLTU:
+            emit_write(e, f->type_R.rd,
+                       "((uint32_t)%s < (uint32_t)%s) ? 1 : 0", rs1, rs2);
+            break;
+        case OP_ADDI:
+            emit_write(e, f->type_I.rd, "(int32_t)((uint32_t)%s + %s)",
+                       i_rs1, uimm);
+            break;
+        case OP_XORI:
+            emit_write(e, f->type_I.rd, "%s ^ %s", i_rs1, imm);
+            break;
+        case OP_ORI:
+            emit_write(e, f->type_I.rd, "%s | %s", i_rs1, imm);
+            break;
+        case OP_ANDI:
+            emit_write(e, f->type_I.rd, "%s & %s", i_rs1, imm);
+            break;
+        case OP_SLTI:
+            emit_write(e, f->type_I.rd, "(%s < %s) ? 1 : 0", i_rs1, imm);
+            break;
+        case OP_SLTIU:
+            emit_write(e, f->type_I.rd, "((uint32_t)%s < %s) ? 1 : 0",
+                       i_rs1, uimm);
+            break;
+        case OP_LUI:
+            snprintf(uimm, sizeof(uimm), "0x%08xu", (uint32_t)f->type_U.imm);
+            emit_write(e, f->type_U.rd, "(int32_t)%s", uimm, NULL);
+            break;
+
+        // Loads and stores
+        case OP_LB:  emit_load(e, d, 1, "int8_t");         break;
+        case OP_LH:  emit_load(e, d, 2, "int16_t");        break;
+        case OP_LW:  emit_load(e, d, WORD_SIZE, "int32_t"); break;
+        case OP_LBU: emit_load(e, d, 1, "uint8_t");        break;
+        case OP_LHU: emit_load(e, d, 2, "uint16_t");       break;
+        case OP_SB:  emit_store(e, d, 1);                  break;
+        case OP_SH:  emit_store(e, d, 2);                  break;
+        case OP_SW:  emit_store(e, d, WORD_SIZE);          break;
+
+        // Branches and jumps - End the block
+        case OP_BEQ:  emit_branch(e, d, "%s == %s"); return true;
+        case OP_BNE:  emit_branch(e, d, "%s != %s"); return true;
+        case OP_BLT:  emit_branch(e, d, "%s < %s");  return true;
+        case OP_BGE:  emit_branch(e, d, "%s >= %s"); return true;
+        case OP_BLTU:
+            emit_branch(e, d, "(uint32_t)%s < (uint32_t)%s");
+            return true;
+        case OP_BGEU:
+            emit_branch(e, d, "(uint32_t)%s >= (uint32_t)%s");
+            return true;
+        case OP_JAL: {
+            char target[32];
+            snprintf(target, sizeof(target), "0x%04x",
+                     d->addr + f->type_UJ.imm);
+            snprintf(uimm, sizeof(uimm), "0x%04x", d->addr + d->size);
+            emit_write(e, f->type_UJ.rd, "%s", uimm, NULL);
+            emit_block_end(e, d, target);
+            if (IS_LINK_REGISTER(f->type_UJ.rd)) {
+                emit_ras_push(e, d);
+            }
+            emit_chain(e, d->addr + f->type_UJ.imm, "    ");
+            return true;
+        }
+        case OP_JALR: {
+
+            // rd is written before rs1 is read - With rd the zero register
+            // that leaves the return address in R[0] for the read
+            char ret[32];
+            char target[64];
+            snprintf(ret, sizeof(ret), "0x%04x", d->addr + d->size);
+            emit_write(e, f->type_I.rd, "%s", ret, NULL);
+            const char* base = i_rs1;
+            if (f->type_I.rs1 == ZERO_REGISTER_ADDR &&
+                f->type_I.rd == ZERO_REGISTER_ADDR) {
+                base = ret;
+            }
+            snprintf(target, sizeof(target), "(int32_t)((uint32_t)%s + %s)",
+                     base, uimm);
+            emit_jalr_end(e, d, target);
+            return true;
+        }
+
+        // Everything else - Run by the interpreter's handler, then the
+        // zero register is reset as the run loop does
+        default:
+            emit_compressed_count(e);
+            emit_sync(e, d, "    ");
+            fprintf(e->out, "    host->exec_instruction((int32_t)0x%08xu);\n",
+                    (uint32_t)d->raw);
+            fprintf(e->out, "    R[0] = 0;\n");
+            emit_reload(e, "    ");
+            break;
+    }
+    return false;
+}
+
+/* Emits the block starting at the given leader - A labelled section of
+   its translation's function
+
+    The block runs up to and including the first branch or jump, or up to
+    the next leader (then goes on to its block) or an instruction running
+    past the end of instruction memory (then returns to the vm there)
+*/
+static void emit_block(FILE* const out, const aot_translation_t* const t,
+                       const int32_t leader) {
+
+    aot_emitter_t e = {out, t, t->rvc, 0, 0, 0};
+    aot_instr_t d;
+
+    // Registers used by the block
+    int32_t end = leader;
+    while (decode(t, end, &d)) {
+        e.used |= registers_used(&d);
+        end += d.size;
+        if (ends_block(&d) || t->leader[end]) {
+            break;
+        }
+    }
+    e.used &= ~1u;
+
+    // Head - Register locals
+    fprintf(out, "at_%04x: {\n", leader);
+    for (int r = 1; r < NUM_REGISTERS; r++) {
+        if (e.used & (1u << r)) {
+            fprintf(out, "    int32_t x%d = R[%d];\n", r, r);
+        }
+    }
+
+    // Body
+    int32_t addr = leader;
+    bool ended = false;
+    while (!ended && decode(t, addr, &d)) {
+        ended = emit_instruction(&e, &d);
+        addr += d.size;
+        if (t->leader[addr]) {
+            break;
+        }
+    }
+
+    // Fall through to the next block
+    if (!ended) {
+        emit_compressed_count(&e);
+        for (int r = 1; r < NUM_REGISTERS; r++) {
+            if (e.dirty & (1u << r)) {
+                fprintf(out, "    R[%d] = x%d;\n", r, r);
+            }
+        }
+        if (addr <= INST_MEM_END && t->leader[addr]) {
+            fprintf(out, "    goto at_%04x;\n", addr);
+        }
+        else {
+            fprintf(out, "    *host->pc = 0x%04x;\n", addr);
+            fprintf(out, "    return;\n");
+        }
+    }
+    fprintf(out, "}\n");
+}
+
+/* Emits the function running the blocks of the translation, then an
+   entry point and a table entry for each block
+*/
+static void emit_translation(FILE* const out, aot_translation_t* const t) {
+
+    find_leaders(t);
+
+    fprintf(out, "\n// BLOCKS (%s) ...\n\n",
+            t->rvc ? "--ext-c decoding" : "32 bit decoding");
+
+    // Head - Labels of every block, and the guest return address stack
+    fprintf(out, "__attribute__((noinline))\n");
+    fprintf(out, "static void %s_run(const aot_host_t* const host, "
+                 "const int32_t entry) {\n", t->prefix);
+    fprintf(out, "    int32_t* const R = host->registers;\n");
+    fprintf(out, "    static void* const labels[INST_MEM_SIZE] = {\n");
+    for (int32_t addr = INST_MEM_START; addr <= INST_MEM_END; addr++) {
+        if (t->leader[addr]) {
+            fprintf(out, "        [0x%04x] = &&at_%04x,\n", addr, addr);
+        }
+    }
+    fprintf(out, "    };\n");
+    fprintf(out, "    int32_t ras_pc[AOT_RAS_SIZE];\n");
+    fprintf(out, "    void* ras_label[AOT_RAS_SIZE];\n");
+    fprintf(out, "    uint32_t ras_top = 0;\n");
+    fprintf(out, "    (void)R;\n");
+    fprintf(out, "    (void)ras_pc;\n");
+    fprintf(out, "    (void)ras_label;\n");
+    fprintf(out, "    (void)ras_top;\n");
+    fprintf(out, "    goto *labels[entry];\n\n");
+
+    // Blocks
+    for (int32_t addr = INST_MEM_START; addr <= INST_MEM_END; addr++) {
+        if (t->leader[addr]) {
+            emit_block(out, t, addr);
+        }
+    }
+    fprintf(out, "exit:\n");
+    fprintf(out, "    return;\n");
+    fprintf(out, "}\n\n");
+
+    // Entry points
+    for (int32_t addr = INST_MEM_START; addr <= INST_MEM_END; addr++) {
+        if (t->leader[addr]) {
+            fprintf(out, "static void %s_%04x(const aot_host_t* const host) "
+                         "{\n", t->prefix, addr);
+            fprintf(out, "    %s_run(host, 0x%04x);\n", t->prefix, addr);
+            fprintf(out, "}\n");
+        }
+    }
+
+    fprintf(out, "\nstatic const aot_block_t %s_table[INST_MEM_SIZE] = {\n",
+            t->prefix);
+    for (int32_t addr = INST_MEM_START; addr <= INST_MEM_END; addr++) {
+        if (t->leader[addr]) {
+            fprintf(out, "    [0x%04x] = %s_%04x,\n", addr, t->prefix, addr);
+        }
+    }
+    fprintf(out, "};\n");
+}
+
+
+// MAIN ...
+
+/* Translates the memory image given as the first argument to the C
+   translation unit at the path given as the second
+*/
+int main(int argc, char** argv) {
+
+    if (argc != 3) {
+        printf("USAGE: riskxvii_aot <image.mi> <out.c>\n");
+        return EXIT_FAILURE;
+    }
+
+    // Read the memory image - Only instruction memory is translated
+    static byte image[MEM_IMG_BIN_FILE_SIZE + 1];
+    FILE* const in = fopen(argv[1], "rb");
+    if (in == NULL) {
+        printf("ERR: Couldn't open file \"%s\"\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+    const size_t n_read = fread(image, 1, sizeof(image), in);
+    fclose(in);
+    if (n_read != MEM_IMG_BIN_FILE_SIZE) {
+        printf("ERR: Invalid file input size: [%zu bytes]\n", n_read);
+        return EXIT_FAILURE;
+    }
+
+    FILE* const out = fopen(argv[2], "w");
+    if (out == NULL) {
+        printf("ERR: Couldn't open file \"%s\"\n", argv[2]);
+        return EXIT_FAILURE;
+    }
+
+    // Both decodings
+    static aot_translation_t plain = {NULL, false, "block", {false}};
+    static aot_translation_t rvc = {NULL, true, "rvc_block", {false}};
+    plain.image = image;
+    rvc.image = image;
+
+    fprintf(out, "// Translated from %s by riskxvii_aot (see aot.h)\n\n",
+            argv[1]);
+    fprintf(out, "#include <string.h>\n");
+    fprintf(out, "#include \"aot.h\"\n");
+    emit_translation(out, &plain);
+    emit_translation(out, &rvc);
+    fprintf(out, "\n// IMAGE ...\n\n");
+    fprintf(out, "const aot_image_t %s = {\n", AOT_IMAGE_SYMBOL);
+    fprintf(out, "    AOT_ABI_VERSION, 0x%08xu, block_table, rvc_block_table\n",
+            aot_hash(image));
+    fprintf(out, "};\n");
+
+    if (fclose(out) == EOF) {
+        printf("ERR: Couldn't close file \"%s\"\n", argv[2]);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}